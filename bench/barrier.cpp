@@ -0,0 +1,119 @@
+#include "bench.hpp"
+
+#include <barrier.hpp>
+
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+
+#if __cplusplus >= 202002L && __has_include(<barrier>)
+#include <barrier>
+#endif
+
+// Phase turnaround of fork/join barriers across thread counts.
+//
+//   b_barrier [phases] [max_threads] [variant-substring]
+//
+// Every thread runs `phases` rounds of arrive_and_wait() with no work in
+// between, so the time per phase is the cost of the barrier itself: the
+// last arrival's latency plus waking everyone for the next phase.
+namespace {
+// The textbook barrier every arrival serializes on.
+class mutex_barrier {
+ public:
+  explicit mutex_barrier(std::ptrdiff_t expected)
+      : expected_(expected), remaining_(expected) {}
+
+  void arrive_and_wait() {
+    std::unique_lock<std::mutex> lk(mtx_);
+    const std::uint64_t phase = phase_;
+    if (--remaining_ == 0) {
+      remaining_ = expected_;
+      ++phase_;
+      lk.unlock();
+      cv_.notify_all();
+      return;
+    }
+    cv_.wait(lk, [&] { return phase_ != phase; });
+  }
+
+ private:
+  std::mutex mtx_;
+  std::condition_variable cv_;
+  std::ptrdiff_t expected_;
+  std::ptrdiff_t remaining_;
+  std::uint64_t phase_ = 0;
+};
+
+struct options {
+  unsigned phases = 20000;
+  unsigned max_threads = bench::max_threads();
+  const char* filter = nullptr;
+};
+
+template <class Barrier>
+void run_one(const char* name, unsigned threads, const options& opt) {
+  std::unique_ptr<Barrier> sync(new Barrier(threads));
+  std::vector<std::thread> pool;
+  std::atomic<unsigned> ready{0};
+  std::atomic<bool> go{false};
+  for (unsigned t = 0; t < threads; ++t) {
+    pool.emplace_back([&] {
+      ready.fetch_add(1);
+      while (!go.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+      }
+      for (unsigned i = 0; i < opt.phases; ++i) {
+        sync->arrive_and_wait();
+      }
+    });
+  }
+  while (ready.load() != threads) {
+    std::this_thread::yield();
+  }
+  const auto start = bench::clock::now();
+  go.store(true, std::memory_order_release);
+  for (auto& th : pool) {
+    th.join();
+  }
+  const double ns =
+      std::chrono::duration<double, std::nano>(bench::clock::now() - start)
+          .count();
+  std::printf("%-18s threads=%-3u %10.0f ns/phase %12.0f phases/s\n", name,
+              threads, ns / opt.phases, opt.phases * 1e9 / ns);
+  std::fflush(stdout);
+}
+
+template <class Barrier>
+void run_variant(const char* name, const options& opt) {
+  if (opt.filter && std::strstr(name, opt.filter) == nullptr) {
+    return;
+  }
+  for (unsigned t = 1; t < opt.max_threads; t *= 2) {
+    run_one<Barrier>(name, t, opt);
+  }
+  run_one<Barrier>(name, opt.max_threads, opt);
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  options opt;
+  if (argc > 1) {
+    opt.phases = static_cast<unsigned>(std::atoi(argv[1]));
+  }
+  if (argc > 2) {
+    opt.max_threads = static_cast<unsigned>(std::atoi(argv[2]));
+  }
+  if (argc > 3) {
+    opt.filter = argv[3];
+  }
+
+  run_variant<stdcpp::barrier<>>("stdcpp::barrier", opt);
+  run_variant<mutex_barrier>("mutex+condvar", opt);
+#if __cplusplus >= 202002L && __has_include(<barrier>)
+  run_variant<std::barrier<>>("std::barrier", opt);
+#endif
+  return 0;
+}
@@ -0,0 +1,79 @@
+#ifndef __SCC_STDCPP_BENCH_HPP__
+#define __SCC_STDCPP_BENCH_HPP__
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+// Minimal helpers shared by the benchmarks in bench/. Each benchmark is a
+// standalone executable named b_<file> that prints one line per measurement.
+namespace bench {
+using clock = std::chrono::steady_clock;
+
+inline unsigned max_threads() {
+  const unsigned n = std::thread::hardware_concurrency();
+  return n == 0 ? 4 : n;
+}
+
+// Runs `body(thread_index, stop_flag)` on `threads` threads for roughly
+// `duration`, returning the elapsed wall time in seconds. Threads start
+// together once all of them are spawned.
+template <class Body>
+double run_threads(unsigned threads, std::chrono::milliseconds duration,
+                   Body&& body) {
+  std::atomic<unsigned> ready{0};
+  std::atomic<bool> go{false};
+  std::atomic<bool> stop{false};
+  std::vector<std::thread> pool;
+  pool.reserve(threads);
+  for (unsigned t = 0; t < threads; ++t) {
+    pool.emplace_back([&, t] {
+      ready.fetch_add(1);
+      while (!go.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+      }
+      body(t, stop);
+    });
+  }
+  while (ready.load() != threads) {
+    std::this_thread::yield();
+  }
+  const auto start = clock::now();
+  go.store(true, std::memory_order_release);
+  std::this_thread::sleep_for(duration);
+  stop.store(true, std::memory_order_relaxed);
+  for (auto& th : pool) {
+    th.join();
+  }
+  return std::chrono::duration<double>(clock::now() - start).count();
+}
+
+// Returns the q-quantile (0..1) of `samples`, reordering them in place.
+inline std::uint64_t percentile(std::vector<std::uint64_t>& samples,
+                                double q) {
+  if (samples.empty()) {
+    return 0;
+  }
+  const auto k = static_cast<std::size_t>(q * (samples.size() - 1));
+  std::nth_element(samples.begin(), samples.begin() + k, samples.end());
+  return samples[k];
+}
+
+// Keeps the optimizer from discarding a computed value.
+template <class T>
+inline void do_not_optimize(const T& value) {
+#if defined(__GNUC__)
+  __asm__ __volatile__("" : : "r,m"(value) : "memory");
+#else
+  static volatile const T* sink;
+  sink = &value;
+#endif
+}
+}  // namespace bench
+
+#endif  // __SCC_STDCPP_BENCH_HPP__
@@ -0,0 +1,164 @@
+#include "bench.hpp"
+
+#include <queue.hpp>
+#include <shared_mutex.hpp>
+
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <queue>
+
+// Throughput of bounded queues between producer and consumer threads.
+//
+//   b_queue [duration_ms] [max_threads] [variant-substring]
+//
+// Producers push sequence numbers as fast as the queue accepts them and
+// consumers pop them, one at a time or in batches of 32. Reports items
+// consumed per second for each producer/consumer split.
+namespace {
+constexpr std::size_t kCapacity = 1024;
+constexpr std::size_t kBatch = 32;
+
+// The baseline: std::queue under the exclusive side of stdcpp::shared_mutex.
+class mutex_queue {
+ public:
+  explicit mutex_queue(std::size_t capacity) : capacity_(capacity) {}
+
+  bool try_push(std::uint64_t value) {
+    std::lock_guard<stdcpp::shared_mutex> lk(mtx_);
+    if (items_.size() == capacity_) {
+      return false;
+    }
+    items_.push(value);
+    return true;
+  }
+
+  bool try_pop(std::uint64_t& out) {
+    std::lock_guard<stdcpp::shared_mutex> lk(mtx_);
+    if (items_.empty()) {
+      return false;
+    }
+    out = items_.front();
+    items_.pop();
+    return true;
+  }
+
+  std::size_t try_push_n(const std::uint64_t* first, std::size_t n) {
+    std::lock_guard<stdcpp::shared_mutex> lk(mtx_);
+    std::size_t i = 0;
+    for (; i < n && items_.size() < capacity_; ++i) {
+      items_.push(first[i]);
+    }
+    return i;
+  }
+
+  std::size_t try_pop_n(std::uint64_t* out, std::size_t n) {
+    std::lock_guard<stdcpp::shared_mutex> lk(mtx_);
+    std::size_t i = 0;
+    for (; i < n && !items_.empty(); ++i) {
+      out[i] = items_.front();
+      items_.pop();
+    }
+    return i;
+  }
+
+ private:
+  stdcpp::shared_mutex mtx_;
+  std::queue<std::uint64_t> items_;
+  std::size_t capacity_;
+};
+
+struct options {
+  std::chrono::milliseconds duration{200};
+  unsigned max_threads = bench::max_threads();
+  const char* filter = nullptr;
+};
+
+template <class Queue>
+void run_one(const char* name, unsigned producers, unsigned consumers,
+             bool batched, const options& opt) {
+  std::unique_ptr<Queue> q(new Queue(kCapacity));
+  std::vector<std::uint64_t> consumed(producers + consumers, 0);
+  const double secs = bench::run_threads(
+      producers + consumers, opt.duration,
+      [&](unsigned t, std::atomic<bool>& stop) {
+        std::uint64_t buffer[kBatch];
+        std::uint64_t n = 0;
+        if (t < producers) {
+          while (!stop.load(std::memory_order_relaxed)) {
+            if (batched) {
+              for (std::size_t i = 0; i < kBatch; ++i) {
+                buffer[i] = n + i;
+              }
+              n += q->try_push_n(buffer, kBatch);
+            } else if (q->try_push(n)) {
+              ++n;
+            }
+          }
+          return;
+        }
+        std::uint64_t sum = 0;
+        while (!stop.load(std::memory_order_relaxed)) {
+          if (batched) {
+            const std::size_t got = q->try_pop_n(buffer, kBatch);
+            for (std::size_t i = 0; i < got; ++i) {
+              sum += buffer[i];
+            }
+            n += got;
+          } else if (q->try_pop(buffer[0])) {
+            sum += buffer[0];
+            ++n;
+          }
+        }
+        bench::do_not_optimize(sum);
+        consumed[t] = n;
+      });
+  std::uint64_t total = 0;
+  for (auto c : consumed) {
+    total += c;
+  }
+  std::printf("%-18s %-6s producers=%-3u consumers=%-3u %14.0f items/s\n",
+              name, batched ? "batch" : "single", producers, consumers,
+              static_cast<double>(total) / secs);
+  std::fflush(stdout);
+}
+
+template <class Queue>
+void run_variant(const char* name, bool single_producer,
+                 const options& opt) {
+  if (opt.filter && std::strstr(name, opt.filter) == nullptr) {
+    return;
+  }
+  for (bool batched : {false, true}) {
+    if (single_producer) {
+      run_one<Queue>(name, 1, 1, batched, opt);
+      continue;
+    }
+    for (unsigned each = 1; each * 2 <= opt.max_threads; each *= 2) {
+      run_one<Queue>(name, each, each, batched, opt);
+    }
+  }
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  options opt;
+  if (argc > 1) {
+    opt.duration = std::chrono::milliseconds(std::atoi(argv[1]));
+  }
+  if (argc > 2) {
+    opt.max_threads = static_cast<unsigned>(std::atoi(argv[2]));
+  }
+  if (argc > 3) {
+    opt.filter = argv[3];
+  }
+
+  run_variant<stdcpp::spsc_queue<std::uint64_t>>("stdcpp::spsc_queue", true,
+                                                 opt);
+  run_variant<stdcpp::mpmc_queue<std::uint64_t>>("stdcpp::mpmc_queue", false,
+                                                 opt);
+  run_variant<mutex_queue>("mutex_queue", false, opt);
+  return 0;
+}
@@ -0,0 +1,82 @@
+#include "bench.hpp"
+
+#include <algorithm.hpp>
+#include <numeric.hpp>
+
+#include <numeric>
+#include <random>
+
+// Sums, counts, searches and takes the minimum and maximum of 1M-element
+// vectors, with std:: and with the stdcpp::ranges algorithms that run the
+// SIMD kernels. Times are per pass.
+namespace {
+template <class Body>
+double time_us(Body&& body) {
+  const int passes = 50;
+  const auto start = bench::clock::now();
+  for (int i = 0; i < passes; ++i) {
+    body();
+  }
+  return std::chrono::duration<double, std::micro>(bench::clock::now() -
+                                                   start)
+             .count() /
+         passes;
+}
+
+template <class T>
+void run(const char* type) {
+  std::mt19937 rng(1);
+  std::vector<T> v(1 << 20);
+  for (auto& x : v) {
+    x = static_cast<T>(rng() % 100);
+  }
+  const T missing = static_cast<T>(101);
+  auto row = [type](const char* name, double us) {
+    std::printf("%-7s %-30s %10.1f us\n", type, name, us);
+  };
+  row("std::accumulate", time_us([&] {
+        bench::do_not_optimize(std::accumulate(v.begin(), v.end(), T{}));
+      }));
+  row("ranges::reduce", time_us([&] {
+        bench::do_not_optimize(stdcpp::ranges::reduce(v));
+      }));
+  row("ranges::reduce(unseq)", time_us([&] {
+        bench::do_not_optimize(
+            stdcpp::ranges::reduce(stdcpp::execution::unseq, v));
+      }));
+  row("std::inner_product", time_us([&] {
+        bench::do_not_optimize(
+            std::inner_product(v.begin(), v.end(), v.begin(), T{}));
+      }));
+  row("ranges::dot(unseq)", time_us([&] {
+        bench::do_not_optimize(
+            stdcpp::ranges::dot(stdcpp::execution::unseq, v, v));
+      }));
+  row("std::count", time_us([&] {
+        bench::do_not_optimize(std::count(v.begin(), v.end(), T{7}));
+      }));
+  row("ranges::count", time_us([&] {
+        bench::do_not_optimize(stdcpp::ranges::count(v, T{7}));
+      }));
+  row("std::find (absent)", time_us([&] {
+        bench::do_not_optimize(std::find(v.begin(), v.end(), missing));
+      }));
+  row("ranges::find (absent)", time_us([&] {
+        bench::do_not_optimize(stdcpp::ranges::find(v, missing));
+      }));
+  row("std::minmax_element", time_us([&] {
+        bench::do_not_optimize(std::minmax_element(v.begin(), v.end()));
+      }));
+  row("ranges::minmax", time_us([&] {
+        bench::do_not_optimize(stdcpp::ranges::minmax(v).min);
+      }));
+}
+}  // namespace
+
+int main() {
+  run<std::int32_t>("int32");
+  run<std::int8_t>("int8");
+  run<float>("float");
+  run<double>("double");
+  return 0;
+}
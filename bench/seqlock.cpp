@@ -0,0 +1,72 @@
+#include "bench.hpp"
+
+#include <seqlock.hpp>
+#include <shared_mutex.hpp>
+
+#include <mutex>
+#include <shared_mutex>
+
+// Readers hammer a small value while one writer updates it every ~100us.
+// Compares stdcpp::seqlock<T> against the same value behind
+// stdcpp::shared_mutex.
+namespace {
+struct offset {
+  std::int64_t seconds;
+  std::int64_t nanos;
+  std::int32_t leap;
+};
+
+class locked_offset {
+ public:
+  offset load() {
+    std::shared_lock<stdcpp::shared_mutex> lk(mtx_);
+    return value_;
+  }
+  void store(const offset& v) {
+    std::lock_guard<stdcpp::shared_mutex> lk(mtx_);
+    value_ = v;
+  }
+
+ private:
+  stdcpp::shared_mutex mtx_;
+  offset value_{};
+};
+
+template <class Cell>
+void run(const char* name, unsigned readers) {
+  Cell cell;
+  std::vector<std::uint64_t> reads(readers + 1, 0);
+  const double secs = bench::run_threads(
+      readers + 1, std::chrono::milliseconds(200),
+      [&](unsigned t, std::atomic<bool>& stop) {
+        std::uint64_t n = 0;
+        if (t == readers) {
+          while (!stop.load(std::memory_order_relaxed)) {
+            cell.store(offset{static_cast<std::int64_t>(n), 0, 0});
+            ++n;
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+          }
+          return;
+        }
+        while (!stop.load(std::memory_order_relaxed)) {
+          bench::do_not_optimize(cell.load());
+          ++n;
+        }
+        reads[t] = n;
+      });
+  std::uint64_t total = 0;
+  for (unsigned t = 0; t < readers; ++t) {
+    total += reads[t];
+  }
+  std::printf("%-14s readers=%-3u %12.0f reads/s\n", name, readers,
+              static_cast<double>(total) / secs);
+}
+}  // namespace
+
+int main() {
+  for (unsigned readers = 1; readers <= bench::max_threads(); readers *= 2) {
+    run<stdcpp::seqlock<offset>>("seqlock", readers);
+    run<locked_offset>("shared_mutex", readers);
+  }
+  return 0;
+}
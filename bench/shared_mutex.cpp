@@ -0,0 +1,208 @@
+// Instrumentation is compiled in here so its overhead shows up in the table.
+#define STDCPP_ENABLE_LOCK_STATS
+#include "bench.hpp"
+
+#include <lock_stats.hpp>
+#include <shared_mutex.hpp>
+#include <stamped_mutex.hpp>
+
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+
+#if !defined(_WIN32)
+#include <pthread.h>
+#endif
+
+// Throughput and latency of reader/writer locks across thread counts and
+// read/write mixes.
+//
+//   b_shared_mutex [duration_ms] [max_threads] [variant-substring]
+//
+// Each operation takes the lock (shared or exclusive according to the mix),
+// touches a few cache lines of shared payload and releases it. Every 16th
+// operation is timed for the p50/p99 latency columns.
+namespace {
+#if !defined(_WIN32)
+class pthread_rwlock {
+ public:
+  pthread_rwlock() { pthread_rwlock_init(&lock_, nullptr); }
+  ~pthread_rwlock() { pthread_rwlock_destroy(&lock_); }
+  void lock() { pthread_rwlock_wrlock(&lock_); }
+  void unlock() { pthread_rwlock_unlock(&lock_); }
+  void lock_shared() { pthread_rwlock_rdlock(&lock_); }
+  void unlock_shared() { pthread_rwlock_unlock(&lock_); }
+
+ private:
+  pthread_rwlock_t lock_;
+};
+#endif
+
+// Relaxed atomics so that optimistic readers may race with writers; on the
+// usual targets they compile to plain loads and stores.
+struct payload {
+  std::atomic<std::uint64_t> values[32] = {};
+};
+
+// stamped_mutex read optimistically, falling back to lock_shared() when a
+// writer gets in the way.
+class optimistic_stamped_mutex : public stdcpp::stamped_mutex {};
+
+template <class Mutex>
+std::uint64_t read_payload(Mutex& mtx, const payload& data) {
+  std::uint64_t sum = 0;
+  mtx.lock_shared();
+  for (const auto& v : data.values) {
+    sum += v.load(std::memory_order_relaxed);
+  }
+  mtx.unlock_shared();
+  return sum;
+}
+
+std::uint64_t read_payload(optimistic_stamped_mutex& mtx,
+                           const payload& data) {
+  const auto stamp = mtx.try_optimistic_read();
+  if (stamp != 0) {
+    std::uint64_t sum = 0;
+    for (const auto& v : data.values) {
+      sum += v.load(std::memory_order_relaxed);
+    }
+    if (mtx.validate(stamp)) {
+      return sum;
+    }
+  }
+  return read_payload<stdcpp::stamped_mutex>(mtx, data);
+}
+
+struct options {
+  std::chrono::milliseconds duration{200};
+  unsigned max_threads = bench::max_threads();
+  const char* filter = nullptr;
+};
+
+struct xorshift {
+  std::uint64_t state;
+  std::uint64_t next() {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+  }
+};
+
+// The payload gets its own cache line so writers do not also invalidate the
+// lock word for spinning readers.
+template <class Mutex>
+struct shared_state {
+  Mutex mtx;
+  alignas(64) payload data;
+};
+
+template <class Mutex>
+void run_one(const char* name, unsigned threads, unsigned read_percent,
+             const options& opt) {
+  std::unique_ptr<shared_state<Mutex>> state(new shared_state<Mutex>);
+  auto& mtx = state->mtx;
+  auto& data = state->data;
+  std::vector<std::uint64_t> ops(threads, 0);
+  std::vector<std::vector<std::uint64_t>> latencies(threads);
+
+  const double secs = bench::run_threads(
+      threads, opt.duration, [&](unsigned t, std::atomic<bool>& stop) {
+        xorshift rng{0x9e3779b97f4a7c15ull * (t + 1)};
+        auto& samples = latencies[t];
+        samples.reserve(1 << 16);
+        std::uint64_t n = 0;
+        std::uint64_t sink = 0;
+        while (!stop.load(std::memory_order_relaxed)) {
+          const bool timed = (n & 15) == 0;
+          const auto start =
+              timed ? bench::clock::now() : bench::clock::time_point();
+          if (rng.next() % 100 < read_percent) {
+            // Sum into a local: `sink` escapes, so it may live in memory.
+            sink += read_payload(mtx, data);
+          } else {
+            mtx.lock();
+            for (auto& v : data.values) {
+              v.store(v.load(std::memory_order_relaxed) + 1,
+                      std::memory_order_relaxed);
+            }
+            mtx.unlock();
+          }
+          if (timed && samples.size() < samples.capacity()) {
+            samples.push_back(static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    bench::clock::now() - start)
+                    .count()));
+          }
+          ++n;
+        }
+        bench::do_not_optimize(sink);
+        ops[t] = n;
+      });
+
+  std::uint64_t total = 0;
+  std::vector<std::uint64_t> all;
+  for (unsigned t = 0; t < threads; ++t) {
+    total += ops[t];
+    all.insert(all.end(), latencies[t].begin(), latencies[t].end());
+  }
+  const auto p50 = bench::percentile(all, 0.50);
+  const auto p99 = bench::percentile(all, 0.99);
+  std::printf("%-22s threads=%-3u read=%3u%% %12.0f ops/s  p50=%6llu ns  "
+              "p99=%8llu ns\n",
+              name, threads, read_percent, static_cast<double>(total) / secs,
+              static_cast<unsigned long long>(p50),
+              static_cast<unsigned long long>(p99));
+  std::fflush(stdout);
+}
+
+template <class Mutex>
+void run_variant(const char* name, const options& opt) {
+  if (opt.filter && std::strstr(name, opt.filter) == nullptr) {
+    return;
+  }
+  static const unsigned read_percents[] = {100, 95, 90, 75, 50};
+  std::vector<unsigned> counts;
+  for (unsigned t = 1; t < opt.max_threads; t *= 2) {
+    counts.push_back(t);
+  }
+  counts.push_back(opt.max_threads);
+  for (auto read_percent : read_percents) {
+    for (auto threads : counts) {
+      run_one<Mutex>(name, threads, read_percent, opt);
+    }
+  }
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  options opt;
+  if (argc > 1) {
+    opt.duration = std::chrono::milliseconds(std::atoi(argv[1]));
+  }
+  if (argc > 2) {
+    opt.max_threads = static_cast<unsigned>(std::atoi(argv[2]));
+  }
+  if (argc > 3) {
+    opt.filter = argv[3];
+  }
+
+  run_variant<stdcpp::shared_mutex>("stdcpp::shared_mutex", opt);
+  run_variant<stdcpp::basic_shared_mutex<stdcpp::no_spin>>(
+      "stdcpp::no_spin", opt);
+  run_variant<stdcpp::stamped_mutex>("stdcpp::stamped_mutex", opt);
+  run_variant<optimistic_stamped_mutex>("stdcpp::stamped_optimistic", opt);
+  run_variant<stdcpp::instrumented_shared_mutex>("stdcpp::instrumented",
+                                                 opt);
+  run_variant<std::shared_timed_mutex>("std::shared_timed_mutex", opt);
+#if __cplusplus >= 201703L
+  run_variant<std::shared_mutex>("std::shared_mutex", opt);
+#endif
+#if !defined(_WIN32)
+  run_variant<pthread_rwlock>("pthread_rwlock_t", opt);
+#endif
+  return 0;
+}
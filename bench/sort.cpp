@@ -0,0 +1,67 @@
+#include "bench.hpp"
+
+#include <algorithm.hpp>
+#include <numeric.hpp>
+
+#include <numeric>
+#include <random>
+
+// Sorts and sums a shuffled vector of 64-bit integers, with std::, with
+// ranges::radix_sort, and with stdcpp::execution::par on pools of 1, 2,
+// 4, ... workers.
+namespace {
+template <class Body>
+double time_ms(Body&& body) {
+  const auto start = bench::clock::now();
+  body();
+  return std::chrono::duration<double, std::milli>(bench::clock::now() -
+                                                   start)
+      .count();
+}
+
+void run(std::size_t n) {
+  std::mt19937_64 rng(n);
+  std::vector<std::uint64_t> input(n);
+  for (auto& x : input) {
+    x = rng();
+  }
+
+  std::vector<std::uint64_t> v = input;
+  std::printf("n=%-9zu %-22s %10.2f ms\n", n, "std::sort",
+              time_ms([&] { std::sort(v.begin(), v.end()); }));
+  v = input;
+  std::printf("n=%-9zu %-22s %10.2f ms\n", n, "ranges::radix_sort",
+              time_ms([&] { stdcpp::ranges::radix_sort(v); }));
+  std::uint64_t sum = 0;
+  std::printf("n=%-9zu %-22s %10.2f ms\n", n, "std::accumulate",
+              time_ms([&] {
+                sum = std::accumulate(input.begin(), input.end(),
+                                      std::uint64_t{0});
+              }));
+  bench::do_not_optimize(sum);
+
+  for (unsigned workers = 1; workers <= bench::max_threads(); workers *= 2) {
+    stdcpp::thread_pool pool(workers);
+    const auto par = stdcpp::execution::par.on(pool);
+    v = input;
+    std::printf("n=%-9zu sort(par) workers=%-4u %10.2f ms\n", n, workers,
+                time_ms([&] { stdcpp::sort(par, v.begin(), v.end()); }));
+    v = input;
+    std::printf("n=%-9zu radix(par) workers=%-3u %10.2f ms\n", n, workers,
+                time_ms([&] { stdcpp::ranges::radix_sort(par, v); }));
+    std::printf("n=%-9zu reduce(par) workers=%-2u %10.2f ms\n", n, workers,
+                time_ms([&] {
+                  sum = stdcpp::reduce(par, input.begin(), input.end(),
+                                       std::uint64_t{0});
+                }));
+    bench::do_not_optimize(sum);
+  }
+}
+}  // namespace
+
+int main() {
+  for (std::size_t n : {100000u, 10000000u}) {
+    run(n);
+  }
+  return 0;
+}
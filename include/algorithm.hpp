@@ -0,0 +1,1397 @@
+#ifndef __SCC_STDCPP_ALGORITHM_HPP__
+#define __SCC_STDCPP_ALGORITHM_HPP__
+#pragma once
+
+#include <detail/simd.hpp>
+#include <execution.hpp>
+#include <ranges.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace stdcpp {
+namespace v1 {
+// The default projection of the ranges algorithms, as C++20's std::identity.
+struct identity {
+  using is_transparent = void;
+
+  template <class T>
+  constexpr T&& operator()(T&& t) const noexcept {
+    return std::forward<T>(t);
+  }
+};
+
+namespace ranges {
+// Algorithms over ranges and iterator-sentinel pairs, returning where the
+// input stopped along with what the algorithm produced, as in C++20.
+template <class I, class F>
+struct in_fun_result {
+  I in;
+  F fun;
+};
+
+template <class I, class O>
+struct in_out_result {
+  I in;
+  O out;
+};
+
+namespace detail {
+// Accepts any segment, to detect for_each_segment().
+struct segment_probe {
+  template <class R>
+  void operator()(R&) const noexcept {}
+};
+
+// Ranges made of segments, such as views::join, that hand each of them to
+// for_each_segment(f) in order. The algorithms below then run one tight
+// loop per segment, over pointers when it is contiguous, instead of
+// stepping through the segments element by element. Only common ranges
+// qualify, so that the algorithms can return end().
+template <class R, class = void>
+struct is_segmented_range : std::false_type {};
+
+template <class R>
+struct is_segmented_range<
+    R, void_t<decltype(std::declval<R&>().for_each_segment(segment_probe{}))>>
+    : is_common_range<R> {};
+
+// Contiguous sized ranges are walked through pointers.
+template <class R>
+using is_pointer_range =
+    std::integral_constant<bool, is_contiguous_range<R>::value &&
+                                     is_sized_range<R>::value>;
+
+template <class R>
+auto pointer_begin(R& r) {
+  return ranges::data(r);
+}
+
+template <class R>
+auto pointer_end(R& r) {
+  return ranges::data(r) + static_cast<std::ptrdiff_t>(ranges::size(r));
+}
+
+// The element type behind ranges::data(), less const, or void.
+template <class R, class = void>
+struct pointer_element {
+  using type = void;
+};
+
+template <class R>
+struct pointer_element<R, std::enable_if_t<is_pointer_range<R>::value>> {
+  using type = std::remove_const_t<
+      std::remove_pointer_t<decltype(ranges::data(std::declval<R&>()))>>;
+};
+
+template <class R>
+using pointer_element_t = typename pointer_element<R>::type;
+}  // namespace detail
+
+// for_each
+template <class I, class S, class F,
+          std::enable_if_t<!v1::detail::is_policy<I>::value, int> = 0>
+in_fun_result<I, F> for_each(I first, S last, F f) {
+  for (; first != last; ++first) {
+    f(*first);
+  }
+  return {std::move(first), std::move(f)};
+}
+
+template <class R, class F,
+          std::enable_if_t<detail::is_range<std::remove_reference_t<R>>::value,
+                           int> = 0>
+in_fun_result<iterator_t<R>, F> for_each(R&& r, F f);
+
+namespace detail {
+template <class R, class F, class Pointers>
+in_fun_result<iterator_t<R>, F> for_each_range(R& r, F f,
+                                               std::true_type /* segmented */,
+                                               Pointers) {
+  r.for_each_segment([&f](auto& segment) {
+    ranges::for_each(segment, [&f](auto&& x) {
+      f(std::forward<decltype(x)>(x));
+    });
+  });
+  return {ranges::end(r), std::move(f)};
+}
+
+template <class R, class F>
+in_fun_result<iterator_t<R>, F> for_each_range(R& r, F f, std::false_type,
+                                               std::true_type /* pointers */) {
+  auto result = ranges::for_each(pointer_begin(r), pointer_end(r),
+                                 std::move(f));
+  return {ranges::begin(r) + (result.in - pointer_begin(r)),
+          std::move(result.fun)};
+}
+
+template <class R, class F>
+in_fun_result<iterator_t<R>, F> for_each_range(R& r, F f, std::false_type,
+                                               std::false_type) {
+  return ranges::for_each(ranges::begin(r), ranges::end(r), std::move(f));
+}
+}  // namespace detail
+
+template <class R, class F,
+          std::enable_if_t<detail::is_range<std::remove_reference_t<R>>::value,
+                           int>>
+in_fun_result<iterator_t<R>, F> for_each(R&& r, F f) {
+  return detail::for_each_range(r, std::move(f),
+                                detail::is_segmented_range<R>{},
+                                detail::is_pointer_range<R>{});
+}
+
+// copy
+//
+// From an array to a pointer to the same trivially copyable type, copy is
+// one memmove.
+namespace detail {
+template <class I>
+using pointee_t = std::remove_const_t<std::remove_pointer_t<I>>;
+
+template <class I, class S, class O>
+using is_memmove_copy = std::integral_constant<
+    bool, std::is_pointer<I>::value && std::is_same<I, S>::value &&
+              std::is_pointer<O>::value &&
+              std::is_same<pointee_t<I>, std::remove_pointer_t<O>>::value &&
+              std::is_trivially_copyable<pointee_t<I>>::value &&
+              std::is_trivially_copy_assignable<pointee_t<I>>::value &&
+              !std::is_volatile<pointee_t<I>>::value>;
+
+template <class I, class S, class O>
+in_out_result<I, O> copy(I first, S last, O out, std::false_type) {
+  for (; first != last; ++first, ++out) {
+    *out = *first;
+  }
+  return {std::move(first), std::move(out)};
+}
+
+template <class I, class S, class O>
+in_out_result<I, O> copy(I first, S last, O out,
+                         std::true_type /* memmove */) {
+  const std::ptrdiff_t n = last - first;
+  if (n > 0) {
+    std::memmove(out, first, static_cast<std::size_t>(n) * sizeof(*first));
+  }
+  return {last, out + n};
+}
+}  // namespace detail
+
+template <class I, class S, class O,
+          std::enable_if_t<!v1::detail::is_policy<I>::value, int> = 0>
+in_out_result<I, O> copy(I first, S last, O out) {
+  return detail::copy(std::move(first), std::move(last), std::move(out),
+                      detail::is_memmove_copy<I, S, O>{});
+}
+
+template <class R, class O,
+          std::enable_if_t<detail::is_range<std::remove_reference_t<R>>::value,
+                           int> = 0>
+in_out_result<iterator_t<R>, O> copy(R&& r, O out);
+
+namespace detail {
+template <class R, class O, class Pointers>
+in_out_result<iterator_t<R>, O> copy_range(R& r, O out,
+                                           std::true_type /* segmented */,
+                                           Pointers) {
+  r.for_each_segment([&out](auto& segment) {
+    out = ranges::copy(segment, std::move(out)).out;
+  });
+  return {ranges::end(r), std::move(out)};
+}
+
+template <class R, class O>
+in_out_result<iterator_t<R>, O> copy_range(R& r, O out, std::false_type,
+                                           std::true_type /* pointers */) {
+  auto result = ranges::copy(pointer_begin(r), pointer_end(r), std::move(out));
+  return {ranges::begin(r) + (result.in - pointer_begin(r)),
+          std::move(result.out)};
+}
+
+template <class R, class O>
+in_out_result<iterator_t<R>, O> copy_range(R& r, O out, std::false_type,
+                                           std::false_type) {
+  return ranges::copy(ranges::begin(r), ranges::end(r), std::move(out));
+}
+}  // namespace detail
+
+template <class R, class O,
+          std::enable_if_t<detail::is_range<std::remove_reference_t<R>>::value,
+                           int>>
+in_out_result<iterator_t<R>, O> copy(R&& r, O out) {
+  return detail::copy_range(r, std::move(out), detail::is_segmented_range<R>{},
+                            detail::is_pointer_range<R>{});
+}
+
+// count, find
+//
+// Over arrays of integers, float or double these run the SIMD kernels in
+// detail/simd.hpp, or memchr for bytes, and so do ranges that are
+// contiguous and sized.
+namespace detail {
+template <class I, class S, class T>
+using is_simd_search = std::integral_constant<
+    bool, std::is_pointer<I>::value && std::is_same<I, S>::value &&
+              v1::detail::is_simd_needle<
+                  std::remove_const_t<std::remove_pointer_t<I>>, T>::value>;
+
+template <class I, class S, class T>
+iter_difference_t<I> count(I first, S last, const T& value,
+                           std::false_type) {
+  iter_difference_t<I> n = 0;
+  for (; first != last; ++first) {
+    if (*first == value) {
+      ++n;
+    }
+  }
+  return n;
+}
+
+template <class I, class S, class T>
+iter_difference_t<I> count(I first, S last, const T& value,
+                           std::true_type /* simd */) {
+  using E = std::remove_const_t<std::remove_pointer_t<I>>;
+  using L = v1::detail::simd_lane_t<E>;
+  if (!v1::detail::simd_needle_fits<E>(value)) {
+    return detail::count(first, last, value, std::false_type{});
+  }
+  return static_cast<iter_difference_t<I>>(v1::detail::simd_count<L>(
+      first, static_cast<std::size_t>(last - first), static_cast<L>(value)));
+}
+
+template <class I, class S, class T>
+I find(I first, S last, const T& value, std::false_type) {
+  for (; first != last; ++first) {
+    if (*first == value) {
+      break;
+    }
+  }
+  return first;
+}
+
+// Bytes are searched with memchr, which every libc vectorizes by hand.
+template <class E, class L>
+const E* find_pointer(const E* p, std::size_t n, L value,
+                      std::true_type /* bytes */) {
+  const void* hit =
+      n == 0 ? nullptr
+             : std::memchr(p, static_cast<unsigned char>(value), n);
+  return hit ? static_cast<const E*>(hit) : p + n;
+}
+
+template <class E, class L>
+const E* find_pointer(const E* p, std::size_t n, L value, std::false_type) {
+  return v1::detail::simd_find<L>(p, n, value);
+}
+
+template <class I, class S, class T>
+I find(I first, S last, const T& value, std::true_type /* simd */) {
+  using E = std::remove_const_t<std::remove_pointer_t<I>>;
+  using L = v1::detail::simd_lane_t<E>;
+  if (!v1::detail::simd_needle_fits<E>(value)) {
+    return detail::find(first, last, value, std::false_type{});
+  }
+  return first + (find_pointer(first, static_cast<std::size_t>(last - first),
+                               static_cast<L>(value),
+                               std::integral_constant<bool, sizeof(E) == 1>{}) -
+                  first);
+}
+}  // namespace detail
+
+template <class I, class S, class T>
+iter_difference_t<I> count(I first, S last, const T& value) {
+  return detail::count(std::move(first), std::move(last), value,
+                       detail::is_simd_search<I, S, T>{});
+}
+
+template <class R, class T,
+          std::enable_if_t<detail::is_range<std::remove_reference_t<R>>::value,
+                           int> = 0>
+range_difference_t<R> count(R&& r, const T& value);
+
+namespace detail {
+template <class R, class T, class Pointers>
+range_difference_t<R> count_range(R& r, const T& value,
+                                  std::true_type /* segmented */, Pointers) {
+  range_difference_t<R> n = 0;
+  r.for_each_segment([&](auto& segment) {
+    n += static_cast<range_difference_t<R>>(ranges::count(segment, value));
+  });
+  return n;
+}
+
+template <class R, class T>
+range_difference_t<R> count_range(R& r, const T& value, std::false_type,
+                                  std::true_type /* pointers */) {
+  return ranges::count(pointer_begin(r), pointer_end(r), value);
+}
+
+template <class R, class T>
+range_difference_t<R> count_range(R& r, const T& value, std::false_type,
+                                  std::false_type) {
+  return ranges::count(ranges::begin(r), ranges::end(r), value);
+}
+}  // namespace detail
+
+template <class R, class T,
+          std::enable_if_t<detail::is_range<std::remove_reference_t<R>>::value,
+                           int>>
+range_difference_t<R> count(R&& r, const T& value) {
+  return detail::count_range(r, value, detail::is_segmented_range<R>{},
+                             detail::is_pointer_range<R>{});
+}
+
+template <class I, class S, class T>
+I find(I first, S last, const T& value) {
+  return detail::find(std::move(first), std::move(last), value,
+                      detail::is_simd_search<I, S, T>{});
+}
+
+namespace detail {
+template <class R, class T>
+iterator_t<R> find_range(R& r, const T& value, std::true_type /* pointers */) {
+  return ranges::begin(r) +
+         (ranges::find(pointer_begin(r), pointer_end(r), value) -
+          pointer_begin(r));
+}
+
+template <class R, class T>
+iterator_t<R> find_range(R& r, const T& value, std::false_type) {
+  return ranges::find(ranges::begin(r), ranges::end(r), value);
+}
+}  // namespace detail
+
+template <class R, class T,
+          std::enable_if_t<detail::is_range<std::remove_reference_t<R>>::value,
+                           int> = 0>
+iterator_t<R> find(R&& r, const T& value) {
+  return detail::find_range(r, value, detail::is_pointer_range<R>{});
+}
+
+// minmax
+//
+// The least and the greatest element of a non-empty range: the first of
+// the least and the last of the greatest, as in C++20. Contiguous ranges
+// of integers, float or double compared with std::less go through the SIMD
+// kernel, which may return either of two equal floating-point values such
+// as -0.0 and 0.0.
+template <class T>
+struct min_max_result {
+  T min;
+  T max;
+};
+
+template <class T>
+using minmax_result = min_max_result<T>;
+
+namespace detail {
+template <class R, class Compare>
+using is_simd_minmax = std::integral_constant<
+    bool, v1::detail::is_simd_type<pointer_element_t<R>>::value &&
+              (std::is_same<Compare, std::less<>>::value ||
+               std::is_same<Compare,
+                            std::less<pointer_element_t<R>>>::value)>;
+
+template <class R, class Compare>
+min_max_result<range_value_t<R>> minmax_range(R& r, Compare&,
+                                              std::true_type /* simd */) {
+  using T = pointer_element_t<R>;
+  using L = v1::detail::simd_lane_t<T>;
+  L lo;
+  L hi;
+  v1::detail::simd_minmax<L>(ranges::data(r),
+                             static_cast<std::size_t>(ranges::size(r)), lo,
+                             hi);
+  return {static_cast<T>(lo), static_cast<T>(hi)};
+}
+
+template <class R, class Compare>
+min_max_result<range_value_t<R>> minmax_range(R& r, Compare& comp,
+                                              std::false_type) {
+  auto first = ranges::begin(r);
+  const auto last = ranges::end(r);
+  min_max_result<range_value_t<R>> result{*first, *first};
+  for (++first; first != last; ++first) {
+    auto&& x = *first;
+    if (comp(x, result.min)) {
+      result.min = x;
+    } else if (!comp(x, result.max)) {
+      result.max = x;
+    }
+  }
+  return result;
+}
+}  // namespace detail
+
+template <class R, class Compare = std::less<>,
+          std::enable_if_t<detail::is_range<std::remove_reference_t<R>>::value,
+                           int> = 0>
+min_max_result<range_value_t<R>> minmax(R&& r, Compare comp = {}) {
+  return detail::minmax_range(r, comp, detail::is_simd_minmax<R, Compare>{});
+}
+
+// mismatch, equal, lexicographical_compare
+//
+// Arrays of the same integer, enum or pointer type, compared with the
+// default predicates, are compared with memcmp; so are ranges that are
+// contiguous and sized. lexicographical_compare orders by memcmp only for
+// unsigned bytes, and otherwise uses it to skip the equal prefix.
+template <class I1, class I2>
+struct in_in_result {
+  I1 in1;
+  I2 in2;
+};
+
+template <class I1, class I2>
+using mismatch_result = in_in_result<I1, I2>;
+
+namespace detail {
+// Types whose values are equal exactly when their bytes are.
+template <class T>
+using is_bytewise_equal = std::integral_constant<
+    bool, (std::is_integral<T>::value || std::is_enum<T>::value ||
+           std::is_pointer<T>::value) &&
+              !std::is_volatile<T>::value>;
+
+// Types ordered as memcmp orders their bytes.
+template <class T, class = void>
+struct is_unsigned_byte
+    : std::integral_constant<bool, std::is_integral<T>::value &&
+                                       std::is_unsigned<T>::value &&
+                                       sizeof(T) == 1 &&
+                                       !std::is_volatile<T>::value> {};
+
+template <class T>
+struct is_unsigned_byte<T, std::enable_if_t<std::is_enum<T>::value>>
+    : std::integral_constant<
+          bool, std::is_unsigned<std::underlying_type_t<T>>::value &&
+                    sizeof(T) == 1 && !std::is_volatile<T>::value> {};
+
+template <class I1, class S1, class I2, class S2>
+using is_pointer_pair = std::integral_constant<
+    bool, std::is_pointer<I1>::value && std::is_same<I1, S1>::value &&
+              std::is_pointer<I2>::value && std::is_same<I2, S2>::value &&
+              std::is_same<pointee_t<I1>, pointee_t<I2>>::value>;
+
+template <class I1, class S1, class I2, class S2, class Pred>
+using is_memcmp_equal = std::integral_constant<
+    bool, is_pointer_pair<I1, S1, I2, S2>::value &&
+              is_bytewise_equal<pointee_t<I1>>::value &&
+              (std::is_same<Pred, std::equal_to<>>::value ||
+               std::is_same<Pred, std::equal_to<pointee_t<I1>>>::value)>;
+
+// How lexicographical_compare goes: by memcmp alone, by memcmp up to the
+// first difference, or element by element.
+template <class I1, class S1, class I2, class S2, class Compare>
+using lexicographical_kind = std::integral_constant<
+    int, !is_pointer_pair<I1, S1, I2, S2>::value ||
+                 !(std::is_same<Compare, std::less<>>::value ||
+                   std::is_same<Compare, std::less<pointee_t<I1>>>::value)
+             ? 0
+         : is_unsigned_byte<pointee_t<I1>>::value  ? 2
+         : is_bytewise_equal<pointee_t<I1>>::value ? 1
+                                                   : 0>;
+
+// The first index in [0, n) where p and q differ, or n, going a few
+// hundred bytes at a time with memcmp until a block differs.
+template <class T>
+std::size_t bytewise_mismatch(const T* p, const T* q, std::size_t n) {
+  const std::size_t block = sizeof(T) >= 256 ? 1 : 256 / sizeof(T);
+  std::size_t i = 0;
+  while (i + block <= n &&
+         std::memcmp(p + i, q + i, block * sizeof(T)) == 0) {
+    i += block;
+  }
+  while (i < n && p[i] == q[i]) {
+    ++i;
+  }
+  return i;
+}
+
+template <class I1, class S1, class I2, class S2, class Pred>
+mismatch_result<I1, I2> mismatch(I1 first1, S1 last1, I2 first2, S2 last2,
+                                 Pred& pred, std::false_type) {
+  for (; first1 != last1 && first2 != last2; ++first1, ++first2) {
+    if (!pred(*first1, *first2)) {
+      break;
+    }
+  }
+  return {std::move(first1), std::move(first2)};
+}
+
+template <class I1, class S1, class I2, class S2, class Pred>
+mismatch_result<I1, I2> mismatch(I1 first1, S1 last1, I2 first2, S2 last2,
+                                 Pred&, std::true_type /* memcmp */) {
+  const auto n = std::min(static_cast<std::size_t>(last1 - first1),
+                          static_cast<std::size_t>(last2 - first2));
+  const auto i =
+      static_cast<std::ptrdiff_t>(bytewise_mismatch(first1, first2, n));
+  return {first1 + i, first2 + i};
+}
+
+template <class I1, class S1, class I2, class S2, class Pred>
+bool equal(I1 first1, S1 last1, I2 first2, S2 last2, Pred& pred,
+           std::false_type) {
+  for (; first1 != last1 && first2 != last2; ++first1, ++first2) {
+    if (!pred(*first1, *first2)) {
+      return false;
+    }
+  }
+  return first1 == last1 && first2 == last2;
+}
+
+template <class I1, class S1, class I2, class S2, class Pred>
+bool equal(I1 first1, S1 last1, I2 first2, S2 last2, Pred&,
+           std::true_type /* memcmp */) {
+  const auto n = static_cast<std::size_t>(last1 - first1);
+  return n == static_cast<std::size_t>(last2 - first2) &&
+         (n == 0 || std::memcmp(first1, first2, n * sizeof(*first1)) == 0);
+}
+
+template <class I1, class S1, class I2, class S2, class Compare>
+bool lexicographical_compare(I1 first1, S1 last1, I2 first2, S2 last2,
+                             Compare& comp, std::integral_constant<int, 0>) {
+  for (; first2 != last2; ++first1, ++first2) {
+    if (first1 == last1 || comp(*first1, *first2)) {
+      return true;
+    }
+    if (comp(*first2, *first1)) {
+      return false;
+    }
+  }
+  return false;
+}
+
+template <class I1, class S1, class I2, class S2, class Compare>
+bool lexicographical_compare(I1 first1, S1 last1, I2 first2, S2 last2,
+                             Compare& comp,
+                             std::integral_constant<int, 1> /* prefix */) {
+  const auto n1 = static_cast<std::size_t>(last1 - first1);
+  const auto n2 = static_cast<std::size_t>(last2 - first2);
+  const std::size_t i = bytewise_mismatch(first1, first2, std::min(n1, n2));
+  return i < std::min(n1, n2) ? comp(first1[i], first2[i]) : n1 < n2;
+}
+
+template <class I1, class S1, class I2, class S2, class Compare>
+bool lexicographical_compare(I1 first1, S1 last1, I2 first2, S2 last2,
+                             Compare&,
+                             std::integral_constant<int, 2> /* memcmp */) {
+  const auto n1 = static_cast<std::size_t>(last1 - first1);
+  const auto n2 = static_cast<std::size_t>(last2 - first2);
+  const std::size_t n = std::min(n1, n2);
+  const int order = n == 0 ? 0 : std::memcmp(first1, first2, n);
+  return order != 0 ? order < 0 : n1 < n2;
+}
+}  // namespace detail
+
+template <class I1, class S1, class I2, class S2,
+          class Pred = std::equal_to<>>
+mismatch_result<I1, I2> mismatch(I1 first1, S1 last1, I2 first2, S2 last2,
+                                 Pred pred = {}) {
+  return detail::mismatch(
+      std::move(first1), std::move(last1), std::move(first2),
+      std::move(last2), pred,
+      detail::is_memcmp_equal<I1, S1, I2, S2, Pred>{});
+}
+
+template <class I1, class S1, class I2, class S2,
+          class Pred = std::equal_to<>>
+bool equal(I1 first1, S1 last1, I2 first2, S2 last2, Pred pred = {}) {
+  return detail::equal(std::move(first1), std::move(last1),
+                       std::move(first2), std::move(last2), pred,
+                       detail::is_memcmp_equal<I1, S1, I2, S2, Pred>{});
+}
+
+template <class I1, class S1, class I2, class S2,
+          class Compare = std::less<>>
+bool lexicographical_compare(I1 first1, S1 last1, I2 first2, S2 last2,
+                             Compare comp = {}) {
+  return detail::lexicographical_compare(
+      std::move(first1), std::move(last1), std::move(first2),
+      std::move(last2), comp,
+      detail::lexicographical_kind<I1, S1, I2, S2, Compare>{});
+}
+
+namespace detail {
+template <class R1, class R2>
+using is_range_pair = std::integral_constant<
+    bool, is_range<std::remove_reference_t<R1>>::value &&
+              is_range<std::remove_reference_t<R2>>::value>;
+
+template <class R1, class R2>
+using is_pointer_range_pair =
+    std::integral_constant<bool, is_pointer_range<R1>::value &&
+                                     is_pointer_range<R2>::value>;
+
+template <class R1, class R2, class Pred>
+mismatch_result<iterator_t<R1>, iterator_t<R2>> mismatch_range(
+    R1& r1, R2& r2, Pred& pred, std::true_type /* pointers */) {
+  auto result = ranges::mismatch(pointer_begin(r1), pointer_end(r1),
+                                 pointer_begin(r2), pointer_end(r2), pred);
+  return {ranges::begin(r1) + (result.in1 - pointer_begin(r1)),
+          ranges::begin(r2) + (result.in2 - pointer_begin(r2))};
+}
+
+template <class R1, class R2, class Pred>
+mismatch_result<iterator_t<R1>, iterator_t<R2>> mismatch_range(
+    R1& r1, R2& r2, Pred& pred, std::false_type) {
+  return ranges::mismatch(ranges::begin(r1), ranges::end(r1),
+                          ranges::begin(r2), ranges::end(r2), pred);
+}
+
+template <class R1, class R2, class Pred>
+bool equal_range(R1& r1, R2& r2, Pred& pred, std::true_type /* pointers */) {
+  return ranges::equal(pointer_begin(r1), pointer_end(r1), pointer_begin(r2),
+                       pointer_end(r2), pred);
+}
+
+template <class R1, class R2, class Pred>
+bool equal_range(R1& r1, R2& r2, Pred& pred, std::false_type) {
+  return ranges::equal(ranges::begin(r1), ranges::end(r1), ranges::begin(r2),
+                       ranges::end(r2), pred);
+}
+
+template <class R1, class R2, class Compare>
+bool lexicographical_compare_range(R1& r1, R2& r2, Compare& comp,
+                                   std::true_type /* pointers */) {
+  return ranges::lexicographical_compare(pointer_begin(r1), pointer_end(r1),
+                                         pointer_begin(r2), pointer_end(r2),
+                                         comp);
+}
+
+template <class R1, class R2, class Compare>
+bool lexicographical_compare_range(R1& r1, R2& r2, Compare& comp,
+                                   std::false_type) {
+  return ranges::lexicographical_compare(ranges::begin(r1), ranges::end(r1),
+                                         ranges::begin(r2), ranges::end(r2),
+                                         comp);
+}
+}  // namespace detail
+
+template <class R1, class R2, class Pred = std::equal_to<>,
+          std::enable_if_t<detail::is_range_pair<R1, R2>::value, int> = 0>
+mismatch_result<iterator_t<R1>, iterator_t<R2>> mismatch(R1&& r1, R2&& r2,
+                                                         Pred pred = {}) {
+  return detail::mismatch_range(r1, r2, pred,
+                                detail::is_pointer_range_pair<R1, R2>{});
+}
+
+template <class R1, class R2, class Pred = std::equal_to<>,
+          std::enable_if_t<detail::is_range_pair<R1, R2>::value, int> = 0>
+bool equal(R1&& r1, R2&& r2, Pred pred = {}) {
+  return detail::equal_range(r1, r2, pred,
+                             detail::is_pointer_range_pair<R1, R2>{});
+}
+
+template <class R1, class R2, class Compare = std::less<>,
+          std::enable_if_t<detail::is_range_pair<R1, R2>::value, int> = 0>
+bool lexicographical_compare(R1&& r1, R2&& r2, Compare comp = {}) {
+  return detail::lexicographical_compare_range(
+      r1, r2, comp, detail::is_pointer_range_pair<R1, R2>{});
+}
+
+// fill
+//
+// Arrays of scalars are filled with memset when the value is one byte
+// wide or all zero bytes, and so are ranges that are contiguous and sized.
+namespace detail {
+template <class O, class S, class T>
+using is_memset_fill = std::integral_constant<
+    bool, std::is_pointer<O>::value && std::is_same<O, S>::value &&
+              std::is_scalar<std::remove_pointer_t<O>>::value &&
+              !std::is_const<std::remove_pointer_t<O>>::value &&
+              !std::is_volatile<std::remove_pointer_t<O>>::value &&
+              std::is_assignable<std::remove_pointer_t<O>&, const T&>::value>;
+
+template <class O, class S, class T>
+O fill(O first, S last, const T& value, std::false_type) {
+  for (; first != last; ++first) {
+    *first = value;
+  }
+  return first;
+}
+
+template <class O, class S, class T>
+O fill(O first, S last, const T& value, std::true_type /* memset */) {
+  using E = std::remove_pointer_t<O>;
+  E x;
+  x = value;
+  unsigned char bytes[sizeof(E)];
+  std::memcpy(bytes, &x, sizeof(E));
+  const auto n = static_cast<std::size_t>(last - first);
+  if (n == 0) {
+    return first;
+  }
+  if (sizeof(E) == 1) {
+    std::memset(first, bytes[0], n);
+    return last;
+  }
+  for (unsigned char byte : bytes) {
+    if (byte != 0) {
+      return detail::fill(first, last, x, std::false_type{});
+    }
+  }
+  std::memset(first, 0, n * sizeof(E));
+  return last;
+}
+}  // namespace detail
+
+template <class O, class S, class T>
+O fill(O first, S last, const T& value) {
+  return detail::fill(std::move(first), std::move(last), value,
+                      detail::is_memset_fill<O, S, T>{});
+}
+
+namespace detail {
+template <class R, class T>
+iterator_t<R> fill_range(R& r, const T& value, std::true_type /* pointers */) {
+  return ranges::begin(r) +
+         (ranges::fill(pointer_begin(r), pointer_end(r), value) -
+          pointer_begin(r));
+}
+
+template <class R, class T>
+iterator_t<R> fill_range(R& r, const T& value, std::false_type) {
+  return ranges::fill(ranges::begin(r), ranges::end(r), value);
+}
+}  // namespace detail
+
+template <class R, class T,
+          std::enable_if_t<detail::is_range<std::remove_reference_t<R>>::value,
+                           int> = 0>
+iterator_t<R> fill(R&& r, const T& value) {
+  return detail::fill_range(r, value, detail::is_pointer_range<R>{});
+}
+
+// radix_sort
+//
+// Sorts a random-access sized range by a key of integer, enum, float,
+// double, std::chrono::duration or time_point type, least significant byte
+// first. The key is read through a projection, a callable or a pointer to
+// member as in C++20's ranges algorithms. Stable: equal keys keep their
+// order.
+//
+// One pass over the input counts the bytes at every position at once, and
+// positions where all keys share their byte cost nothing more, so keys in
+// a narrow range, such as the timestamps of one day, sort in a few passes.
+// Negative keys come first, -0.0 before 0.0, and NaNs go to the end their
+// sign bit says.
+//
+// Elements move between the range and a buffer of the same size, so the
+// value type must be default constructible. Ranges of a few dozen elements
+// are insertion sorted instead.
+namespace detail {
+// Calls a projection, or reads the member a pointer to member names.
+template <class Proj, class T,
+          std::enable_if_t<!std::is_member_pointer<Proj>::value, int> = 0>
+decltype(auto) project(Proj& proj, T&& x) {
+  return proj(std::forward<T>(x));
+}
+
+template <class Proj, class T,
+          std::enable_if_t<std::is_member_object_pointer<Proj>::value,
+                           int> = 0>
+decltype(auto) project(Proj& proj, T&& x) {
+  return std::forward<T>(x).*proj;
+}
+
+template <class Proj, class T,
+          std::enable_if_t<std::is_member_function_pointer<Proj>::value,
+                           int> = 0>
+decltype(auto) project(Proj& proj, T&& x) {
+  return (std::forward<T>(x).*proj)();
+}
+
+template <class R, class Proj>
+using projected_t = std::decay_t<decltype(detail::project(
+    std::declval<Proj&>(), std::declval<range_reference_t<R>>()))>;
+
+// Maps a key to an unsigned integer of its size that orders the same way.
+template <class K, class = void>
+struct radix_key {};
+
+template <class U>
+constexpr U radix_sign_bit() noexcept {
+  return static_cast<U>(U{1} << (8 * sizeof(U) - 1));
+}
+
+// Signed integers flip the sign bit.
+template <class K>
+struct radix_key<K, std::enable_if_t<std::is_integral<K>::value>> {
+  using type = typename v1::detail::sized_integer<sizeof(K), false>::type;
+
+  static type get(K key) noexcept {
+    return std::is_signed<K>::value
+               ? static_cast<type>(static_cast<type>(key) ^
+                                   radix_sign_bit<type>())
+               : static_cast<type>(key);
+  }
+};
+
+template <class K>
+struct radix_key<K, std::enable_if_t<std::is_enum<K>::value>>
+    : radix_key<std::underlying_type_t<K>> {
+  using base = radix_key<std::underlying_type_t<K>>;
+
+  static typename base::type get(K key) noexcept {
+    return base::get(static_cast<std::underlying_type_t<K>>(key));
+  }
+};
+
+// Floating-point keys flip every bit when negative, and otherwise only the
+// sign bit, so that greater magnitudes sort lower below zero.
+template <class K>
+struct radix_key<K, std::enable_if_t<std::is_floating_point<K>::value &&
+                                     (sizeof(K) == 4 || sizeof(K) == 8)>> {
+  using type = typename v1::detail::sized_integer<sizeof(K), false>::type;
+
+  static type get(K key) noexcept {
+    type bits;
+    std::memcpy(&bits, &key, sizeof(K));
+    return (bits & radix_sign_bit<type>()) != 0
+               ? static_cast<type>(~bits)
+               : static_cast<type>(bits | radix_sign_bit<type>());
+  }
+};
+
+template <class Rep, class Period>
+struct radix_key<std::chrono::duration<Rep, Period>,
+                 void_t<typename radix_key<Rep>::type>> {
+  using type = typename radix_key<Rep>::type;
+
+  static type get(std::chrono::duration<Rep, Period> key) noexcept {
+    return radix_key<Rep>::get(key.count());
+  }
+};
+
+template <class Clock, class Duration>
+struct radix_key<std::chrono::time_point<Clock, Duration>,
+                 void_t<typename radix_key<Duration>::type>> {
+  using type = typename radix_key<Duration>::type;
+
+  static type get(std::chrono::time_point<Clock, Duration> key) noexcept {
+    return radix_key<Duration>::get(key.time_since_epoch());
+  }
+};
+
+template <class R, class Proj, class = void>
+struct is_radix_sortable : std::false_type {};
+
+template <class R, class Proj>
+struct is_radix_sortable<
+    R, Proj, void_t<typename radix_key<projected_t<R, Proj>>::type>>
+    : std::integral_constant<bool, is_random_access_range<R>::value &&
+                                       is_sized_range<R>::value> {};
+
+// The radix key of an element, through the projection.
+template <class Proj, class K>
+struct radix_projection {
+  using key_type = typename radix_key<K>::type;
+
+  template <class T>
+  key_type operator()(T&& x) const {
+    return radix_key<K>::get(detail::project(proj, std::forward<T>(x)));
+  }
+
+  Proj& proj;
+};
+
+enum : std::size_t { radix_digits = 256, radix_insertion_limit = 48 };
+
+template <class U>
+std::size_t radix_digit(U key, std::size_t byte) noexcept {
+  return static_cast<std::size_t>(key >> (8 * byte)) & (radix_digits - 1);
+}
+
+template <class U>
+using radix_counts = std::array<std::size_t, sizeof(U) * radix_digits>;
+
+// Adds the digits of [first, first + n) at every byte position to counts.
+template <class I, class Key>
+void radix_count(I first, std::size_t n, Key& key,
+                 radix_counts<typename Key::key_type>& counts) {
+  using U = typename Key::key_type;
+  for (I it = first, last = first + static_cast<std::ptrdiff_t>(n);
+       it != last; ++it) {
+    const U k = key(*it);
+    for (std::size_t byte = 0; byte < sizeof(U); ++byte) {
+      ++counts[byte * radix_digits + radix_digit(k, byte)];
+    }
+  }
+}
+
+// Moves [src, src + n) to dst ordered by the digit at `byte`, keeping the
+// order of equal digits, given where each digit's elements start.
+template <class Src, class Dst, class Key>
+void radix_scatter(Src src, std::size_t n, Dst dst, Key& key,
+                   std::size_t byte, std::size_t* offsets) {
+  for (Src it = src, last = src + static_cast<std::ptrdiff_t>(n); it != last;
+       ++it) {
+    const std::size_t to = offsets[radix_digit(key(*it), byte)]++;
+    dst[static_cast<std::ptrdiff_t>(to)] = std::move(*it);
+  }
+}
+
+// Stable, for the short ranges where counting costs more than it saves.
+template <class I, class Key>
+void radix_insertion_sort(I first, std::size_t n, Key& key) {
+  for (std::size_t i = 1; i < n; ++i) {
+    I hole = first + static_cast<std::ptrdiff_t>(i);
+    const auto k = key(*hole);
+    if (!(k < key(*(hole - 1)))) {
+      continue;
+    }
+    auto value = std::move(*hole);
+    do {
+      *hole = std::move(*(hole - 1));
+      --hole;
+    } while (hole != first && k < key(*(hole - 1)));
+    *hole = std::move(value);
+  }
+}
+
+// Sorts [data, data + n) by the bytes of the key below `bytes`, with room
+// for n elements at scratch. Returns whether the result is in scratch.
+template <class I, class J, class Key>
+bool radix_lsd(I data, J scratch, std::size_t n, Key& key,
+               std::size_t bytes) {
+  using U = typename Key::key_type;
+  if (n <= radix_insertion_limit) {
+    radix_insertion_sort(data, n, key);
+    return false;
+  }
+  radix_counts<U> counts{};
+  radix_count(data, n, key, counts);
+  const U first_key = key(*data);
+  bool in_scratch = false;
+  for (std::size_t byte = 0; byte < bytes; ++byte) {
+    const std::size_t* count = counts.data() + byte * radix_digits;
+    if (count[radix_digit(first_key, byte)] == n) {
+      continue;
+    }
+    std::size_t offsets[radix_digits];
+    std::size_t sum = 0;
+    for (std::size_t digit = 0; digit < radix_digits; ++digit) {
+      offsets[digit] = sum;
+      sum += count[digit];
+    }
+    if (in_scratch) {
+      radix_scatter(scratch, n, data, key, byte, offsets);
+    } else {
+      radix_scatter(data, n, scratch, key, byte, offsets);
+    }
+    in_scratch = !in_scratch;
+  }
+  return in_scratch;
+}
+
+template <class I, class Key>
+void radix_sort(I first, std::size_t n, Key& key) {
+  std::vector<iter_value_t<I>> buffer(n <= radix_insertion_limit ? 0 : n);
+  if (radix_lsd(first, buffer.begin(), n, key,
+                sizeof(typename Key::key_type))) {
+    std::move(buffer.begin(), buffer.end(), first);
+  }
+}
+
+template <class R, class Proj>
+using radix_projection_t = radix_projection<Proj, projected_t<R, Proj>>;
+}  // namespace detail
+
+template <class R, class Proj = identity,
+          std::enable_if_t<detail::is_radix_sortable<R, Proj>::value, int> = 0>
+iterator_t<R> radix_sort(R&& r, Proj proj = {}) {
+  detail::radix_projection_t<R, Proj> projection{proj};
+  const auto first = ranges::begin(r);
+  const auto n = static_cast<std::size_t>(ranges::size(r));
+  detail::radix_sort(first, n, projection);
+  return first + static_cast<range_difference_t<R>>(n);
+}
+}  // namespace ranges
+
+// Parallel algorithms
+//
+// Overloads taking an execution policy first, as in C++17, over iterator
+// pairs here and over common ranges in ranges::. See execution.hpp.
+namespace detail {
+template <class I, class F>
+void for_each_n_at(I first, std::size_t begin, std::size_t end, F& f) {
+  for (I it = first + begin, last = first + end; it != last; ++it) {
+    f(*it);
+  }
+}
+
+template <class P, class I, class F>
+void for_each(P&& policy, I first, I last, F& f, std::true_type) {
+  const chunk_plan plan = plan_chunks(
+      policy, static_cast<std::size_t>(last - first), element_grain);
+  run_chunks(policy, plan, [&](std::size_t chunk) {
+    for_each_n_at(first, plan.begin(chunk), plan.end(chunk), f);
+  });
+}
+
+template <class P, class I, class F>
+void for_each(P&&, I first, I last, F& f, std::false_type) {
+  std::for_each(first, last, f);
+}
+
+template <class P, class I, class O, class F>
+O transform(P&& policy, I first, I last, O out, F& op, std::true_type) {
+  const chunk_plan plan = plan_chunks(
+      policy, static_cast<std::size_t>(last - first), element_grain);
+  run_chunks(policy, plan, [&](std::size_t chunk) {
+    const auto begin = static_cast<std::ptrdiff_t>(plan.begin(chunk));
+    const auto end = static_cast<std::ptrdiff_t>(plan.end(chunk));
+    std::transform(first + begin, first + end, out + begin, op);
+  });
+  return out + (last - first);
+}
+
+template <class P, class I, class O, class F>
+O transform(P&&, I first, I last, O out, F& op, std::false_type) {
+  return std::transform(first, last, out, op);
+}
+
+template <class P, class I1, class I2, class O, class F>
+O transform(P&& policy, I1 first1, I1 last1, I2 first2, O out, F& op,
+            std::true_type) {
+  const chunk_plan plan = plan_chunks(
+      policy, static_cast<std::size_t>(last1 - first1), element_grain);
+  run_chunks(policy, plan, [&](std::size_t chunk) {
+    const auto begin = static_cast<std::ptrdiff_t>(plan.begin(chunk));
+    const auto end = static_cast<std::ptrdiff_t>(plan.end(chunk));
+    std::transform(first1 + begin, first1 + end, first2 + begin,
+                   out + begin, op);
+  });
+  return out + (last1 - first1);
+}
+
+template <class P, class I1, class I2, class O, class F>
+O transform(P&&, I1 first1, I1 last1, I2 first2, O out, F& op,
+            std::false_type) {
+  return std::transform(first1, last1, first2, out, op);
+}
+
+// Marks the matches of each chunk and counts them, then copies each
+// chunk's matches to where the counts before it end.
+template <class P, class I, class O, class Pred>
+O copy_if(P&& policy, I first, I last, O out, Pred& pred, std::true_type) {
+  const auto n = static_cast<std::size_t>(last - first);
+  const chunk_plan plan = plan_chunks(policy, n, element_grain);
+  std::vector<unsigned char> matches(n);
+  std::vector<std::size_t> offsets(plan.count() + 1);
+  run_chunks(policy, plan, [&](std::size_t chunk) {
+    std::size_t count = 0;
+    for (std::size_t i = plan.begin(chunk); i < plan.end(chunk); ++i) {
+      matches[i] = pred(first[static_cast<std::ptrdiff_t>(i)]) ? 1 : 0;
+      count += matches[i];
+    }
+    offsets[chunk + 1] = count;
+  });
+  for (std::size_t chunk = 0; chunk < plan.count(); ++chunk) {
+    offsets[chunk + 1] += offsets[chunk];
+  }
+  run_chunks(policy, plan, [&](std::size_t chunk) {
+    O to = out + static_cast<std::ptrdiff_t>(offsets[chunk]);
+    for (std::size_t i = plan.begin(chunk); i < plan.end(chunk); ++i) {
+      if (matches[i]) {
+        *to = first[static_cast<std::ptrdiff_t>(i)];
+        ++to;
+      }
+    }
+  });
+  return out + static_cast<std::ptrdiff_t>(offsets.back());
+}
+
+template <class P, class I, class O, class Pred>
+O copy_if(P&&, I first, I last, O out, Pred& pred, std::false_type) {
+  return std::copy_if(first, last, out, pred);
+}
+
+// How many of the first d elements of the merge of a and b come from a,
+// taking a's element first among equal ones.
+template <class A, class B, class Compare>
+std::size_t merge_split(A a, std::size_t na, B b, std::size_t nb,
+                        std::size_t d, Compare& comp) {
+  std::size_t lo = d > nb ? d - nb : 0;
+  std::size_t hi = std::min(d, na);
+  while (lo < hi) {
+    const std::size_t mid = lo + (hi - lo) / 2;
+    if (comp(b[static_cast<std::ptrdiff_t>(d - mid - 1)],
+             a[static_cast<std::ptrdiff_t>(mid)])) {
+      hi = mid;
+    } else {
+      lo = mid + 1;
+    }
+  }
+  return lo;
+}
+
+// Merges pairs of adjacent sorted runs from src into dst, the runs
+// starting at bounds[0], bounds[1], ... and the last ending at
+// bounds.back(). Each merge is cut into pieces at equal output positions,
+// `pieces` pieces over all merges, so the last rounds of a merge sort,
+// with few long runs, are as parallel as the first.
+template <class P, class Src, class Dst, class Compare>
+void merge_runs(P& policy, Src src, Dst dst,
+                const std::vector<std::size_t>& bounds, std::size_t pieces,
+                Compare& comp) {
+  const std::size_t runs = bounds.size() - 1;
+  const std::size_t pairs = (runs + 1) / 2;
+  const std::size_t per_pair = std::max<std::size_t>(1, pieces / pairs);
+  run_chunks(policy, chunk_plan(pairs * per_pair, 1), [&](std::size_t item) {
+    const std::size_t pair = item / per_pair;
+    const std::size_t piece = item % per_pair;
+    const std::size_t a = bounds[2 * pair];
+    const std::size_t mid = bounds[std::min(2 * pair + 1, runs)];
+    const std::size_t b_end = bounds[std::min(2 * pair + 2, runs)];
+    const std::size_t total = b_end - a;
+    const std::size_t d0 = total * piece / per_pair;
+    const std::size_t d1 = total * (piece + 1) / per_pair;
+    const auto first_a = src + static_cast<std::ptrdiff_t>(a);
+    const auto first_b = src + static_cast<std::ptrdiff_t>(mid);
+    const std::size_t i0 =
+        merge_split(first_a, mid - a, first_b, b_end - mid, d0, comp);
+    const std::size_t i1 =
+        merge_split(first_a, mid - a, first_b, b_end - mid, d1, comp);
+    std::merge(std::make_move_iterator(first_a + i0),
+               std::make_move_iterator(first_a + i1),
+               std::make_move_iterator(first_b + (d0 - i0)),
+               std::make_move_iterator(first_b + (d1 - i1)),
+               dst + static_cast<std::ptrdiff_t>(a + d0), comp);
+  });
+}
+
+// Sorts chunks in parallel, then merges runs pairwise, alternating between
+// the input and a buffer of the same size.
+template <class P, class I, class Compare>
+void sort(P&& policy, I first, I last, Compare& comp, std::true_type) {
+  const auto n = static_cast<std::size_t>(last - first);
+  const chunk_plan plan = plan_chunks(policy, n, sort_grain);
+  if (plan.count() <= 1) {
+    std::sort(first, last, comp);
+    return;
+  }
+  run_chunks(policy, plan, [&](std::size_t chunk) {
+    std::sort(first + static_cast<std::ptrdiff_t>(plan.begin(chunk)),
+              first + static_cast<std::ptrdiff_t>(plan.end(chunk)), comp);
+  });
+
+  std::vector<typename std::iterator_traits<I>::value_type> buffer(n);
+  std::vector<std::size_t> bounds;
+  for (std::size_t chunk = 0; chunk < plan.count(); ++chunk) {
+    bounds.push_back(plan.begin(chunk));
+  }
+  bounds.push_back(n);
+  bool in_buffer = false;
+  while (bounds.size() > 2) {
+    if (in_buffer) {
+      merge_runs(policy, buffer.begin(), first, bounds, plan.count(), comp);
+    } else {
+      merge_runs(policy, first, buffer.begin(), bounds, plan.count(), comp);
+    }
+    in_buffer = !in_buffer;
+    std::vector<std::size_t> merged;
+    for (std::size_t i = 0; i + 1 < bounds.size(); i += 2) {
+      merged.push_back(bounds[i]);
+    }
+    merged.push_back(n);
+    bounds.swap(merged);
+  }
+  if (in_buffer) {
+    run_chunks(policy, plan, [&](std::size_t chunk) {
+      const auto begin = static_cast<std::ptrdiff_t>(plan.begin(chunk));
+      const auto end = static_cast<std::ptrdiff_t>(plan.end(chunk));
+      std::move(buffer.begin() + begin, buffer.begin() + end, first + begin);
+    });
+  }
+}
+
+template <class P, class I, class Compare>
+void sort(P&&, I first, I last, Compare& comp, std::false_type) {
+  std::sort(first, last, comp);
+}
+}  // namespace detail
+
+template <class P, class I, class F,
+          std::enable_if_t<detail::is_policy<P>::value, int> = 0>
+void for_each(P&& policy, I first, I last, F f) {
+  detail::for_each(policy, first, last, f, detail::runs_parallel<P, I>{});
+}
+
+template <class P, class I, class O, class F,
+          std::enable_if_t<detail::is_policy<P>::value, int> = 0>
+O transform(P&& policy, I first, I last, O out, F op) {
+  return detail::transform(
+      policy, first, last, out, op,
+      std::integral_constant<bool, detail::runs_parallel<P, I>::value &&
+                                       detail::runs_parallel<P, O>::value>{});
+}
+
+template <class P, class I1, class I2, class O, class F,
+          std::enable_if_t<detail::is_policy<P>::value, int> = 0>
+O transform(P&& policy, I1 first1, I1 last1, I2 first2, O out, F op) {
+  return detail::transform(
+      policy, first1, last1, first2, out, op,
+      std::integral_constant<bool, detail::runs_parallel<P, I1>::value &&
+                                       detail::runs_parallel<P, I2>::value &&
+                                       detail::runs_parallel<P, O>::value>{});
+}
+
+template <class P, class I, class O, class Pred,
+          std::enable_if_t<detail::is_policy<P>::value, int> = 0>
+O copy_if(P&& policy, I first, I last, O out, Pred pred) {
+  return detail::copy_if(
+      policy, first, last, out, pred,
+      std::integral_constant<bool, detail::runs_parallel<P, I>::value &&
+                                       detail::runs_parallel<P, O>::value>{});
+}
+
+// Not stable. Needs a default-constructible value type for its buffer.
+template <class P, class I, class Compare = std::less<>,
+          std::enable_if_t<detail::is_policy<P>::value, int> = 0>
+void sort(P&& policy, I first, I last, Compare comp = {}) {
+  detail::sort(policy, first, last, comp, detail::runs_parallel<P, I>{});
+}
+
+namespace ranges {
+template <class P, class R, class F,
+          std::enable_if_t<v1::detail::is_policy<P>::value &&
+                               detail::is_common_range<R>::value,
+                           int> = 0>
+void for_each(P&& policy, R&& r, F f) {
+  v1::for_each(policy, ranges::begin(r), ranges::end(r), std::move(f));
+}
+
+template <class P, class R, class O, class F,
+          std::enable_if_t<v1::detail::is_policy<P>::value &&
+                               detail::is_common_range<R>::value,
+                           int> = 0>
+O transform(P&& policy, R&& r, O out, F op) {
+  return v1::transform(policy, ranges::begin(r), ranges::end(r),
+                       std::move(out), std::move(op));
+}
+
+template <class P, class R, class O, class Pred,
+          std::enable_if_t<v1::detail::is_policy<P>::value &&
+                               detail::is_common_range<R>::value,
+                           int> = 0>
+O copy_if(P&& policy, R&& r, O out, Pred pred) {
+  return v1::copy_if(policy, ranges::begin(r), ranges::end(r),
+                     std::move(out), std::move(pred));
+}
+
+template <class P, class R, class Compare = std::less<>,
+          std::enable_if_t<v1::detail::is_policy<P>::value &&
+                               detail::is_common_range<R>::value,
+                           int> = 0>
+void sort(P&& policy, R&& r, Compare comp = {}) {
+  v1::sort(policy, ranges::begin(r), ranges::end(r), std::move(comp));
+}
+
+namespace detail {
+// Counts the digits of each chunk, moves the elements to a buffer by the
+// most significant byte where keys differ, then sorts the buckets of that
+// byte by the bytes below it in parallel, least significant first, back
+// into the range. A bucket holding most of the input sorts on one thread.
+template <class P, class I, class Key>
+void radix_sort(P& policy, I first, std::size_t n, Key& key,
+                std::true_type) {
+  using U = typename Key::key_type;
+  const v1::detail::chunk_plan plan =
+      v1::detail::plan_chunks(policy, n, v1::detail::sort_grain);
+  if (plan.count() <= 1) {
+    detail::radix_sort(first, n, key);
+    return;
+  }
+  std::vector<radix_counts<U>> counts(plan.count());
+  v1::detail::run_chunks(policy, plan, [&](std::size_t chunk) {
+    radix_count(first + static_cast<std::ptrdiff_t>(plan.begin(chunk)),
+                plan.end(chunk) - plan.begin(chunk), key, counts[chunk]);
+  });
+  radix_counts<U> totals{};
+  for (const radix_counts<U>& chunk_counts : counts) {
+    for (std::size_t i = 0; i < totals.size(); ++i) {
+      totals[i] += chunk_counts[i];
+    }
+  }
+
+  const U first_key = key(*first);
+  std::size_t byte = sizeof(U);
+  do {
+    if (byte == 0) {
+      return;  // All keys are equal.
+    }
+    --byte;
+  } while (totals[byte * radix_digits + radix_digit(first_key, byte)] == n);
+
+  // Each chunk's elements of a digit go after those of the chunks before.
+  std::vector<std::size_t> bounds(radix_digits + 1);
+  std::vector<std::array<std::size_t, radix_digits>> offsets(plan.count());
+  for (std::size_t digit = 0; digit < radix_digits; ++digit) {
+    std::size_t at = bounds[digit];
+    for (std::size_t chunk = 0; chunk < plan.count(); ++chunk) {
+      offsets[chunk][digit] = at;
+      at += counts[chunk][byte * radix_digits + digit];
+    }
+    bounds[digit + 1] = at;
+  }
+  std::vector<iter_value_t<I>> buffer(n);
+  v1::detail::run_chunks(policy, plan, [&](std::size_t chunk) {
+    radix_scatter(first + static_cast<std::ptrdiff_t>(plan.begin(chunk)),
+                  plan.end(chunk) - plan.begin(chunk), buffer.begin(), key,
+                  byte, offsets[chunk].data());
+  });
+  v1::detail::run_chunks(
+      policy, v1::detail::chunk_plan(radix_digits, 1),
+      [&](std::size_t digit) {
+        const auto begin = static_cast<std::ptrdiff_t>(bounds[digit]);
+        const std::size_t size = bounds[digit + 1] - bounds[digit];
+        if (!radix_lsd(buffer.begin() + begin, first + begin, size, key,
+                       byte)) {
+          std::move(buffer.begin() + begin,
+                    buffer.begin() + begin + static_cast<std::ptrdiff_t>(size),
+                    first + begin);
+        }
+      });
+}
+
+template <class P, class I, class Key>
+void radix_sort(P&, I first, std::size_t n, Key& key, std::false_type) {
+  detail::radix_sort(first, n, key);
+}
+}  // namespace detail
+
+// Sorts as radix_sort above, most significant byte first under a parallel
+// policy when the range spans more than one chunk.
+template <class P, class R, class Proj = identity,
+          std::enable_if_t<v1::detail::is_policy<P>::value &&
+                               detail::is_radix_sortable<R, Proj>::value,
+                           int> = 0>
+iterator_t<R> radix_sort(P&& policy, R&& r, Proj proj = {}) {
+  detail::radix_projection_t<R, Proj> projection{proj};
+  const auto first = ranges::begin(r);
+  const auto n = static_cast<std::size_t>(ranges::size(r));
+  detail::radix_sort(policy, first, n, projection,
+                     v1::detail::is_parallel_policy<P>{});
+  return first + static_cast<range_difference_t<R>>(n);
+}
+}  // namespace ranges
+}  // namespace v1
+
+using v1::copy_if;
+using v1::for_each;
+using v1::identity;
+using v1::sort;
+using v1::transform;
+}  // namespace stdcpp
+
+#endif  // __SCC_STDCPP_ALGORITHM_HPP__
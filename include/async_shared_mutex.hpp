@@ -0,0 +1,271 @@
+#ifndef __SCC_STDCPP_ASYNC_SHARED_MUTEX_HPP__
+#define __SCC_STDCPP_ASYNC_SHARED_MUTEX_HPP__
+#pragma once
+
+// A reader/writer lock for C++20 coroutines. Only available when compiled as
+// C++20 or later; the header is empty otherwise.
+#if __cplusplus >= 202002L
+
+#include <detail/cpu.hpp>
+
+#include <atomic>
+#include <cassert>
+#include <coroutine>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <type_traits>
+
+namespace stdcpp {
+namespace v1 {
+// co_await m.lock_async() or m.lock_shared_async() suspends the coroutine
+// instead of the thread. Waiters are linked through their awaitables, which
+// live in the suspended coroutine frames, so queueing allocates nothing.
+//
+// The queue is strictly FIFO: a reader arriving behind a waiting writer
+// waits too, so writers are not starved. unlock() and unlock_shared() hand
+// the lock directly to the head of the queue (a writer, or every reader up
+// to the next writer) and resume those coroutines on the unlocking thread
+// before returning.
+//
+// The lock word and queue are guarded by a spin lock held for a few
+// instructions; no thread ever blocks in the kernel.
+class async_shared_mutex {
+ public:
+  class lock_awaiter;
+  class lock_shared_awaiter;
+  template <class Lock>
+  class scoped_awaiter;
+
+  async_shared_mutex() noexcept = default;
+  ~async_shared_mutex() { assert(head_ == nullptr && state_ == 0); }
+
+  async_shared_mutex(const async_shared_mutex&) = delete;
+  async_shared_mutex& operator=(const async_shared_mutex&) = delete;
+
+  // Exclusive locking
+  lock_awaiter lock_async() noexcept;
+  // Resumes with a std::unique_lock that owns the mutex.
+  scoped_awaiter<std::unique_lock<async_shared_mutex>>
+  scoped_lock_async() noexcept;
+
+  bool try_lock() noexcept {
+    guard g(*this);
+    if (state_ != 0) {
+      return false;
+    }
+    state_ = writer;
+    return true;
+  }
+
+  void unlock() noexcept {
+    waiter* ready;
+    {
+      guard g(*this);
+      assert(state_ == writer);
+      state_ = 0;
+      ready = hand_over();
+    }
+    resume(ready);
+  }
+
+  // Shared locking
+  lock_shared_awaiter lock_shared_async() noexcept;
+  // Resumes with a std::shared_lock that owns the mutex.
+  scoped_awaiter<std::shared_lock<async_shared_mutex>>
+  scoped_lock_shared_async() noexcept;
+
+  bool try_lock_shared() noexcept {
+    guard g(*this);
+    // Not past queued waiters, which are all behind a writer.
+    if (state_ == writer || head_ != nullptr) {
+      return false;
+    }
+    ++state_;
+    return true;
+  }
+
+  void unlock_shared() noexcept {
+    waiter* ready = nullptr;
+    {
+      guard g(*this);
+      assert(state_ > 0);
+      if (--state_ == 0) {
+        ready = hand_over();
+      }
+    }
+    resume(ready);
+  }
+
+ private:
+  // -1 while a writer holds the lock, else the number of readers.
+  enum : long { writer = -1 };
+
+  struct waiter {
+    waiter* next = nullptr;
+    std::coroutine_handle<> handle;
+    bool exclusive = false;
+  };
+
+  class guard {
+   public:
+    explicit guard(async_shared_mutex& m) noexcept : m_(m) {
+      detail::backoff backoff;
+      while (m_.busy_.exchange(true, std::memory_order_acquire)) {
+        do {
+          // The holder may have been preempted; let it run.
+          if (backoff.pause() >= 64 || !detail::is_multiprocessor()) {
+            std::this_thread::yield();
+          }
+        } while (m_.busy_.load(std::memory_order_relaxed));
+      }
+    }
+    ~guard() { m_.busy_.store(false, std::memory_order_release); }
+
+    guard(const guard&) = delete;
+    guard& operator=(const guard&) = delete;
+
+   private:
+    async_shared_mutex& m_;
+  };
+
+  // Takes the lock for `w` right away, or queues it and returns false.
+  bool acquire_or_enqueue(waiter& w) noexcept {
+    guard g(*this);
+    if (w.exclusive ? state_ == 0 : state_ != writer && head_ == nullptr) {
+      state_ = w.exclusive ? writer : state_ + 1;
+      return true;
+    }
+    if (tail_ != nullptr) {
+      tail_->next = &w;
+    } else {
+      head_ = &w;
+    }
+    tail_ = &w;
+    return false;
+  }
+
+  // With the lock free, grants it to the head of the queue and returns the
+  // waiters to resume as a list.
+  waiter* hand_over() noexcept {
+    waiter* first = head_;
+    if (first == nullptr) {
+      return nullptr;
+    }
+    waiter* last = first;
+    if (first->exclusive) {
+      state_ = writer;
+    } else {
+      state_ = 1;
+      while (last->next != nullptr && !last->next->exclusive) {
+        last = last->next;
+        ++state_;
+      }
+    }
+    head_ = last->next;
+    if (head_ == nullptr) {
+      tail_ = nullptr;
+    }
+    last->next = nullptr;
+    return first;
+  }
+
+  static void resume(waiter* w) noexcept {
+    while (w != nullptr) {
+      // The frame holding `w` may be gone once resumed.
+      waiter* next = w->next;
+      w->handle.resume();
+      w = next;
+    }
+  }
+
+  std::atomic<bool> busy_{false};
+  long state_ = 0;
+  waiter* head_ = nullptr;
+  waiter* tail_ = nullptr;
+};
+
+class async_shared_mutex::lock_awaiter {
+ public:
+  explicit lock_awaiter(async_shared_mutex& m) noexcept : m_(m) {
+    w_.exclusive = true;
+  }
+
+  bool await_ready() noexcept { return m_.try_lock(); }
+  bool await_suspend(std::coroutine_handle<> h) noexcept {
+    w_.handle = h;
+    return !m_.acquire_or_enqueue(w_);
+  }
+  void await_resume() noexcept {}
+
+ protected:
+  async_shared_mutex& m_;
+
+ private:
+  waiter w_;
+};
+
+class async_shared_mutex::lock_shared_awaiter {
+ public:
+  explicit lock_shared_awaiter(async_shared_mutex& m) noexcept : m_(m) {
+    w_.exclusive = false;
+  }
+
+  bool await_ready() noexcept { return m_.try_lock_shared(); }
+  bool await_suspend(std::coroutine_handle<> h) noexcept {
+    w_.handle = h;
+    return !m_.acquire_or_enqueue(w_);
+  }
+  void await_resume() noexcept {}
+
+ protected:
+  async_shared_mutex& m_;
+
+ private:
+  waiter w_;
+};
+
+template <class Lock>
+class async_shared_mutex::scoped_awaiter
+    : public std::conditional_t<
+          std::is_same_v<Lock, std::unique_lock<async_shared_mutex>>,
+          lock_awaiter, lock_shared_awaiter> {
+  using base = std::conditional_t<
+      std::is_same_v<Lock, std::unique_lock<async_shared_mutex>>,
+      lock_awaiter, lock_shared_awaiter>;
+
+ public:
+  using base::base;
+
+  Lock await_resume() noexcept { return Lock(this->m_, std::adopt_lock); }
+};
+
+inline async_shared_mutex::lock_awaiter
+async_shared_mutex::lock_async() noexcept {
+  return lock_awaiter(*this);
+}
+
+inline async_shared_mutex::scoped_awaiter<
+    std::unique_lock<async_shared_mutex>>
+async_shared_mutex::scoped_lock_async() noexcept {
+  return scoped_awaiter<std::unique_lock<async_shared_mutex>>(*this);
+}
+
+inline async_shared_mutex::lock_shared_awaiter
+async_shared_mutex::lock_shared_async() noexcept {
+  return lock_shared_awaiter(*this);
+}
+
+inline async_shared_mutex::scoped_awaiter<
+    std::shared_lock<async_shared_mutex>>
+async_shared_mutex::scoped_lock_shared_async() noexcept {
+  return scoped_awaiter<std::shared_lock<async_shared_mutex>>(*this);
+}
+}  // namespace v1
+
+using v1::async_shared_mutex;
+}  // namespace stdcpp
+
+#endif  // __cplusplus >= 202002L
+
+#endif  // __SCC_STDCPP_ASYNC_SHARED_MUTEX_HPP__
@@ -0,0 +1,208 @@
+#ifndef __SCC_STDCPP_ATOMIC_HPP__
+#define __SCC_STDCPP_ATOMIC_HPP__
+#pragma once
+
+#include <detail/cpu.hpp>
+#include <detail/parking.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+// C++20 atomic waiting for std::atomic<T> in C++14:
+//
+//   atomic_wait(&a, old);     // blocks while a holds `old`
+//   atomic_notify_one(&a);    // after changing a, wakes one waiter
+//   atomic_notify_all(&a);    // ... or all of them
+//
+// Nothing is added to the atomic itself. Waiters register in a global hashed
+// table of cache-line sized slots, so a notify that finds its slot empty
+// costs one fence and one load and makes no system call. On Linux 32-bit
+// atomics are then waited on directly with a futex; every other size waits
+// on a per-slot version counter that notifiers bump, which wakes all waiters
+// of the slot.
+
+namespace stdcpp {
+namespace v1 {
+namespace detail {
+template <class T>
+struct atomic_wait_value {
+  using type = T;
+};
+
+struct alignas(cache_line_size) atomic_wait_slot {
+  // Threads blocked, or about to block, on any address hashing here.
+  std::atomic<std::int32_t> waiters{0};
+  // Bumped by notifiers for atomics that cannot be waited on in place.
+  std::atomic<std::int32_t> version{0};
+};
+
+inline atomic_wait_slot& atomic_wait_slot_for(const void* addr) noexcept {
+  static atomic_wait_slot table[256];
+  // Atomics are often cache-line aligned, so mix the high bits down.
+  const auto key = static_cast<std::uint64_t>(
+      reinterpret_cast<std::uintptr_t>(addr));
+  return table[(key * 0x9e3779b97f4a7c15ull) >> 56];
+}
+
+template <class T>
+struct waits_in_place
+    : std::integral_constant<bool,
+#if defined(__linux__)
+                             sizeof(T) == sizeof(std::int32_t) &&
+                                 sizeof(std::atomic<T>) ==
+                                     sizeof(std::int32_t) &&
+                                 alignof(std::atomic<T>) >=
+                                     alignof(std::int32_t)
+#else
+                             false
+#endif
+                             > {
+};
+
+// Only meaningful when waits_in_place<T>: the futex word is the atomic.
+template <class T>
+const std::atomic<std::int32_t>* in_place_word(
+    const std::atomic<T>* object) noexcept {
+  return reinterpret_cast<const std::atomic<std::int32_t>*>(object);
+}
+
+template <class T>
+bool same_value(const T& a, const T& b) noexcept {
+  return std::memcmp(std::addressof(a), std::addressof(b), sizeof(T)) == 0;
+}
+
+// Registration is published before the value is re-read, and notifiers
+// publish the value (the caller's store) before reading the registration,
+// so one of the two always sees the other.
+inline atomic_wait_slot& atomic_wait_enter(const void* addr) noexcept {
+  auto& slot = atomic_wait_slot_for(addr);
+  slot.waiters.fetch_add(1, std::memory_order_seq_cst);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  return slot;
+}
+
+inline void atomic_wait_leave(atomic_wait_slot& slot) noexcept {
+  slot.waiters.fetch_sub(1, std::memory_order_relaxed);
+}
+
+// Blocks once while `*object` holds `old`, for at most `timeout` if given.
+// Returns early on spurious wakeups; callers re-check their condition.
+template <class T>
+void atomic_park(const std::atomic<T>* object, const T& old,
+                 std::memory_order order,
+                 const std::chrono::nanoseconds* timeout,
+                 std::true_type /* in place */) {
+  auto& slot = atomic_wait_enter(object);
+  if (same_value(object->load(order), old)) {
+    const auto* word = in_place_word(object);
+    std::int32_t expected;
+    std::memcpy(&expected, std::addressof(old), sizeof(expected));
+    if (timeout) {
+      park_wait_for(word, expected, *timeout);
+    } else {
+      park_wait(word, expected);
+    }
+  }
+  atomic_wait_leave(slot);
+}
+
+template <class T>
+void atomic_park(const std::atomic<T>* object, const T& old,
+                 std::memory_order order,
+                 const std::chrono::nanoseconds* timeout,
+                 std::false_type /* in place */) {
+  auto& slot = atomic_wait_enter(object);
+  // Read the version before the value: a notify that bumps it after we saw
+  // the old value makes the park below return immediately.
+  const std::int32_t version = slot.version.load(std::memory_order_acquire);
+  if (same_value(object->load(order), old)) {
+    if (timeout) {
+      park_wait_for(&slot.version, version, *timeout);
+    } else {
+      park_wait(&slot.version, version);
+    }
+  }
+  atomic_wait_leave(slot);
+}
+
+template <class T>
+void atomic_notify(const std::atomic<T>* object, bool all) {
+  auto& slot = atomic_wait_slot_for(object);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (slot.waiters.load(std::memory_order_relaxed) == 0) {
+    return;
+  }
+  if (waits_in_place<T>::value) {
+    const auto* word = in_place_word(object);
+    if (all) {
+      unpark_all(word);
+    } else {
+      unpark_one(word);
+    }
+  } else {
+    // Other addresses share the version counter, so wake everyone.
+    slot.version.fetch_add(1, std::memory_order_acq_rel);
+    unpark_all(&slot.version);
+  }
+}
+
+// Blocks at most once while `*object` holds `old`, and does not touch
+// `*object` after waking, so it may be destroyed by then. Not part of the
+// standard interface; condition_variable_any builds on it.
+template <class T>
+void atomic_wait_once(const std::atomic<T>* object,
+                      typename atomic_wait_value<T>::type old,
+                      std::memory_order order) {
+  atomic_park(object, old, order, nullptr, waits_in_place<T>{});
+}
+
+// As atomic_wait_once(), but for at most `rel`. Timed waits such as
+// try_acquire_for() build on it.
+template <class T>
+void atomic_wait_for(const std::atomic<T>* object,
+                     typename atomic_wait_value<T>::type old,
+                     std::memory_order order, std::chrono::nanoseconds rel) {
+  if (rel > std::chrono::nanoseconds::zero()) {
+    atomic_park(object, old, order, &rel, waits_in_place<T>{});
+  }
+}
+}  // namespace detail
+
+template <class T>
+void atomic_wait_explicit(const std::atomic<T>* object,
+                          typename detail::atomic_wait_value<T>::type old,
+                          std::memory_order order) {
+  while (detail::same_value(object->load(order), old)) {
+    detail::atomic_park(object, old, order, nullptr,
+                        detail::waits_in_place<T>{});
+  }
+}
+
+template <class T>
+void atomic_wait(const std::atomic<T>* object,
+                 typename detail::atomic_wait_value<T>::type old) {
+  v1::atomic_wait_explicit(object, old, std::memory_order_seq_cst);
+}
+
+template <class T>
+void atomic_notify_one(std::atomic<T>* object) {
+  detail::atomic_notify(object, false);
+}
+
+template <class T>
+void atomic_notify_all(std::atomic<T>* object) {
+  detail::atomic_notify(object, true);
+}
+}  // namespace v1
+
+using v1::atomic_notify_all;
+using v1::atomic_notify_one;
+using v1::atomic_wait;
+using v1::atomic_wait_explicit;
+}  // namespace stdcpp
+
+#endif  // __SCC_STDCPP_ATOMIC_HPP__
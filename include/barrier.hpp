@@ -0,0 +1,198 @@
+#ifndef __SCC_STDCPP_BARRIER_HPP__
+#define __SCC_STDCPP_BARRIER_HPP__
+#pragma once
+
+#include <atomic.hpp>
+#include <detail/cpu.hpp>
+#include <detail/parking.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace stdcpp {
+namespace v1 {
+namespace detail {
+struct empty_completion {
+  void operator()() noexcept {}
+};
+
+// Small per-thread index used to spread arrivals over the tree leaves.
+// std::thread::id hashes are often stack addresses whose low bits all agree.
+inline std::size_t this_thread_barrier_slot() noexcept {
+  static std::atomic<std::size_t> next{0};
+  thread_local const std::size_t slot =
+      next.fetch_add(1, std::memory_order_relaxed);
+  return slot;
+}
+}  // namespace detail
+
+// C++20 std::barrier for C++14.
+//
+// Arrivals are counted by a combining tree rather than a shared counter:
+// each round pairs arrivals up on per-node tickets, the first of a pair
+// stops there and the second carries on to the next round, so each thread
+// touches O(log n) mostly uncontended cache lines. Whoever comes out of the
+// last round runs the completion function and publishes the new phase.
+// Waiters spin briefly on the phase word and then atomic_wait() on it.
+//
+// As with std::barrier, the completion function must not throw.
+template <class CompletionFunction = detail::empty_completion>
+class barrier {
+ public:
+  class arrival_token {
+   public:
+    arrival_token(arrival_token&&) = default;
+    arrival_token& operator=(arrival_token&&) = default;
+
+   private:
+    friend class barrier;
+    explicit arrival_token(std::int32_t phase) noexcept : phase_(phase) {}
+    std::int32_t phase_;
+  };
+
+  static constexpr std::ptrdiff_t max() noexcept {
+    return std::numeric_limits<std::int32_t>::max();
+  }
+
+  explicit barrier(std::ptrdiff_t expected,
+                   CompletionFunction completion = CompletionFunction())
+      : expected_(expected),
+        node_count_(expected > 1 ? static_cast<std::size_t>(expected + 1) / 2
+                                 : 1),
+        storage_(new unsigned char[(node_count_ + 1) * sizeof(node)]),
+        completion_(std::move(completion)) {
+    // operator new only guarantees fundamental alignment before C++17.
+    void* p = storage_.get();
+    std::size_t space = (node_count_ + 1) * sizeof(node);
+    nodes_ = static_cast<node*>(
+        std::align(alignof(node), node_count_ * sizeof(node), p, space));
+    for (std::size_t i = 0; i < node_count_; ++i) {
+      ::new (static_cast<void*>(nodes_ + i)) node{};
+      for (auto& ticket : nodes_[i].tickets) {
+        ticket.store(0, std::memory_order_relaxed);
+      }
+    }
+  }
+  ~barrier() {
+    for (std::size_t i = 0; i < node_count_; ++i) {
+      nodes_[i].~node();
+    }
+  }
+
+  barrier(const barrier&) = delete;
+  barrier& operator=(const barrier&) = delete;
+
+  arrival_token arrive(std::ptrdiff_t update = 1) {
+    const std::int32_t old_phase = phase_.load(std::memory_order_acquire);
+    const std::size_t slot = detail::this_thread_barrier_slot();
+    for (; update > 0; --update) {
+      if (arrive_at(old_phase, slot)) {
+        complete_phase(old_phase);
+      }
+    }
+    return arrival_token(old_phase);
+  }
+
+  void wait(arrival_token&& token) const {
+    const std::int32_t old_phase = token.phase_;
+    auto passed = [this, old_phase] {
+      return phase_.load(std::memory_order_acquire) != old_phase;
+    };
+    if (passed() || detail::spin_until(passed, 2048)) {
+      return;
+    }
+    while (!passed()) {
+      v1::atomic_wait_explicit(&phase_, old_phase, std::memory_order_acquire);
+    }
+  }
+
+  void arrive_and_wait() { wait(arrive()); }
+
+  // Leaves the barrier: counts as an arrival in the current phase and
+  // lowers the expected count of every later phase by one.
+  void arrive_and_drop() {
+    adjustment_.fetch_sub(1, std::memory_order_relaxed);
+    (void)arrive(1);
+  }
+
+ private:
+  // tickets[round] holds the low byte of the phase it was last completed
+  // for; +1 once the first of a pair has arrived, +2 once both have.
+  struct alignas(detail::cache_line_size) node {
+    std::atomic<std::uint8_t> tickets[detail::cache_line_size];
+  };
+
+  // Returns true for the single arrival that completes the phase.
+  bool arrive_at(std::int32_t old_phase, std::size_t current) noexcept {
+    const auto old_step = static_cast<std::uint8_t>(old_phase);
+    const auto half_step = static_cast<std::uint8_t>(old_step + 1);
+    const auto full_step = static_cast<std::uint8_t>(old_step + 2);
+    std::size_t remaining = static_cast<std::size_t>(expected_);
+    if (remaining <= 1) {
+      return true;
+    }
+    current %= (remaining + 1) / 2;
+    for (std::size_t round = 0;; ++round) {
+      if (remaining <= 1) {
+        return true;
+      }
+      const std::size_t end_node = (remaining + 1) / 2;
+      const std::size_t last_node = end_node - 1;
+      for (;; ++current) {
+        if (current == end_node) {
+          current = 0;
+        }
+        auto& ticket = nodes_[current].tickets[round];
+        std::uint8_t expect = old_step;
+        if (current == last_node && (remaining & 1) != 0) {
+          // An odd node out has no partner this round.
+          if (ticket.compare_exchange_strong(expect, full_step,
+                                             std::memory_order_acq_rel)) {
+            break;
+          }
+        } else if (ticket.compare_exchange_strong(expect, half_step,
+                                                  std::memory_order_acq_rel)) {
+          return false;
+        } else if (expect == half_step &&
+                   ticket.compare_exchange_strong(expect, full_step,
+                                                  std::memory_order_acq_rel)) {
+          break;
+        }
+      }
+      remaining = end_node;
+      current >>= 1;
+    }
+  }
+
+  void complete_phase(std::int32_t old_phase) {
+    completion_();
+    expected_ += adjustment_.exchange(0, std::memory_order_relaxed);
+    // Phases advance by two so that tickets can use the odd half-step.
+    const auto next = static_cast<std::int32_t>(
+        static_cast<std::uint32_t>(old_phase) + 2u);
+    phase_.store(next, std::memory_order_release);
+    v1::atomic_notify_all(&phase_);
+  }
+
+  // Only written by the thread completing a phase, which happens before
+  // every arrival in the next phase.
+  std::ptrdiff_t expected_;
+  std::atomic<std::ptrdiff_t> adjustment_{0};
+  std::size_t node_count_;
+  std::unique_ptr<unsigned char[]> storage_;
+  node* nodes_;
+  CompletionFunction completion_;
+  // Waiters poll the phase; keep arrivals off its cache line.
+  alignas(detail::cache_line_size) std::atomic<std::int32_t> phase_{0};
+};
+}  // namespace v1
+
+using v1::barrier;
+}  // namespace stdcpp
+
+#endif  // __SCC_STDCPP_BARRIER_HPP__
@@ -0,0 +1,658 @@
+#ifndef __SCC_STDCPP_CONCURRENT_UNORDERED_MAP_HPP__
+#define __SCC_STDCPP_CONCURRENT_UNORDERED_MAP_HPP__
+#pragma once
+
+#include <detail/cpu.hpp>
+#include <shared_mutex.hpp>
+#include <string_view.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+// A hash map for concurrent use, split into lock stripes.
+//
+// The top bits of a key's hash pick one of a fixed number of stripes; each
+// stripe is an independent open-addressing table (linear probing, one
+// control byte per slot holding 7 bits of the hash) guarded by its own
+// stdcpp::shared_mutex. Lookups take the stripe's lock shared, updates
+// take it exclusive, so a writer only blocks the readers of its own stripe.
+// A stripe grows by itself when it passes 7/8 full. Growing allocates the
+// new table and leaves the elements in the old one; every later write to
+// the stripe moves a few of the old slots across, and lookups check both
+// tables until the old one is drained. So no resize pauses the map, nor
+// even its stripe, for longer than it takes to move those few slots, short
+// of a stripe that must grow again before its last move is done, which
+// finishes that move first.
+//
+// There are no iterators and nothing returns a reference into the table.
+// Elements are reached through visitors that run while the stripe is
+// locked, which is what keeps them from dangling. A visitor must not call
+// back into the same map.
+
+namespace stdcpp {
+namespace v1 {
+namespace detail {
+template <class...>
+struct make_void {
+  using type = void;
+};
+
+template <class Hash, class KeyEqual, class = void>
+struct is_transparent_lookup : std::false_type {};
+
+template <class Hash, class KeyEqual>
+struct is_transparent_lookup<
+    Hash, KeyEqual,
+    typename make_void<typename Hash::is_transparent,
+                       typename KeyEqual::is_transparent>::type>
+    : std::true_type {};
+
+inline std::uint64_t hash_bytes(const char* data, std::size_t size) noexcept {
+  const std::uint64_t multiplier = 0x9fb21c651e98df25ull;
+  std::uint64_t h = 0x9e3779b97f4a7c15ull ^ size;
+  for (; size >= 8; data += 8, size -= 8) {
+    std::uint64_t word;
+    std::memcpy(&word, data, 8);
+    h = (h ^ word) * multiplier;
+    h ^= h >> 29;
+  }
+  if (size != 0) {
+    std::uint64_t word = 0;
+    std::memcpy(&word, data, size);
+    h = (h ^ word) * multiplier;
+    h ^= h >> 29;
+  }
+  return h;
+}
+
+// Spreads weak hashes such as std::hash<int>'s identity over all 64 bits.
+inline std::uint64_t mix_hash(std::uint64_t h) noexcept {
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdull;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ull;
+  h ^= h >> 33;
+  return h;
+}
+}  // namespace detail
+
+// Transparent hash and equality for std::string keys, so that lookups by
+// string_view or const char* need no temporary std::string.
+struct string_hash {
+  using is_transparent = void;
+
+  std::size_t operator()(string_view s) const noexcept {
+    return static_cast<std::size_t>(detail::hash_bytes(s.data(), s.size()));
+  }
+  std::size_t operator()(const std::string& s) const noexcept {
+    return static_cast<std::size_t>(detail::hash_bytes(s.data(), s.size()));
+  }
+  std::size_t operator()(const char* s) const noexcept {
+    return (*this)(string_view(s));
+  }
+};
+
+struct string_equal {
+  using is_transparent = void;
+
+  template <class A, class B>
+  bool operator()(const A& a, const B& b) const noexcept {
+    return view(a) == view(b);
+  }
+
+ private:
+  static string_view view(string_view s) noexcept { return s; }
+  static string_view view(const std::string& s) noexcept {
+    return string_view(s.data(), s.size());
+  }
+  static string_view view(const char* s) noexcept { return string_view(s); }
+};
+
+namespace detail {
+template <class Key>
+struct default_map_hash {
+  using type = std::hash<Key>;
+  using equal = std::equal_to<Key>;
+};
+
+template <>
+struct default_map_hash<std::string> {
+  using type = string_hash;
+  using equal = string_equal;
+};
+}  // namespace detail
+
+template <class Key, class T,
+          class Hash = typename detail::default_map_hash<Key>::type,
+          class KeyEqual = typename detail::default_map_hash<Key>::equal>
+class concurrent_unordered_map {
+  template <class K>
+  using if_transparent = std::enable_if_t<
+      detail::is_transparent_lookup<Hash, KeyEqual>::value &&
+          !std::is_same<K, Key>::value,
+      int>;
+
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const Key, T>;
+  using size_type = std::size_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+
+  // `stripes` is rounded up to a power of two; 0 picks four per hardware
+  // thread.
+  explicit concurrent_unordered_map(size_type stripes = 0,
+                                    const Hash& hash = Hash(),
+                                    const KeyEqual& equal = KeyEqual())
+      : hash_(hash), equal_(equal) {
+    if (stripes == 0) {
+      stripes = 4 * static_cast<size_type>(
+                        std::max(1u, std::thread::hardware_concurrency()));
+    }
+    size_type count = 1;
+    while (count < stripes && count < max_stripes) {
+      count <<= 1;
+    }
+    stripe_mask_ = count - 1;
+    stripes_.reset(new stripe[count]);
+  }
+
+  ~concurrent_unordered_map() = default;
+
+  concurrent_unordered_map(const concurrent_unordered_map&) = delete;
+  concurrent_unordered_map& operator=(const concurrent_unordered_map&) =
+      delete;
+
+  hasher hash_function() const { return hash_; }
+  key_equal key_eq() const { return equal_; }
+  size_type stripe_count() const noexcept { return stripe_mask_ + 1; }
+
+  // A snapshot; other threads may change it at once.
+  size_type size() const {
+    size_type total = 0;
+    for (size_type i = 0; i <= stripe_mask_; ++i) {
+      std::shared_lock<shared_mutex> lock(stripes_[i].mutex);
+      total += stripes_[i].size;
+    }
+    return total;
+  }
+  bool empty() const { return size() == 0; }
+
+  // Lookup. visit() passes a mutable value_type& under the stripe's
+  // exclusive lock; cvisit() (and visit() on a const map) a const one under
+  // its shared lock. Return the number of elements visited, 0 or 1.
+  template <class F>
+  size_type visit(const key_type& key, F f) {
+    return visit_key(key, f);
+  }
+  template <class K, class F, if_transparent<K> = 0>
+  size_type visit(const K& key, F f) {
+    return visit_key(key, f);
+  }
+  template <class F>
+  size_type visit(const key_type& key, F f) const {
+    return cvisit_key(key, f);
+  }
+  template <class K, class F, if_transparent<K> = 0>
+  size_type visit(const K& key, F f) const {
+    return cvisit_key(key, f);
+  }
+  template <class F>
+  size_type cvisit(const key_type& key, F f) const {
+    return cvisit_key(key, f);
+  }
+  template <class K, class F, if_transparent<K> = 0>
+  size_type cvisit(const K& key, F f) const {
+    return cvisit_key(key, f);
+  }
+
+  bool contains(const key_type& key) const { return count(key) != 0; }
+  template <class K, if_transparent<K> = 0>
+  bool contains(const K& key) const {
+    return count(key) != 0;
+  }
+  size_type count(const key_type& key) const {
+    return cvisit_key(key, [](const value_type&) {});
+  }
+  template <class K, if_transparent<K> = 0>
+  size_type count(const K& key) const {
+    return cvisit_key(key, [](const value_type&) {});
+  }
+
+  // Visits every element, one stripe at a time. Returns how many it saw.
+  template <class F>
+  size_type visit_all(F f) {
+    size_type visited = 0;
+    for (size_type i = 0; i <= stripe_mask_; ++i) {
+      stripe& s = stripes_[i];
+      std::lock_guard<shared_mutex> lock(s.mutex);
+      visited += for_each_in(s, f);
+    }
+    return visited;
+  }
+  template <class F>
+  size_type visit_all(F f) const {
+    return cvisit_all(f);
+  }
+  template <class F>
+  size_type cvisit_all(F f) const {
+    size_type visited = 0;
+    for (size_type i = 0; i <= stripe_mask_; ++i) {
+      const stripe& s = stripes_[i];
+      std::shared_lock<shared_mutex> lock(s.mutex);
+      visited += for_each_in(s, f);
+    }
+    return visited;
+  }
+
+  // Insertion. Each returns true if it inserted and false if the key was
+  // already present.
+  bool insert(const value_type& value) {
+    return insert_or_visit(value, [](value_type&) {});
+  }
+  bool insert(value_type&& value) {
+    return insert_or_visit(std::move(value), [](value_type&) {});
+  }
+
+  template <class... Args>
+  bool try_emplace(const key_type& key, Args&&... args) {
+    return emplace_key(
+        key,
+        [&](void* where) {
+          ::new (where) value_type(std::piecewise_construct,
+                                   std::forward_as_tuple(key),
+                                   std::forward_as_tuple(
+                                       std::forward<Args>(args)...));
+        },
+        [](value_type&) {});
+  }
+  template <class... Args>
+  bool try_emplace(key_type&& key, Args&&... args) {
+    return emplace_key(
+        key,
+        [&](void* where) {
+          ::new (where) value_type(std::piecewise_construct,
+                                   std::forward_as_tuple(std::move(key)),
+                                   std::forward_as_tuple(
+                                       std::forward<Args>(args)...));
+        },
+        [](value_type&) {});
+  }
+
+  template <class M>
+  bool insert_or_assign(const key_type& key, M&& mapped) {
+    return emplace_key(
+        key,
+        [&](void* where) {
+          ::new (where) value_type(key, std::forward<M>(mapped));
+        },
+        [&](value_type& existing) {
+          existing.second = std::forward<M>(mapped);
+        });
+  }
+
+  // Inserts `value`, or else runs `f` on the element already there under
+  // the stripe's exclusive lock.
+  template <class F>
+  bool insert_or_visit(const value_type& value, F f) {
+    return emplace_key(
+        value.first,
+        [&](void* where) { ::new (where) value_type(value); }, f);
+  }
+  template <class F>
+  bool insert_or_visit(value_type&& value, F f) {
+    return emplace_key(
+        value.first,
+        [&](void* where) { ::new (where) value_type(std::move(value)); }, f);
+  }
+
+  // Erasure. Each returns the number of elements erased.
+  size_type erase(const key_type& key) {
+    return erase_key(key, [](const value_type&) { return true; });
+  }
+  template <class K, if_transparent<K> = 0>
+  size_type erase(const K& key) {
+    return erase_key(key, [](const value_type&) { return true; });
+  }
+  template <class Predicate>
+  size_type erase_if(const key_type& key, Predicate pred) {
+    return erase_key(key, pred);
+  }
+  template <class Predicate>
+  size_type erase_if(Predicate pred) {
+    size_type erased = 0;
+    for (size_type i = 0; i <= stripe_mask_; ++i) {
+      stripe& s = stripes_[i];
+      std::lock_guard<shared_mutex> lock(s.mutex);
+      for (table* t : {&s.current, &s.old}) {
+        for (size_type slot = 0; slot < t->capacity; ++slot) {
+          if (t->ctrl[slot] >= full_bit &&
+              pred(static_cast<const value_type&>(*t->value(slot)))) {
+            erase_slot(s, *t, slot);
+            ++erased;
+          }
+        }
+      }
+    }
+    return erased;
+  }
+
+  void clear() {
+    for (size_type i = 0; i <= stripe_mask_; ++i) {
+      stripe& s = stripes_[i];
+      std::lock_guard<shared_mutex> lock(s.mutex);
+      s.destroy_all();
+    }
+  }
+
+  // Grows every stripe to hold its share of `count` elements.
+  void reserve(size_type count) {
+    const size_type per_stripe = count / stripe_count() + 1;
+    for (size_type i = 0; i <= stripe_mask_; ++i) {
+      stripe& s = stripes_[i];
+      std::lock_guard<shared_mutex> lock(s.mutex);
+      if (per_stripe * 8 > s.current.capacity * 7) {
+        grow(s, capacity_for(per_stripe));
+      }
+    }
+  }
+
+ private:
+  // Old slots moved by each write to a growing stripe.
+  enum : size_type {
+    max_stripes = 1 << 16,
+    migrate_step = 16,
+    not_found = ~size_type(0)
+  };
+  enum : std::uint8_t { empty_slot = 0, deleted_slot = 1, full_bit = 0x80 };
+
+  using storage =
+      typename std::aligned_storage<sizeof(value_type),
+                                    alignof(value_type)>::type;
+
+  // An open-addressing table: a control byte and a slot per entry.
+  struct table {
+    value_type* value(size_type i) noexcept {
+      return reinterpret_cast<value_type*>(&slots[i]);
+    }
+    const value_type* value(size_type i) const noexcept {
+      return reinterpret_cast<const value_type*>(&slots[i]);
+    }
+
+    void destroy_all() noexcept {
+      for (size_type i = 0; i < capacity; ++i) {
+        if (ctrl[i] >= full_bit) {
+          value(i)->~value_type();
+        }
+        ctrl[i] = empty_slot;
+      }
+    }
+
+    std::unique_ptr<std::uint8_t[]> ctrl;
+    std::unique_ptr<storage[]> slots;
+    size_type capacity = 0;
+  };
+
+  struct stripe {
+    stripe() = default;
+    stripe(const stripe&) = delete;
+    stripe& operator=(const stripe&) = delete;
+    ~stripe() { destroy_all(); }
+
+    bool migrating() const noexcept { return old.capacity != 0; }
+
+    void destroy_all() noexcept {
+      current.destroy_all();
+      old.destroy_all();
+      old = table();
+      migrated = 0;
+      size = 0;
+      tombstones = 0;
+    }
+
+    mutable shared_mutex mutex;
+    table current;
+    // While the stripe grows, the table it grows out of. Its slots below
+    // `migrated` have been moved to `current` and are marked deleted, so
+    // probes pass over them.
+    table old;
+    size_type migrated = 0;
+    // Elements in both tables, tombstones in `current` alone.
+    size_type size = 0;
+    size_type tombstones = 0;
+    // Keeps neighbouring stripes' locks off each other's cache line.
+    char pad[detail::cache_line_size];
+  };
+
+  template <class K>
+  std::uint64_t hash_of(const K& key) const {
+    return detail::mix_hash(static_cast<std::uint64_t>(hash_(key)));
+  }
+
+  // Stripes use high bits of the hash, slots the low ones.
+  stripe& stripe_for(std::uint64_t h) const noexcept {
+    return stripes_[static_cast<size_type>(h >> 40) & stripe_mask_];
+  }
+  static std::uint8_t fragment(std::uint64_t h) noexcept {
+    return static_cast<std::uint8_t>(full_bit | (h & 0x7f));
+  }
+  static size_type home(std::uint64_t h, size_type capacity) noexcept {
+    return static_cast<size_type>(h >> 7) & (capacity - 1);
+  }
+
+  static size_type capacity_for(size_type count) noexcept {
+    size_type capacity = 8;
+    while (count * 2 > capacity) {
+      capacity <<= 1;
+    }
+    return capacity;
+  }
+
+  template <class K>
+  size_type find_in(const table& t, const K& key, std::uint64_t h) const {
+    if (t.capacity == 0) {
+      return not_found;
+    }
+    const std::uint8_t tag = fragment(h);
+    for (size_type i = home(h, t.capacity);; i = (i + 1) & (t.capacity - 1)) {
+      const std::uint8_t c = t.ctrl[i];
+      if (c == empty_slot) {
+        return not_found;
+      }
+      if (c == tag && equal_(key, t.value(i)->first)) {
+        return i;
+      }
+    }
+  }
+
+  // The table holding `key`, with its slot in `i`, or null.
+  template <class Stripe, class K>
+  auto locate(Stripe& s, const K& key, std::uint64_t h, size_type& i) const
+      -> decltype(&s.current) {
+    i = find_in(s.current, key, h);
+    if (i != not_found) {
+      return &s.current;
+    }
+    if (s.migrating()) {
+      i = find_in(s.old, key, h);
+      if (i != not_found) {
+        return &s.old;
+      }
+    }
+    return nullptr;
+  }
+
+  // The first empty or deleted slot on `h`'s probe sequence.
+  static size_type free_slot(const table& t, std::uint64_t h) noexcept {
+    size_type i = home(h, t.capacity);
+    while (t.ctrl[i] >= full_bit) {
+      i = (i + 1) & (t.capacity - 1);
+    }
+    return i;
+  }
+
+  // Moves up to `limit` of the old table's slots into the current one, and
+  // frees the old table once it is drained. If a hash or a copy throws,
+  // the element being moved stays where it was.
+  void migrate(stripe& s, size_type limit) {
+    for (; s.migrating() && limit != 0; --limit) {
+      const size_type i = s.migrated;
+      if (s.old.ctrl[i] >= full_bit) {
+        value_type& value = *s.old.value(i);
+        const std::uint64_t h = hash_of(value.first);
+        const size_type j = free_slot(s.current, h);
+        ::new (static_cast<void*>(&s.current.slots[j]))
+            value_type(std::move_if_noexcept(value));
+        value.~value_type();
+        s.old.ctrl[i] = deleted_slot;
+        if (s.current.ctrl[j] == deleted_slot) {
+          --s.tombstones;
+        }
+        s.current.ctrl[j] = fragment(h);
+      }
+      if (++s.migrated == s.old.capacity) {
+        s.old = table();
+        s.migrated = 0;
+      }
+    }
+  }
+
+  // Switches the stripe to an empty table of `capacity` slots, leaving its
+  // elements in the old one for migrate() to move.
+  void grow(stripe& s, size_type capacity) {
+    migrate(s, not_found);
+    table fresh;
+    fresh.ctrl.reset(new std::uint8_t[capacity]());
+    fresh.slots.reset(new storage[capacity]);
+    fresh.capacity = capacity;
+    table previous = std::move(s.current);
+    s.current = std::move(fresh);
+    s.tombstones = 0;
+    if (s.size != 0) {
+      s.old = std::move(previous);
+    }
+  }
+
+  template <class K, class Make, class OnExisting>
+  bool emplace_key(const K& key, Make make, OnExisting&& on_existing) {
+    const std::uint64_t h = hash_of(key);
+    stripe& s = stripe_for(h);
+    std::lock_guard<shared_mutex> lock(s.mutex);
+    migrate(s, migrate_step);
+    size_type found;
+    if (table* t = locate(s, key, h, found)) {
+      on_existing(*t->value(found));
+      return false;
+    }
+    if ((s.size + s.tombstones + 1) * 8 > s.current.capacity * 7) {
+      grow(s, s.current.capacity == 0 ? 8 : capacity_for(s.size + 1));
+    }
+    const size_type i = free_slot(s.current, h);
+    make(static_cast<void*>(&s.current.slots[i]));
+    if (s.current.ctrl[i] == deleted_slot) {
+      --s.tombstones;
+    }
+    s.current.ctrl[i] = fragment(h);
+    ++s.size;
+    return true;
+  }
+
+  template <class K, class F>
+  size_type visit_key(const K& key, F&& f) {
+    const std::uint64_t h = hash_of(key);
+    stripe& s = stripe_for(h);
+    std::lock_guard<shared_mutex> lock(s.mutex);
+    migrate(s, migrate_step);
+    size_type i;
+    table* t = locate(s, key, h, i);
+    if (t == nullptr) {
+      return 0;
+    }
+    f(*t->value(i));
+    return 1;
+  }
+
+  template <class K, class F>
+  size_type cvisit_key(const K& key, F&& f) const {
+    const std::uint64_t h = hash_of(key);
+    const stripe& s = stripe_for(h);
+    std::shared_lock<shared_mutex> lock(s.mutex);
+    size_type i;
+    const table* t = locate(s, key, h, i);
+    if (t == nullptr) {
+      return 0;
+    }
+    f(*t->value(i));
+    return 1;
+  }
+
+  template <class K, class Predicate>
+  size_type erase_key(const K& key, Predicate&& pred) {
+    const std::uint64_t h = hash_of(key);
+    stripe& s = stripe_for(h);
+    std::lock_guard<shared_mutex> lock(s.mutex);
+    migrate(s, migrate_step);
+    size_type i;
+    table* t = locate(s, key, h, i);
+    if (t == nullptr || !pred(static_cast<const value_type&>(*t->value(i)))) {
+      return 0;
+    }
+    erase_slot(s, *t, i);
+    return 1;
+  }
+
+  static void erase_slot(stripe& s, table& t, size_type i) noexcept {
+    t.value(i)->~value_type();
+    --s.size;
+    // A slot followed by an empty one ends no other key's probe sequence,
+    // so it can be emptied rather than left as a tombstone.
+    if (t.ctrl[(i + 1) & (t.capacity - 1)] == empty_slot) {
+      t.ctrl[i] = empty_slot;
+    } else {
+      t.ctrl[i] = deleted_slot;
+      if (&t == &s.current) {
+        ++s.tombstones;
+      }
+    }
+  }
+
+  template <class Stripe, class F>
+  static size_type for_each_in(Stripe& s, F& f) {
+    size_type visited = 0;
+    for (auto* t : {&s.current, &s.old}) {
+      for (size_type i = 0; i < t->capacity; ++i) {
+        if (t->ctrl[i] >= full_bit) {
+          f(*t->value(i));
+          ++visited;
+        }
+      }
+    }
+    return visited;
+  }
+
+  Hash hash_;
+  KeyEqual equal_;
+  size_type stripe_mask_;
+  std::unique_ptr<stripe[]> stripes_;
+};
+}  // namespace v1
+
+using v1::concurrent_unordered_map;
+using v1::string_equal;
+using v1::string_hash;
+}  // namespace stdcpp
+
+#endif  // __SCC_STDCPP_CONCURRENT_UNORDERED_MAP_HPP__
@@ -0,0 +1,196 @@
+#ifndef __SCC_STDCPP_CONDITION_VARIABLE_HPP__
+#define __SCC_STDCPP_CONDITION_VARIABLE_HPP__
+#pragma once
+
+#include <atomic.hpp>
+#include <stop_token.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <utility>
+
+namespace stdcpp {
+namespace v1 {
+namespace detail {
+// Releases a lock for the duration of a wait.
+template <class Lock>
+class unlock_guard {
+ public:
+  explicit unlock_guard(Lock& lock) : lock_(lock) { lock_.unlock(); }
+  ~unlock_guard() { lock_.lock(); }
+
+  unlock_guard(const unlock_guard&) = delete;
+  unlock_guard& operator=(const unlock_guard&) = delete;
+
+ private:
+  Lock& lock_;
+};
+}  // namespace detail
+
+// condition_variable_any with the C++20 stop_token waits, for C++14.
+//
+// Works with any BasicLockable, e.g. std::unique_lock or std::shared_lock
+// of a stdcpp::shared_mutex. The whole object is one 32-bit notification
+// counter: a waiter reads it under the caller's lock and atomic_wait()s for
+// it to change, notify_*() bumps it. A stop_token wait registers a
+// stop_callback that notifies, so request_stop() wakes the waiter at once.
+class condition_variable_any {
+ public:
+  condition_variable_any() = default;
+  ~condition_variable_any() = default;
+
+  condition_variable_any(const condition_variable_any&) = delete;
+  condition_variable_any& operator=(const condition_variable_any&) = delete;
+
+  void notify_one() noexcept {
+    seq_.fetch_add(1, std::memory_order_release);
+    v1::atomic_notify_one(&seq_);
+  }
+
+  void notify_all() noexcept {
+    seq_.fetch_add(1, std::memory_order_release);
+    v1::atomic_notify_all(&seq_);
+  }
+
+  template <class Lock>
+  void wait(Lock& lock) {
+    const std::uint32_t seq = seq_.load(std::memory_order_acquire);
+    detail::unlock_guard<Lock> unlocked(lock);
+    detail::atomic_wait_once(&seq_, seq, std::memory_order_relaxed);
+  }
+
+  template <class Lock, class Predicate>
+  void wait(Lock& lock, Predicate pred) {
+    while (!pred()) {
+      wait(lock);
+    }
+  }
+
+  template <class Lock, class Clock, class Duration>
+  std::cv_status wait_until(
+      Lock& lock, const std::chrono::time_point<Clock, Duration>& abs_time) {
+    const std::uint32_t seq = seq_.load(std::memory_order_acquire);
+    return wait_seq_until(lock, seq, abs_time);
+  }
+
+  template <class Lock, class Clock, class Duration, class Predicate>
+  bool wait_until(Lock& lock,
+                  const std::chrono::time_point<Clock, Duration>& abs_time,
+                  Predicate pred) {
+    while (!pred()) {
+      if (wait_until(lock, abs_time) == std::cv_status::timeout) {
+        return pred();
+      }
+    }
+    return true;
+  }
+
+  template <class Lock, class Rep, class Period>
+  std::cv_status wait_for(Lock& lock,
+                          const std::chrono::duration<Rep, Period>& rel_time) {
+    return wait_until(lock, std::chrono::steady_clock::now() + rel_time);
+  }
+
+  template <class Lock, class Rep, class Period, class Predicate>
+  bool wait_for(Lock& lock, const std::chrono::duration<Rep, Period>& rel_time,
+                Predicate pred) {
+    return wait_until(lock, std::chrono::steady_clock::now() + rel_time,
+                      std::move(pred));
+  }
+
+  // Interruptible waits: return pred(), which may be false if stop was
+  // requested first.
+  template <class Lock, class Predicate>
+  bool wait(Lock& lock, stop_token stoken, Predicate pred) {
+    if (stoken.stop_requested()) {
+      return pred();
+    }
+    stop_callback<notify_on_stop> on_stop(stoken, notify_on_stop{this});
+    while (!stoken.stop_requested()) {
+      if (pred()) {
+        return true;
+      }
+      // request_stop() sets the stop bit before its callback bumps the
+      // counter with release. If this acquire load sees the bump, the check
+      // below sees the stop; if not, the bump is still to come and ends the
+      // wait.
+      const std::uint32_t seq = seq_.load(std::memory_order_acquire);
+      if (stoken.stop_requested()) {
+        break;
+      }
+      detail::unlock_guard<Lock> unlocked(lock);
+      detail::atomic_wait_once(&seq_, seq, std::memory_order_relaxed);
+    }
+    return pred();
+  }
+
+  template <class Lock, class Clock, class Duration, class Predicate>
+  bool wait_until(Lock& lock, stop_token stoken,
+                  const std::chrono::time_point<Clock, Duration>& abs_time,
+                  Predicate pred) {
+    if (stoken.stop_requested()) {
+      return pred();
+    }
+    stop_callback<notify_on_stop> on_stop(stoken, notify_on_stop{this});
+    while (!stoken.stop_requested()) {
+      if (pred()) {
+        return true;
+      }
+      // As in wait() above.
+      const std::uint32_t seq = seq_.load(std::memory_order_acquire);
+      if (stoken.stop_requested()) {
+        break;
+      }
+      if (wait_seq_until(lock, seq, abs_time) == std::cv_status::timeout) {
+        break;
+      }
+    }
+    return pred();
+  }
+
+  template <class Lock, class Rep, class Period, class Predicate>
+  bool wait_for(Lock& lock, stop_token stoken,
+                const std::chrono::duration<Rep, Period>& rel_time,
+                Predicate pred) {
+    return wait_until(lock, std::move(stoken),
+                      std::chrono::steady_clock::now() + rel_time,
+                      std::move(pred));
+  }
+
+ private:
+  struct notify_on_stop {
+    condition_variable_any* cv;
+    void operator()() noexcept { cv->notify_all(); }
+  };
+
+  // Waits for the counter to move on from `seq`, which was read under
+  // `lock`.
+  template <class Lock, class Clock, class Duration>
+  std::cv_status wait_seq_until(
+      Lock& lock, std::uint32_t seq,
+      const std::chrono::time_point<Clock, Duration>& abs_time) {
+    const auto remaining = abs_time - Clock::now();
+    if (remaining <= Clock::duration::zero()) {
+      return std::cv_status::timeout;
+    }
+    {
+      detail::unlock_guard<Lock> unlocked(lock);
+      detail::atomic_wait_for(
+          &seq_, seq, std::memory_order_relaxed,
+          std::chrono::duration_cast<std::chrono::nanoseconds>(remaining) +
+              std::chrono::nanoseconds(1));
+    }
+    return Clock::now() < abs_time ? std::cv_status::no_timeout
+                                   : std::cv_status::timeout;
+  }
+
+  std::atomic<std::uint32_t> seq_{0};
+};
+}  // namespace v1
+
+using v1::condition_variable_any;
+}  // namespace stdcpp
+
+#endif  // __SCC_STDCPP_CONDITION_VARIABLE_HPP__
@@ -0,0 +1,66 @@
+#ifndef __SCC_STDCPP_DETAIL_CPU_HPP__
+#define __SCC_STDCPP_DETAIL_CPU_HPP__
+#pragma once
+
+#include <cstddef>
+#include <thread>
+
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <intrin.h>
+#endif
+
+namespace stdcpp {
+namespace v1 {
+namespace detail {
+// std::hardware_destructive_interference_size is C++17 and is not reliably
+// provided even then, so hard-code the common value.
+constexpr std::size_t cache_line_size = 64;
+
+// Hint to the CPU that we are in a spin-wait loop.
+inline void cpu_relax() noexcept {
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+  _mm_pause();
+#elif defined(__i386__) || defined(__x86_64__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+  __asm__ __volatile__("yield");
+#else
+  std::this_thread::yield();
+#endif
+}
+
+// Spinning only pays off if the thread we wait for can run meanwhile.
+inline bool is_multiprocessor() noexcept {
+  static const bool multi = std::thread::hardware_concurrency() != 1;
+  return multi;
+}
+
+// Exponential backoff for spin loops: each pause() doubles the number of
+// cpu_relax() rounds, capped at `max_rounds`, and reports how many it spent.
+class backoff {
+ public:
+  explicit backoff(unsigned max_rounds = 64) noexcept
+      : max_rounds_(max_rounds) {}
+
+  unsigned pause() noexcept {
+    const unsigned rounds = rounds_;
+    for (unsigned i = 0; i < rounds; ++i) {
+      cpu_relax();
+    }
+    if (rounds_ < max_rounds_) {
+      rounds_ <<= 1;
+    }
+    return rounds;
+  }
+
+  void reset() noexcept { rounds_ = 1; }
+
+ private:
+  unsigned rounds_ = 1;
+  unsigned max_rounds_;
+};
+}  // namespace detail
+}  // namespace v1
+}  // namespace stdcpp
+
+#endif  // __SCC_STDCPP_DETAIL_CPU_HPP__
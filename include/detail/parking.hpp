@@ -0,0 +1,139 @@
+#ifndef __SCC_STDCPP_DETAIL_PARKING_HPP__
+#define __SCC_STDCPP_DETAIL_PARKING_HPP__
+#pragma once
+
+#include <detail/cpu.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <climits>
+#include <ctime>
+#endif
+
+// Address-based parking for 32-bit atomics: park_wait() blocks while the
+// value still equals `expected`, unpark_*() wake threads parked on the same
+// address. Callers must re-check their condition, since wakeups may be
+// spurious.
+//
+// Linux parks directly on a futex. Elsewhere parked threads share a small
+// hashed table of mutex/condition_variable pairs; notifiers take the slot
+// mutex so a waiter cannot miss a store made before the notify.
+
+namespace stdcpp {
+namespace v1 {
+namespace detail {
+static_assert(sizeof(std::atomic<std::int32_t>) == sizeof(std::int32_t),
+              "parking requires lock-free 32-bit atomics");
+
+struct alignas(cache_line_size) parking_slot {
+  std::mutex mtx;
+  std::condition_variable cv;
+};
+
+inline parking_slot& parking_slot_for(const void* addr) noexcept {
+  static parking_slot table[64];
+  auto key = reinterpret_cast<std::uintptr_t>(addr);
+  key ^= key >> 6;
+  key ^= key >> 12;
+  return table[key & 63];
+}
+
+// Spins with exponential backoff for up to `budget` cpu_relax() rounds until
+// `done()` returns true. Returns false straight away on a single CPU, where
+// the thread being waited for cannot make progress while we spin.
+template <class Done>
+bool spin_until(Done done, unsigned budget) {
+  if (!is_multiprocessor()) {
+    return false;
+  }
+  backoff backoff;
+  for (unsigned spent = 0; spent < budget; spent += backoff.pause()) {
+    if (done()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+#if defined(__linux__)
+inline int futex(const std::atomic<std::int32_t>* addr, int op,
+                 std::int32_t value, const struct timespec* timeout) noexcept {
+  return static_cast<int>(syscall(SYS_futex, addr, op, value, timeout,
+                                  nullptr, 0));
+}
+
+inline void park_wait(const std::atomic<std::int32_t>* addr,
+                      std::int32_t expected) noexcept {
+  futex(addr, FUTEX_WAIT_PRIVATE, expected, nullptr);
+}
+
+inline void park_wait_for(const std::atomic<std::int32_t>* addr,
+                          std::int32_t expected,
+                          std::chrono::nanoseconds rel) noexcept {
+  if (rel <= std::chrono::nanoseconds::zero()) {
+    return;
+  }
+  const auto secs = std::chrono::duration_cast<std::chrono::seconds>(rel);
+  struct timespec ts;
+  ts.tv_sec = static_cast<std::time_t>(secs.count());
+  ts.tv_nsec = static_cast<long>((rel - secs).count());
+  futex(addr, FUTEX_WAIT_PRIVATE, expected, &ts);
+}
+
+inline void unpark_one(const std::atomic<std::int32_t>* addr) noexcept {
+  futex(addr, FUTEX_WAKE_PRIVATE, 1, nullptr);
+}
+
+inline void unpark_all(const std::atomic<std::int32_t>* addr) noexcept {
+  futex(addr, FUTEX_WAKE_PRIVATE, INT_MAX, nullptr);
+}
+#else
+inline void park_wait(const std::atomic<std::int32_t>* addr,
+                      std::int32_t expected) {
+  auto& slot = parking_slot_for(addr);
+  std::unique_lock<std::mutex> lk(slot.mtx);
+  if (addr->load(std::memory_order_relaxed) == expected) {
+    slot.cv.wait(lk);
+  }
+}
+
+inline void park_wait_for(const std::atomic<std::int32_t>* addr,
+                          std::int32_t expected,
+                          std::chrono::nanoseconds rel) {
+  if (rel <= std::chrono::nanoseconds::zero()) {
+    return;
+  }
+  auto& slot = parking_slot_for(addr);
+  std::unique_lock<std::mutex> lk(slot.mtx);
+  if (addr->load(std::memory_order_relaxed) == expected) {
+    slot.cv.wait_for(lk, rel);
+  }
+}
+
+// Slots are shared between addresses, so every waiter on the slot is woken.
+inline void unpark_all(const std::atomic<std::int32_t>* addr) {
+  auto& slot = parking_slot_for(addr);
+  {
+    std::lock_guard<std::mutex> lk(slot.mtx);
+  }
+  slot.cv.notify_all();
+}
+
+inline void unpark_one(const std::atomic<std::int32_t>* addr) {
+  unpark_all(addr);
+}
+#endif
+}  // namespace detail
+}  // namespace v1
+}  // namespace stdcpp
+
+#endif  // __SCC_STDCPP_DETAIL_PARKING_HPP__
@@ -0,0 +1,394 @@
+#ifndef __SCC_STDCPP_DETAIL_SIMD_HPP__
+#define __SCC_STDCPP_DETAIL_SIMD_HPP__
+#pragma once
+
+#include <iterator.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+namespace stdcpp {
+namespace v1 {
+namespace detail {
+// Kernels over arrays of integers, float and double for the contiguous
+// cases of ranges::reduce, dot, count, find and minmax.
+//
+// With GCC and Clang they use the generic vector extensions, a vector
+// register at a time, which the compiler lowers to AVX, SSE or NEON, and
+// keep several vectors of accumulators in flight so that additions do not
+// wait on one another. Elsewhere they are plain loops with several
+// scalar accumulators. Integer sums and products are computed in unsigned
+// lanes, so that they wrap instead of overflowing; callers only sum
+// floating point in lanes when the caller opted into reordering.
+template <std::size_t Size, bool Signed>
+struct sized_integer;
+
+template <>
+struct sized_integer<1, true> {
+  using type = std::int8_t;
+};
+template <>
+struct sized_integer<1, false> {
+  using type = std::uint8_t;
+};
+template <>
+struct sized_integer<2, true> {
+  using type = std::int16_t;
+};
+template <>
+struct sized_integer<2, false> {
+  using type = std::uint16_t;
+};
+template <>
+struct sized_integer<4, true> {
+  using type = std::int32_t;
+};
+template <>
+struct sized_integer<4, false> {
+  using type = std::uint32_t;
+};
+template <>
+struct sized_integer<8, true> {
+  using type = std::int64_t;
+};
+template <>
+struct sized_integer<8, false> {
+  using type = std::uint64_t;
+};
+
+// The lane type that holds a T in the kernels, and the one it is summed in.
+// Only cv-unqualified types have lanes.
+template <class T, class = void>
+struct simd_lane {};
+
+template <class T>
+using is_plain_integer = std::integral_constant<
+    bool, std::is_integral<T>::value && !std::is_same<T, bool>::value &&
+              std::is_same<T, std::remove_cv_t<T>>::value>;
+
+template <class T>
+struct simd_lane<T, std::enable_if_t<is_plain_integer<T>::value>> {
+  using type =
+      typename sized_integer<sizeof(T), std::is_signed<T>::value>::type;
+  using sum_type = typename sized_integer<sizeof(T), false>::type;
+};
+
+template <>
+struct simd_lane<float> {
+  using type = float;
+  using sum_type = float;
+};
+
+template <>
+struct simd_lane<double> {
+  using type = double;
+  using sum_type = double;
+};
+
+template <class T>
+using simd_lane_t = typename simd_lane<T>::type;
+
+template <class T>
+using simd_sum_t = typename simd_lane<T>::sum_type;
+
+template <class T, class = void>
+struct is_simd_type : std::false_type {};
+
+template <class T>
+struct is_simd_type<T, void_t<simd_lane_t<T>>> : std::true_type {};
+
+// Whether searching T elements for a U value can compare them against the
+// value converted to T. Integer elements need an integer value: x == 2.5
+// converts x, not the value, and x == 1e10f rounds x.
+template <class T, class U>
+using is_simd_needle = std::integral_constant<
+    bool, is_simd_type<T>::value && std::is_arithmetic<U>::value &&
+              (std::is_floating_point<T>::value || std::is_integral<U>::value)>;
+
+// True if `value` survives the round trip through T, in which case
+// x == value holds exactly for the elements x equal to T(value).
+template <class T, class U>
+bool simd_needle_fits(const U& value) {
+  return static_cast<U>(static_cast<T>(value)) == value;
+}
+
+#if defined(__GNUC__)
+// The widest vector registers the target is compiled for; AVX ones cannot
+// be passed between functions otherwise.
+#if defined(__AVX__)
+enum : std::size_t { simd_width = 32 };
+#else
+enum : std::size_t { simd_width = 16 };
+#endif
+
+template <class L>
+struct simd_vector {
+  typedef L type __attribute__((vector_size(simd_width)));
+};
+
+template <class L>
+using simd_vector_t = typename simd_vector<L>::type;
+
+// The type of v == w: signed lanes as wide as L, all ones where equal.
+template <class L>
+using simd_mask_t =
+    decltype(std::declval<simd_vector_t<L>>() == simd_vector_t<L>());
+
+template <class To, class From>
+To simd_cast(const From& from) {
+  static_assert(sizeof(To) == sizeof(From), "");
+  To to;
+  std::memcpy(&to, &from, sizeof to);
+  return to;
+}
+
+template <class L, class T>
+simd_vector_t<L> simd_load(const T* p) {
+  simd_vector_t<L> v;
+  std::memcpy(&v, p, sizeof v);
+  return v;
+}
+
+template <class L>
+simd_vector_t<L> simd_splat(L x) {
+  return simd_vector_t<L>{} + x;
+}
+
+template <class L>
+bool simd_any(const simd_mask_t<L>& mask) {
+  std::uint64_t words[simd_width / 8];
+  std::memcpy(words, &mask, sizeof words);
+  std::uint64_t any = 0;
+  for (std::uint64_t word : words) {
+    any |= word;
+  }
+  return any != 0;
+}
+
+// a where mask is set, b elsewhere.
+template <class L>
+simd_vector_t<L> simd_select(const simd_mask_t<L>& mask,
+                             const simd_vector_t<L>& a,
+                             const simd_vector_t<L>& b) {
+  using M = simd_mask_t<L>;
+  return simd_cast<simd_vector_t<L>>((simd_cast<M>(a) & mask) |
+                                     (simd_cast<M>(b) & ~mask));
+}
+
+// The sum of p[0, n) in L lanes, in no particular order.
+template <class L, class T>
+L simd_sum(const T* p, std::size_t n) {
+  using V = simd_vector_t<L>;
+  const std::size_t lanes = sizeof(V) / sizeof(L);
+  V a0{}, a1{}, a2{}, a3{};
+  std::size_t i = 0;
+  for (; i + 4 * lanes <= n; i += 4 * lanes) {
+    a0 += simd_load<L>(p + i);
+    a1 += simd_load<L>(p + i + lanes);
+    a2 += simd_load<L>(p + i + 2 * lanes);
+    a3 += simd_load<L>(p + i + 3 * lanes);
+  }
+  for (; i + lanes <= n; i += lanes) {
+    a0 += simd_load<L>(p + i);
+  }
+  a0 = (a0 + a1) + (a2 + a3);
+  L sum = 0;
+  for (std::size_t k = 0; k < lanes; ++k) {
+    sum += a0[k];
+  }
+  for (; i < n; ++i) {
+    sum += static_cast<L>(p[i]);
+  }
+  return sum;
+}
+
+// The sum of a[i] * b[i] over [0, n) in L lanes, in no particular order.
+template <class L, class T>
+L simd_dot(const T* a, const T* b, std::size_t n) {
+  using V = simd_vector_t<L>;
+  const std::size_t lanes = sizeof(V) / sizeof(L);
+  V a0{}, a1{}, a2{}, a3{};
+  std::size_t i = 0;
+  for (; i + 4 * lanes <= n; i += 4 * lanes) {
+    a0 += simd_load<L>(a + i) * simd_load<L>(b + i);
+    a1 += simd_load<L>(a + i + lanes) * simd_load<L>(b + i + lanes);
+    a2 += simd_load<L>(a + i + 2 * lanes) * simd_load<L>(b + i + 2 * lanes);
+    a3 += simd_load<L>(a + i + 3 * lanes) * simd_load<L>(b + i + 3 * lanes);
+  }
+  for (; i + lanes <= n; i += lanes) {
+    a0 += simd_load<L>(a + i) * simd_load<L>(b + i);
+  }
+  a0 = (a0 + a1) + (a2 + a3);
+  L sum = 0;
+  for (std::size_t k = 0; k < lanes; ++k) {
+    sum += a0[k];
+  }
+  for (; i < n; ++i) {
+    sum += static_cast<L>(a[i]) * static_cast<L>(b[i]);
+  }
+  return sum;
+}
+
+// How many of p[0, n) equal value.
+template <class L, class T>
+std::size_t simd_count(const T* p, std::size_t n, L value) {
+  using M = simd_mask_t<L>;
+  using count_lane = std::remove_reference_t<decltype(std::declval<M&>()[0])>;
+  const std::size_t lanes = simd_width / sizeof(L);
+  // Matches subtract -1 from a lane, four per round; empty the lanes
+  // before they can overflow.
+  const std::size_t rounds =
+      std::min<std::size_t>(std::numeric_limits<count_lane>::max() / 4, 4096);
+  const auto needle = simd_splat(value);
+  std::size_t count = 0;
+  std::size_t i = 0;
+  while (i + 4 * lanes <= n) {
+    M counts{};
+    for (std::size_t r = 0; r < rounds && i + 4 * lanes <= n;
+         ++r, i += 4 * lanes) {
+      counts -= simd_load<L>(p + i) == needle;
+      counts -= simd_load<L>(p + i + lanes) == needle;
+      counts -= simd_load<L>(p + i + 2 * lanes) == needle;
+      counts -= simd_load<L>(p + i + 3 * lanes) == needle;
+    }
+    for (std::size_t k = 0; k < lanes; ++k) {
+      count += static_cast<std::size_t>(counts[k]);
+    }
+  }
+  for (; i < n; ++i) {
+    count += static_cast<L>(p[i]) == value;
+  }
+  return count;
+}
+
+// The first of p[0, n) that equals value, or p + n.
+template <class L, class T>
+const T* simd_find(const T* p, std::size_t n, L value) {
+  const std::size_t lanes = simd_width / sizeof(L);
+  const auto needle = simd_splat(value);
+  std::size_t i = 0;
+  for (; i + 4 * lanes <= n; i += 4 * lanes) {
+    if (simd_any<L>((simd_load<L>(p + i) == needle) |
+                    (simd_load<L>(p + i + lanes) == needle) |
+                    (simd_load<L>(p + i + 2 * lanes) == needle) |
+                    (simd_load<L>(p + i + 3 * lanes) == needle))) {
+      break;
+    }
+  }
+  for (; i < n; ++i) {
+    if (static_cast<L>(p[i]) == value) {
+      return p + i;
+    }
+  }
+  return p + n;
+}
+
+// The least and greatest of p[0, n), n > 0. Of equal floating-point
+// values, such as -0.0 and 0.0, either may be returned.
+template <class L, class T>
+void simd_minmax(const T* p, std::size_t n, L& lo, L& hi) {
+  using V = simd_vector_t<L>;
+  const std::size_t lanes = sizeof(V) / sizeof(L);
+  std::size_t i = 0;
+  if (n >= 2 * lanes) {
+    V lo0 = simd_load<L>(p);
+    V lo1 = simd_load<L>(p + lanes);
+    V hi0 = lo0;
+    V hi1 = lo1;
+    for (i = 2 * lanes; i + 2 * lanes <= n; i += 2 * lanes) {
+      const V v0 = simd_load<L>(p + i);
+      const V v1 = simd_load<L>(p + i + lanes);
+      lo0 = simd_select<L>(v0 < lo0, v0, lo0);
+      lo1 = simd_select<L>(v1 < lo1, v1, lo1);
+      hi0 = simd_select<L>(hi0 < v0, v0, hi0);
+      hi1 = simd_select<L>(hi1 < v1, v1, hi1);
+    }
+    lo0 = simd_select<L>(lo1 < lo0, lo1, lo0);
+    hi0 = simd_select<L>(hi0 < hi1, hi1, hi0);
+    lo = lo0[0];
+    hi = hi0[0];
+    for (std::size_t k = 1; k < lanes; ++k) {
+      lo = lo0[k] < lo ? lo0[k] : lo;
+      hi = hi < hi0[k] ? hi0[k] : hi;
+    }
+  } else {
+    lo = hi = static_cast<L>(p[0]);
+    i = 1;
+  }
+  for (; i < n; ++i) {
+    const L x = static_cast<L>(p[i]);
+    lo = x < lo ? x : lo;
+    hi = hi < x ? x : hi;
+  }
+}
+#else
+template <class L, class T>
+L simd_sum(const T* p, std::size_t n) {
+  L a0 = 0, a1 = 0, a2 = 0, a3 = 0;
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    a0 += static_cast<L>(p[i]);
+    a1 += static_cast<L>(p[i + 1]);
+    a2 += static_cast<L>(p[i + 2]);
+    a3 += static_cast<L>(p[i + 3]);
+  }
+  for (; i < n; ++i) {
+    a0 += static_cast<L>(p[i]);
+  }
+  return (a0 + a1) + (a2 + a3);
+}
+
+template <class L, class T>
+L simd_dot(const T* a, const T* b, std::size_t n) {
+  L a0 = 0, a1 = 0, a2 = 0, a3 = 0;
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    a0 += static_cast<L>(a[i]) * static_cast<L>(b[i]);
+    a1 += static_cast<L>(a[i + 1]) * static_cast<L>(b[i + 1]);
+    a2 += static_cast<L>(a[i + 2]) * static_cast<L>(b[i + 2]);
+    a3 += static_cast<L>(a[i + 3]) * static_cast<L>(b[i + 3]);
+  }
+  for (; i < n; ++i) {
+    a0 += static_cast<L>(a[i]) * static_cast<L>(b[i]);
+  }
+  return (a0 + a1) + (a2 + a3);
+}
+
+template <class L, class T>
+std::size_t simd_count(const T* p, std::size_t n, L value) {
+  std::size_t count = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    count += static_cast<L>(p[i]) == value;
+  }
+  return count;
+}
+
+template <class L, class T>
+const T* simd_find(const T* p, std::size_t n, L value) {
+  for (std::size_t i = 0; i < n; ++i) {
+    if (static_cast<L>(p[i]) == value) {
+      return p + i;
+    }
+  }
+  return p + n;
+}
+
+template <class L, class T>
+void simd_minmax(const T* p, std::size_t n, L& lo, L& hi) {
+  lo = hi = static_cast<L>(p[0]);
+  for (std::size_t i = 1; i < n; ++i) {
+    const L x = static_cast<L>(p[i]);
+    lo = x < lo ? x : lo;
+    hi = hi < x ? x : hi;
+  }
+}
+#endif
+}  // namespace detail
+}  // namespace v1
+}  // namespace stdcpp
+
+#endif  // __SCC_STDCPP_DETAIL_SIMD_HPP__
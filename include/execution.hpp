@@ -0,0 +1,178 @@
+#ifndef __SCC_STDCPP_EXECUTION_HPP__
+#define __SCC_STDCPP_EXECUTION_HPP__
+#pragma once
+
+#include <thread_pool.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+
+namespace stdcpp {
+namespace v1 {
+// Execution policies for the parallel overloads in algorithm.hpp and
+// numeric.hpp, as in C++17's <execution>.
+//
+// seq runs on the calling thread. par and par_unseq split the input into
+// chunks that run on a thread_pool, the calling thread included; both may
+// call the element functions concurrently. Parallel overloads fall back to
+// seq for iterators that are not random access.
+//
+// unseq and par_unseq also let the algorithms reorder the operations on
+// elements within a thread: the SIMD kernels behind ranges::reduce and dot
+// only sum floating-point values out of order under one of them.
+//
+// By default the chunks run on default_pool(), one worker per hardware
+// thread. par.on(pool) runs them on `pool` instead, and
+// par.with_grain(n) hands out no fewer than n elements at a time, for
+// element functions too cheap or too expensive for the default estimate.
+namespace execution {
+// The pool for parallel policies that name none, started on first use.
+inline thread_pool& default_pool() {
+  static thread_pool pool;
+  return pool;
+}
+
+class sequenced_policy {};
+
+class unsequenced_policy {};
+
+namespace detail {
+template <class Derived>
+class pool_policy {
+ public:
+  Derived on(thread_pool& pool) const {
+    Derived policy = static_cast<const Derived&>(*this);
+    static_cast<pool_policy&>(policy).pool_ = &pool;
+    return policy;
+  }
+
+  Derived with_grain(std::size_t grain) const {
+    Derived policy = static_cast<const Derived&>(*this);
+    static_cast<pool_policy&>(policy).grain_ = grain;
+    return policy;
+  }
+
+  thread_pool& pool() const { return pool_ ? *pool_ : default_pool(); }
+  std::size_t grain() const noexcept { return grain_; }
+
+ private:
+  thread_pool* pool_ = nullptr;
+  std::size_t grain_ = 0;
+};
+}  // namespace detail
+
+class parallel_policy : public detail::pool_policy<parallel_policy> {};
+
+class parallel_unsequenced_policy
+    : public detail::pool_policy<parallel_unsequenced_policy> {};
+
+constexpr sequenced_policy seq{};
+constexpr unsequenced_policy unseq{};
+constexpr parallel_policy par{};
+constexpr parallel_unsequenced_policy par_unseq{};
+}  // namespace execution
+
+template <class T>
+struct is_execution_policy : std::false_type {};
+
+template <>
+struct is_execution_policy<execution::sequenced_policy> : std::true_type {};
+
+template <>
+struct is_execution_policy<execution::unsequenced_policy> : std::true_type {};
+
+template <>
+struct is_execution_policy<execution::parallel_policy> : std::true_type {};
+
+template <>
+struct is_execution_policy<execution::parallel_unsequenced_policy>
+    : std::true_type {};
+
+namespace detail {
+template <class P>
+using is_policy = is_execution_policy<std::decay_t<P>>;
+
+template <class P>
+using is_parallel_policy = std::integral_constant<
+    bool,
+    std::is_same<std::decay_t<P>, execution::parallel_policy>::value ||
+        std::is_same<std::decay_t<P>,
+                     execution::parallel_unsequenced_policy>::value>;
+
+template <class P>
+using is_unsequenced_policy = std::integral_constant<
+    bool,
+    std::is_same<std::decay_t<P>, execution::unsequenced_policy>::value ||
+        std::is_same<std::decay_t<P>,
+                     execution::parallel_unsequenced_policy>::value>;
+
+// Whether a call with policy P over iterators I runs in parallel.
+template <class P, class I>
+using runs_parallel = std::integral_constant<
+    bool, is_parallel_policy<P>::value &&
+              std::is_base_of<std::random_access_iterator_tag,
+                              typename std::iterator_traits<
+                                  I>::iterator_category>::value>;
+
+// [0, n) cut into count() chunks of grain elements, the last one shorter.
+class chunk_plan {
+ public:
+  chunk_plan(std::size_t n, std::size_t grain) noexcept
+      : n_(n), grain_(std::max<std::size_t>(grain, 1)) {}
+
+  std::size_t size() const noexcept { return n_; }
+  std::size_t count() const noexcept { return (n_ + grain_ - 1) / grain_; }
+  std::size_t begin(std::size_t chunk) const noexcept {
+    return chunk * grain_;
+  }
+  std::size_t end(std::size_t chunk) const noexcept {
+    return std::min(n_, (chunk + 1) * grain_);
+  }
+
+ private:
+  std::size_t n_;
+  std::size_t grain_;
+};
+
+// Chunks for n elements: a few per worker, so that stealing evens out
+// uneven chunks, but never smaller than `min_grain`, below which a chunk
+// costs more to hand out than to run, nor than the policy's grain.
+template <class Policy>
+chunk_plan plan_chunks(const Policy& policy, std::size_t n,
+                       std::size_t min_grain) {
+  const std::size_t target = policy.pool().size() * 4;
+  const std::size_t even = (n + target - 1) / target;
+  return chunk_plan(n, std::max({even, min_grain, policy.grain()}));
+}
+
+// Calls body(chunk) for every chunk of `plan` on the policy's pool, the
+// calling thread included, or inline if there is only one.
+template <class Policy, class Body>
+void run_chunks(const Policy& policy, const chunk_plan& plan, Body&& body) {
+  const std::size_t count = plan.count();
+  if (count <= 1) {
+    for (std::size_t chunk = 0; chunk < count; ++chunk) {
+      body(chunk);
+    }
+    return;
+  }
+  policy.pool().bulk(count, body);
+}
+
+// Default minimum grains, in elements, for an element function of a few
+// instructions, for sorting, and for the SIMD kernels, which go through
+// several elements per instruction.
+enum : std::size_t {
+  element_grain = 4096,
+  sort_grain = 16384,
+  simd_grain = 65536
+};
+}  // namespace detail
+}  // namespace v1
+
+using v1::is_execution_policy;
+namespace execution = v1::execution;
+}  // namespace stdcpp
+
+#endif  // __SCC_STDCPP_EXECUTION_HPP__
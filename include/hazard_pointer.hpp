@@ -0,0 +1,350 @@
+#ifndef __SCC_STDCPP_HAZARD_POINTER_HPP__
+#define __SCC_STDCPP_HAZARD_POINTER_HPP__
+#pragma once
+
+#include <detail/cpu.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+// C++26 hazard pointers for C++14: hazard_pointer, hazard_pointer_obj_base
+// and make_hazard_pointer.
+//
+// A reader publishes the address it is about to dereference in a hazard
+// record; a writer that unlinks an object retire()s it instead of deleting
+// it. Retired objects are kept on an intrusive per-thread list and
+// reclaimed in batches: once a thread has retired max(64, 2 * records)
+// objects it snapshots every published hazard and deletes the retired
+// objects not among them. Each scan frees at least half the batch, so the
+// cost per retire() is constant and a thread never holds more than one
+// batch of garbage. Objects still protected when their thread exits are
+// handed to whichever thread scans next.
+//
+// Readers never block and never write shared state other than their own
+// record, which makes this the counterpart of shared_mutex for structures
+// whose readers must not wait for writers.
+
+namespace stdcpp {
+namespace v1 {
+namespace detail {
+struct hazard_record {
+  std::atomic<const void*> hazard{nullptr};
+  // Owned by a hazard_pointer or a thread's cache.
+  std::atomic<bool> active{true};
+  // Immutable once the record is published.
+  hazard_record* next = nullptr;
+  // Records are written by their owners and read by every scan.
+  char pad[cache_line_size];
+};
+
+// The intrusive part of a retired object.
+struct hazard_retired {
+  using reclaim_fn = void (*)(hazard_retired*);
+
+  hazard_retired* next_retired = nullptr;
+  // The address readers protect, i.e. the T* rather than this base.
+  const void* object = nullptr;
+  reclaim_fn reclaim = nullptr;
+};
+
+class hazard_domain;
+
+class hazard_thread {
+ public:
+  enum : std::size_t { cache_size = 8 };
+
+  ~hazard_thread();
+
+  hazard_record* cache[cache_size];
+  std::size_t cached = 0;
+  hazard_retired* retired = nullptr;
+  std::size_t retired_count = 0;
+  bool scanning = false;
+  // Reused between scans.
+  std::vector<const void*> hazards;
+};
+
+inline hazard_thread& this_hazard_thread() noexcept {
+  static thread_local hazard_thread thread;
+  return thread;
+}
+
+class hazard_domain {
+ public:
+  // Never destroyed, so retire() keeps working from static destructors.
+  static hazard_domain& instance() {
+    static hazard_domain* const domain = new hazard_domain;
+    return *domain;
+  }
+
+  hazard_record* acquire() {
+    hazard_thread& thread = this_hazard_thread();
+    if (thread.cached != 0) {
+      return thread.cache[--thread.cached];
+    }
+    for (hazard_record* r = records_.load(std::memory_order_acquire);
+         r != nullptr; r = r->next) {
+      bool active = false;
+      if (!r->active.load(std::memory_order_relaxed) &&
+          r->active.compare_exchange_strong(active, true,
+                                            std::memory_order_acquire,
+                                            std::memory_order_relaxed)) {
+        return r;
+      }
+    }
+    hazard_record* r = new hazard_record;
+    hazard_record* head = records_.load(std::memory_order_relaxed);
+    do {
+      r->next = head;
+    } while (!records_.compare_exchange_weak(head, r,
+                                             std::memory_order_release,
+                                             std::memory_order_relaxed));
+    record_count_.fetch_add(1, std::memory_order_relaxed);
+    return r;
+  }
+
+  void release(hazard_record* r) noexcept {
+    r->hazard.store(nullptr, std::memory_order_release);
+    hazard_thread& thread = this_hazard_thread();
+    if (thread.cached != hazard_thread::cache_size) {
+      thread.cache[thread.cached++] = r;
+    } else {
+      r->active.store(false, std::memory_order_release);
+    }
+  }
+
+  void retire(hazard_retired* node) noexcept {
+    hazard_thread& thread = this_hazard_thread();
+    node->next_retired = thread.retired;
+    thread.retired = node;
+    if (++thread.retired_count >= threshold() && !thread.scanning) {
+      scan(thread);
+    }
+  }
+
+  // Reclaims what it can of the thread's retired objects and of the
+  // orphans left by exited threads. Survivors stay with `thread`.
+  void scan(hazard_thread& thread) noexcept {
+    thread.scanning = true;
+    hazard_retired* list = thread.retired;
+    thread.retired = nullptr;
+    thread.retired_count = 0;
+    if (orphans_.load(std::memory_order_relaxed) != nullptr) {
+      hazard_retired* orphan =
+          orphans_.exchange(nullptr, std::memory_order_acquire);
+      while (orphan != nullptr) {
+        hazard_retired* next = orphan->next_retired;
+        orphan->next_retired = list;
+        list = orphan;
+        orphan = next;
+      }
+    }
+    // Pairs with the fence in hazard_pointer::try_protect(): a reader
+    // either published its hazard before this point, or it will see the
+    // pointer already unlinked and retry.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::vector<const void*>& hazards = thread.hazards;
+    hazards.clear();
+    try {
+      hazards.reserve(record_count_.load(std::memory_order_relaxed));
+      for (hazard_record* r = records_.load(std::memory_order_acquire);
+           r != nullptr; r = r->next) {
+        if (const void* p = r->hazard.load(std::memory_order_acquire)) {
+          hazards.push_back(p);
+        }
+      }
+    } catch (...) {
+      // Out of memory: keep everything for the next scan.
+      thread.retired = list;
+      thread.retired_count = count(list);
+      thread.scanning = false;
+      return;
+    }
+    std::sort(hazards.begin(), hazards.end());
+    // Deleters may retire more objects; those go onto thread.retired.
+    while (list != nullptr) {
+      hazard_retired* node = list;
+      list = list->next_retired;
+      if (std::binary_search(hazards.begin(), hazards.end(), node->object)) {
+        node->next_retired = thread.retired;
+        thread.retired = node;
+        ++thread.retired_count;
+      } else {
+        node->reclaim(node);
+      }
+    }
+    thread.scanning = false;
+  }
+
+  // Hands objects that are still protected to the other threads.
+  void orphan(hazard_retired* list) noexcept {
+    if (list == nullptr) {
+      return;
+    }
+    hazard_retired* tail = list;
+    while (tail->next_retired != nullptr) {
+      tail = tail->next_retired;
+    }
+    hazard_retired* head = orphans_.load(std::memory_order_relaxed);
+    do {
+      tail->next_retired = head;
+    } while (!orphans_.compare_exchange_weak(head, list,
+                                             std::memory_order_release,
+                                             std::memory_order_relaxed));
+  }
+
+ private:
+  hazard_domain() = default;
+
+  std::size_t threshold() const noexcept {
+    return std::max<std::size_t>(
+        64, 2 * record_count_.load(std::memory_order_relaxed));
+  }
+
+  static std::size_t count(const hazard_retired* list) noexcept {
+    std::size_t n = 0;
+    for (; list != nullptr; list = list->next_retired) {
+      ++n;
+    }
+    return n;
+  }
+
+  std::atomic<hazard_record*> records_{nullptr};
+  std::atomic<std::size_t> record_count_{0};
+  std::atomic<hazard_retired*> orphans_{nullptr};
+};
+
+inline hazard_thread::~hazard_thread() {
+  hazard_domain& domain = hazard_domain::instance();
+  while (cached != 0) {
+    cache[--cached]->active.store(false, std::memory_order_release);
+  }
+  if (retired != nullptr) {
+    domain.scan(*this);
+  }
+  domain.orphan(retired);
+  retired = nullptr;
+}
+}  // namespace detail
+
+// Base class for objects protected by hazard pointers: T derives from
+// hazard_pointer_obj_base<T, D> and is retire()d instead of deleted.
+template <class T, class D = std::default_delete<T>>
+class hazard_pointer_obj_base {
+ public:
+  // Deletes this object with `d` once no hazard pointer protects it. Must
+  // be called at most once, after the object is unreachable for new
+  // readers.
+  void retire(D d = D()) noexcept {
+    deleter_ = std::move(d);
+    retired_.object = static_cast<T*>(this);
+    retired_.reclaim = &reclaim_object;
+    detail::hazard_domain::instance().retire(&retired_);
+  }
+
+ protected:
+  hazard_pointer_obj_base() = default;
+  hazard_pointer_obj_base(const hazard_pointer_obj_base&) = default;
+  hazard_pointer_obj_base(hazard_pointer_obj_base&&) = default;
+  hazard_pointer_obj_base& operator=(const hazard_pointer_obj_base&) =
+      default;
+  hazard_pointer_obj_base& operator=(hazard_pointer_obj_base&&) = default;
+  ~hazard_pointer_obj_base() = default;
+
+ private:
+  static void reclaim_object(detail::hazard_retired* node) {
+    T* object = static_cast<T*>(const_cast<void*>(node->object));
+    D deleter = std::move(object->hazard_pointer_obj_base::deleter_);
+    deleter(object);
+  }
+
+  detail::hazard_retired retired_;
+  D deleter_;
+};
+
+class hazard_pointer {
+ public:
+  // An empty hazard_pointer; use make_hazard_pointer() for a usable one.
+  hazard_pointer() noexcept = default;
+  hazard_pointer(hazard_pointer&& other) noexcept
+      : record_(std::exchange(other.record_, nullptr)) {}
+  hazard_pointer& operator=(hazard_pointer&& other) noexcept {
+    hazard_pointer(std::move(other)).swap(*this);
+    return *this;
+  }
+  ~hazard_pointer() {
+    if (record_ != nullptr) {
+      detail::hazard_domain::instance().release(record_);
+    }
+  }
+
+  hazard_pointer(const hazard_pointer&) = delete;
+  hazard_pointer& operator=(const hazard_pointer&) = delete;
+
+  bool empty() const noexcept { return record_ == nullptr; }
+
+  // Protects and returns the current value of `src`.
+  template <class T>
+  T* protect(const std::atomic<T*>& src) noexcept {
+    T* ptr = src.load(std::memory_order_relaxed);
+    while (!try_protect(ptr, src)) {
+    }
+    return ptr;
+  }
+
+  // Protects `ptr` if `src` still holds it. Otherwise clears the
+  // protection, stores the new value of `src` in `ptr` and returns false.
+  template <class T>
+  bool try_protect(T*& ptr, const std::atomic<T*>& src) noexcept {
+    T* const expected = ptr;
+    reset_protection(expected);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    ptr = src.load(std::memory_order_acquire);
+    if (ptr != expected) {
+      reset_protection();
+      return false;
+    }
+    return true;
+  }
+
+  template <class T>
+  void reset_protection(const T* ptr) noexcept {
+    record_->hazard.store(ptr, std::memory_order_release);
+  }
+  void reset_protection(std::nullptr_t = nullptr) noexcept {
+    record_->hazard.store(nullptr, std::memory_order_release);
+  }
+
+  void swap(hazard_pointer& other) noexcept {
+    std::swap(record_, other.record_);
+  }
+  friend void swap(hazard_pointer& a, hazard_pointer& b) noexcept {
+    a.swap(b);
+  }
+
+ private:
+  friend hazard_pointer make_hazard_pointer();
+
+  explicit hazard_pointer(detail::hazard_record* record) noexcept
+      : record_(record) {}
+
+  detail::hazard_record* record_ = nullptr;
+};
+
+// Returns a non-empty hazard_pointer, reusing a record when one is free.
+inline hazard_pointer make_hazard_pointer() {
+  return hazard_pointer(detail::hazard_domain::instance().acquire());
+}
+}  // namespace v1
+
+using v1::hazard_pointer;
+using v1::hazard_pointer_obj_base;
+using v1::make_hazard_pointer;
+}  // namespace stdcpp
+
+#endif  // __SCC_STDCPP_HAZARD_POINTER_HPP__
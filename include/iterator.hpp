@@ -5,12 +5,21 @@
 #include <cstddef>
 #include <iterator>
 #include <type_traits>
+#include <utility>
 
 namespace stdcpp {
 namespace v1 {
 template <class...>
 using void_t = void;
 
+// Customization point for common_reference, for types the built-in rules
+// cannot combine, such as the tuples of references that proxy iterators
+// return. TQual and UQual re-apply the cv- and reference qualifiers that T
+// and U were stripped of, as in C++20.
+template <typename T, typename U, template <typename> class TQual,
+          template <typename> class UQual>
+struct basic_common_reference {};
+
 namespace common_reference_detail {
 // Helper to combine cv-qualifiers
 template <typename T1, typename T2>
@@ -61,9 +70,80 @@ struct cv_combiner<volatile T, const T> {
   using type = const volatile T;
 };
 
+// Copies the cv- and reference qualifiers of From onto To.
+template <typename From, typename To>
+struct copy_cv {
+  using type = To;
+};
+
+template <typename From, typename To>
+struct copy_cv<const From, To> {
+  using type = const To;
+};
+
+template <typename From, typename To>
+struct copy_cv<volatile From, To> {
+  using type = volatile To;
+};
+
+template <typename From, typename To>
+struct copy_cv<const volatile From, To> {
+  using type = const volatile To;
+};
+
+template <typename From, typename To>
+struct copy_cvref {
+  using type = typename copy_cv<From, To>::type;
+};
+
+template <typename From, typename To>
+struct copy_cvref<From&, To> {
+  using type = typename copy_cv<From, To>::type&;
+};
+
+template <typename From, typename To>
+struct copy_cvref<From&&, To> {
+  using type = typename copy_cv<From, To>::type&&;
+};
+
+template <typename From>
+struct xref {
+  template <typename To>
+  using apply = typename copy_cvref<From, To>::type;
+};
+
+template <typename T>
+using remove_cvref_t = std::remove_cv_t<std::remove_reference_t<T>>;
+
+// The type of `false ? t : u`, else std::common_type.
+template <typename T1, typename T2, typename = void>
+struct conditional_common_reference : std::common_type<T1, T2> {};
+
+template <typename T1, typename T2>
+struct conditional_common_reference<
+    T1, T2, void_t<decltype(false ? std::declval<T1>() : std::declval<T2>())>> {
+  using type = decltype(false ? std::declval<T1>() : std::declval<T2>());
+};
+
+// Used when no reference rule below applies: basic_common_reference if
+// specialized for the two types, then the conditional operator.
+template <typename T1, typename T2, typename = void>
+struct fallback_common_reference : conditional_common_reference<T1, T2> {};
+
+template <typename T1, typename T2>
+struct fallback_common_reference<
+    T1, T2,
+    void_t<typename basic_common_reference<
+        remove_cvref_t<T1>, remove_cvref_t<T2>, xref<T1>::template apply,
+        xref<T2>::template apply>::type>> {
+  using type = typename basic_common_reference<
+      remove_cvref_t<T1>, remove_cvref_t<T2>, xref<T1>::template apply,
+      xref<T2>::template apply>::type;
+};
+
 // Primary template for binary_common_reference_t
 template <typename T1, typename T2, typename = void>
-struct binary_common_reference {};
+struct binary_common_reference : fallback_common_reference<T1, T2> {};
 
 // Specialization for lvalue references with combinable cv-qualifiers
 template <typename X, typename Y>
@@ -195,9 +275,64 @@ struct iter_const_reference {
       typename iter_reference<T>::type>::type;
 };
 
+// ranges::iter_move(it) moves from *it, or calls an iter_move(it) found by
+// argument-dependent lookup, which proxy iterators define so that moving
+// from their prvalue tuples of references moves the elements themselves.
+namespace ranges {
+namespace iter_move_detail {
+// Hides ranges::iter_move so that only argument-dependent lookup finds
+// customizations.
+void iter_move();
+
+template <typename I, typename = void>
+struct has_adl_iter_move : std::false_type {};
+
+template <typename I>
+struct has_adl_iter_move<I, void_t<decltype(iter_move(std::declval<I>()))>>
+    : std::true_type {};
+
+template <typename I>
+using dereferences_to_lvalue =
+    std::is_lvalue_reference<decltype(*std::declval<I>())>;
+
+struct iter_move_fn {
+  template <typename I,
+            std::enable_if_t<has_adl_iter_move<I>::value, int> = 0>
+  constexpr auto operator()(I&& it) const
+      -> decltype(iter_move(std::forward<I>(it))) {
+    return iter_move(std::forward<I>(it));
+  }
+
+  template <typename I,
+            std::enable_if_t<!has_adl_iter_move<I>::value &&
+                                 dereferences_to_lvalue<I>::value,
+                             int> = 0>
+  constexpr auto operator()(I&& it) const
+      -> decltype(std::move(*std::forward<I>(it))) {
+    return std::move(*std::forward<I>(it));
+  }
+
+  // Prvalues are returned as they are.
+  template <typename I,
+            std::enable_if_t<!has_adl_iter_move<I>::value &&
+                                 !dereferences_to_lvalue<I>::value,
+                             int> = 0>
+  constexpr auto operator()(I&& it) const -> decltype(*std::forward<I>(it)) {
+    return *std::forward<I>(it);
+  }
+};
+}  // namespace iter_move_detail
+
+// Kept apart from the hidden friends of the same name that iterators in
+// ranges declare.
+inline namespace cpo {
+constexpr iter_move_detail::iter_move_fn iter_move{};
+}  // namespace cpo
+}  // namespace ranges
+
 template <typename T>
 struct iter_rvalue_reference {
-  using type = decltype(std::move(*std::declval<T&>()));
+  using type = decltype(ranges::iter_move(std::declval<T&>()));
 };
 
 template <typename T>
@@ -235,6 +370,68 @@ using common_reference_t = typename common_reference<T...>::type;
 
 template <typename T>
 using iter_common_reference_t = typename iter_common_reference<T>::type;
+
+// ranges::iter_swap(a, b) swaps *a and *b: through an iter_swap(a, b) found
+// by argument-dependent lookup, else through swap(*a, *b), else by moving
+// the elements with ranges::iter_move.
+namespace ranges {
+namespace iter_swap_detail {
+using std::swap;
+
+// Hides ranges::iter_swap, and std::iter_swap for iterators of the standard
+// library, so that only customizations are found.
+template <typename I1, typename I2>
+void iter_swap(I1, I2) = delete;
+
+template <typename I1, typename I2, typename = void>
+struct has_adl_iter_swap : std::false_type {};
+
+template <typename I1, typename I2>
+struct has_adl_iter_swap<I1, I2,
+                         void_t<decltype(iter_swap(std::declval<I1>(),
+                                                   std::declval<I2>()))>>
+    : std::true_type {};
+
+template <typename I1, typename I2, typename = void>
+struct has_swappable_references : std::false_type {};
+
+template <typename I1, typename I2>
+struct has_swappable_references<
+    I1, I2,
+    void_t<decltype(swap(*std::declval<I1>(), *std::declval<I2>()))>>
+    : std::true_type {};
+
+struct iter_swap_fn {
+  template <typename I1, typename I2,
+            std::enable_if_t<has_adl_iter_swap<I1, I2>::value, int> = 0>
+  constexpr void operator()(I1&& a, I2&& b) const {
+    (void)iter_swap(std::forward<I1>(a), std::forward<I2>(b));
+  }
+
+  template <typename I1, typename I2,
+            std::enable_if_t<!has_adl_iter_swap<I1, I2>::value &&
+                                 has_swappable_references<I1, I2>::value,
+                             int> = 0>
+  constexpr void operator()(I1&& a, I2&& b) const {
+    swap(*std::forward<I1>(a), *std::forward<I2>(b));
+  }
+
+  template <typename I1, typename I2,
+            std::enable_if_t<!has_adl_iter_swap<I1, I2>::value &&
+                                 !has_swappable_references<I1, I2>::value,
+                             int> = 0>
+  constexpr void operator()(I1&& a, I2&& b) const {
+    iter_value_t<std::remove_reference_t<I1>> old(ranges::iter_move(a));
+    *a = ranges::iter_move(b);
+    *b = std::move(old);
+  }
+};
+}  // namespace iter_swap_detail
+
+inline namespace cpo {
+constexpr iter_swap_detail::iter_swap_fn iter_swap{};
+}  // namespace cpo
+}  // namespace ranges
 }  // namespace v1
 
 namespace v1 {
@@ -243,10 +440,144 @@ constexpr iter_difference_t<InputIt> distance(InputIt first, InputIt last) {
   // TODO: support non-random access iterators
   return last - first;
 }
+
+// A sentinel no iterator ever reaches, for unbounded ranges.
+struct unreachable_sentinel_t {
+  template <typename I>
+  friend constexpr bool operator==(const I&, unreachable_sentinel_t) noexcept {
+    return false;
+  }
+  template <typename I>
+  friend constexpr bool operator==(unreachable_sentinel_t, const I&) noexcept {
+    return false;
+  }
+  template <typename I>
+  friend constexpr bool operator!=(const I&, unreachable_sentinel_t) noexcept {
+    return true;
+  }
+  template <typename I>
+  friend constexpr bool operator!=(unreachable_sentinel_t, const I&) noexcept {
+    return true;
+  }
+};
+
+constexpr unreachable_sentinel_t unreachable_sentinel{};
+
+// Marks the end for iterators that know where their range ends themselves.
+struct default_sentinel_t {};
+
+constexpr default_sentinel_t default_sentinel{};
+
+// An iterator that counts down the elements left, so that an iterator
+// with count() == 0 marks the end of the range. Iterators compare by their
+// counts alone; both must come from the same counted range.
+template <typename I>
+class counted_iterator {
+ public:
+  using iterator_type = I;
+  using iterator_category =
+      typename std::iterator_traits<I>::iterator_category;
+  using value_type = iter_value_t<I>;
+  using difference_type = iter_difference_t<I>;
+  using reference = iter_reference_t<I>;
+  using pointer = typename std::iterator_traits<I>::pointer;
+
+  constexpr counted_iterator() = default;
+  constexpr counted_iterator(I it, difference_type n)
+      : current_(std::move(it)), count_(n) {}
+
+  constexpr const I& base() const& noexcept { return current_; }
+  constexpr I base() && { return std::move(current_); }
+  constexpr difference_type count() const noexcept { return count_; }
+
+  constexpr reference operator*() const { return *current_; }
+  constexpr reference operator[](difference_type n) const {
+    return current_[n];
+  }
+
+  constexpr counted_iterator& operator++() {
+    ++current_;
+    --count_;
+    return *this;
+  }
+  constexpr counted_iterator operator++(int) {
+    counted_iterator tmp = *this;
+    ++*this;
+    return tmp;
+  }
+  constexpr counted_iterator& operator--() {
+    --current_;
+    ++count_;
+    return *this;
+  }
+  constexpr counted_iterator operator--(int) {
+    counted_iterator tmp = *this;
+    --*this;
+    return tmp;
+  }
+  constexpr counted_iterator& operator+=(difference_type n) {
+    current_ += n;
+    count_ -= n;
+    return *this;
+  }
+  constexpr counted_iterator& operator-=(difference_type n) {
+    return *this += -n;
+  }
+
+  friend constexpr counted_iterator operator+(counted_iterator it,
+                                              difference_type n) {
+    return it += n;
+  }
+  friend constexpr counted_iterator operator+(difference_type n,
+                                              counted_iterator it) {
+    return it += n;
+  }
+  friend constexpr counted_iterator operator-(counted_iterator it,
+                                              difference_type n) {
+    return it -= n;
+  }
+  friend constexpr difference_type operator-(const counted_iterator& a,
+                                             const counted_iterator& b) {
+    return b.count_ - a.count_;
+  }
+
+  friend constexpr bool operator==(const counted_iterator& a,
+                                   const counted_iterator& b) {
+    return a.count_ == b.count_;
+  }
+  friend constexpr bool operator!=(const counted_iterator& a,
+                                   const counted_iterator& b) {
+    return a.count_ != b.count_;
+  }
+  friend constexpr bool operator<(const counted_iterator& a,
+                                  const counted_iterator& b) {
+    return b.count_ < a.count_;
+  }
+  friend constexpr bool operator>(const counted_iterator& a,
+                                  const counted_iterator& b) {
+    return b < a;
+  }
+  friend constexpr bool operator<=(const counted_iterator& a,
+                                   const counted_iterator& b) {
+    return !(b < a);
+  }
+  friend constexpr bool operator>=(const counted_iterator& a,
+                                   const counted_iterator& b) {
+    return !(a < b);
+  }
+
+ private:
+  I current_{};
+  difference_type count_ = 0;
+};
 }  // namespace v1
 
+using v1::basic_common_reference;
 using v1::common_reference;
 using v1::common_reference_t;
+using v1::counted_iterator;
+using v1::default_sentinel;
+using v1::default_sentinel_t;
 using v1::distance;
 using v1::iter_const_reference;
 using v1::iter_const_reference_t;
@@ -258,6 +589,8 @@ using v1::iter_rvalue_reference;
 using v1::iter_rvalue_reference_t;
 using v1::iter_value;
 using v1::iter_value_t;
+using v1::unreachable_sentinel;
+using v1::unreachable_sentinel_t;
 using v1::void_t;
 }  // namespace stdcpp
 
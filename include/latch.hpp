@@ -0,0 +1,72 @@
+#ifndef __SCC_STDCPP_LATCH_HPP__
+#define __SCC_STDCPP_LATCH_HPP__
+#pragma once
+
+#include <atomic.hpp>
+#include <detail/parking.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace stdcpp {
+namespace v1 {
+// C++20 std::latch for C++14.
+//
+// count_down() is a single fetch_sub; only the arrival that reaches zero
+// notifies, which costs a system call only if someone is waiting. wait()
+// spins briefly before waiting on the counter.
+class latch {
+ public:
+  static constexpr std::ptrdiff_t max() noexcept {
+    return std::numeric_limits<std::int32_t>::max();
+  }
+
+  constexpr explicit latch(std::ptrdiff_t expected)
+      : counter_(static_cast<std::int32_t>(expected)) {}
+  ~latch() = default;
+
+  latch(const latch&) = delete;
+  latch& operator=(const latch&) = delete;
+
+  void count_down(std::ptrdiff_t update = 1) {
+    const std::int32_t old = counter_.fetch_sub(
+        static_cast<std::int32_t>(update), std::memory_order_release);
+    if (old == update) {
+      v1::atomic_notify_all(&counter_);
+    }
+  }
+
+  bool try_wait() const noexcept {
+    return counter_.load(std::memory_order_acquire) == 0;
+  }
+
+  void wait() const {
+    if (try_wait() ||
+        detail::spin_until([this] { return try_wait(); }, 1024)) {
+      return;
+    }
+    for (;;) {
+      const std::int32_t current = counter_.load(std::memory_order_acquire);
+      if (current == 0) {
+        return;
+      }
+      v1::atomic_wait_explicit(&counter_, current, std::memory_order_acquire);
+    }
+  }
+
+  void arrive_and_wait(std::ptrdiff_t update = 1) {
+    count_down(update);
+    wait();
+  }
+
+ private:
+  std::atomic<std::int32_t> counter_;
+};
+}  // namespace v1
+
+using v1::latch;
+}  // namespace stdcpp
+
+#endif  // __SCC_STDCPP_LATCH_HPP__
@@ -0,0 +1,340 @@
+#ifndef __SCC_STDCPP_LOCK_STATS_HPP__
+#define __SCC_STDCPP_LOCK_STATS_HPP__
+#pragma once
+
+#include <shared_mutex.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Per-lock contention statistics.
+//
+// instrumented_mutex<Mutex> wraps any Lockable (and SharedLockable, if the
+// shared members are used). Statistics are only collected when the program is
+// compiled with STDCPP_ENABLE_LOCK_STATS defined; otherwise the wrapper is
+// Mutex itself plus a constructor taking a name, and compiles out entirely.
+// Both variants live in distinct inline namespaces, so translation units
+// built with and without the macro can be linked together.
+
+namespace stdcpp {
+namespace v1 {
+// Log2-bucketed histogram of durations in nanoseconds: bucket 0 counts
+// samples below 2ns, bucket i counts samples in [2^i, 2^(i+1)) ns.
+struct lock_histogram {
+  static constexpr std::size_t bucket_count = 40;
+  std::array<std::uint64_t, bucket_count> buckets{};
+
+  std::uint64_t count() const noexcept {
+    std::uint64_t n = 0;
+    for (auto b : buckets) {
+      n += b;
+    }
+    return n;
+  }
+
+  // Upper bound (in ns) of the bucket holding the q-quantile, 0 if empty.
+  std::uint64_t percentile(double q) const noexcept {
+    const std::uint64_t total = count();
+    if (total == 0) {
+      return 0;
+    }
+    const auto rank = static_cast<std::uint64_t>(q * (total - 1)) + 1;
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < bucket_count; ++i) {
+      seen += buckets[i];
+      if (seen >= rank) {
+        return std::uint64_t{2} << i;
+      }
+    }
+    return std::uint64_t{2} << (bucket_count - 1);
+  }
+};
+
+struct lock_stats_snapshot {
+  std::string name;
+  std::uint64_t exclusive_acquisitions = 0;
+  std::uint64_t shared_acquisitions = 0;
+  std::uint64_t contended_exclusive = 0;
+  std::uint64_t contended_shared = 0;
+  std::uint32_t max_readers = 0;
+  // Time spent blocked in contended lock()/lock_shared() calls.
+  lock_histogram wait_ns;
+  // Time between lock() and unlock().
+  lock_histogram hold_ns;
+  // Time the lock was continuously held by at least one reader.
+  lock_histogram shared_hold_ns;
+};
+
+inline std::ostream& operator<<(std::ostream& os,
+                                const lock_stats_snapshot& s) {
+  os << (s.name.empty() ? "<unnamed>" : s.name)
+     << ": exclusive=" << s.exclusive_acquisitions << " (contended "
+     << s.contended_exclusive << ") shared=" << s.shared_acquisitions
+     << " (contended " << s.contended_shared
+     << ") max_readers=" << s.max_readers
+     << " wait_ns p50<=" << s.wait_ns.percentile(0.5)
+     << " p99<=" << s.wait_ns.percentile(0.99)
+     << " hold_ns p50<=" << s.hold_ns.percentile(0.5)
+     << " p99<=" << s.hold_ns.percentile(0.99);
+  return os;
+}
+
+namespace detail {
+class lock_stats_source {
+ public:
+  virtual lock_stats_snapshot snapshot() const = 0;
+
+ protected:
+  ~lock_stats_source() = default;
+};
+
+class atomic_histogram {
+ public:
+  void record(std::uint64_t ns) noexcept {
+    std::size_t bucket = 0;
+    while (bucket + 1 < lock_histogram::bucket_count &&
+           (ns >> (bucket + 1)) != 0) {
+      ++bucket;
+    }
+    buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+  }
+
+  lock_histogram load() const noexcept {
+    lock_histogram h;
+    for (std::size_t i = 0; i < lock_histogram::bucket_count; ++i) {
+      h.buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+    }
+    return h;
+  }
+
+ private:
+  std::array<std::atomic<std::uint64_t>, lock_histogram::bucket_count>
+      buckets_{};
+};
+
+inline std::uint64_t now_ns() noexcept {
+  return static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+}
+}  // namespace detail
+
+// Process-wide list of live instrumented locks. Empty unless
+// STDCPP_ENABLE_LOCK_STATS is defined.
+class lock_stats_registry {
+ public:
+  static lock_stats_registry& instance() {
+    static lock_stats_registry registry;
+    return registry;
+  }
+
+  std::vector<lock_stats_snapshot> snapshot() const {
+    std::lock_guard<std::mutex> lk(mtx_);
+    std::vector<lock_stats_snapshot> out;
+    out.reserve(sources_.size());
+    for (auto* source : sources_) {
+      out.push_back(source->snapshot());
+    }
+    return out;
+  }
+
+  // Writes one line per registered lock, most contended first.
+  void dump(std::ostream& os) const {
+    auto all = snapshot();
+    std::sort(all.begin(), all.end(),
+              [](const lock_stats_snapshot& a, const lock_stats_snapshot& b) {
+                return a.contended_exclusive + a.contended_shared >
+                       b.contended_exclusive + b.contended_shared;
+              });
+    for (const auto& s : all) {
+      os << s << '\n';
+    }
+  }
+
+  void add(const detail::lock_stats_source* source) {
+    std::lock_guard<std::mutex> lk(mtx_);
+    sources_.push_back(source);
+  }
+
+  void remove(const detail::lock_stats_source* source) {
+    std::lock_guard<std::mutex> lk(mtx_);
+    sources_.erase(std::remove(sources_.begin(), sources_.end(), source),
+                   sources_.end());
+  }
+
+ private:
+  lock_stats_registry() = default;
+
+  mutable std::mutex mtx_;
+  std::vector<const detail::lock_stats_source*> sources_;
+};
+
+#ifdef STDCPP_ENABLE_LOCK_STATS
+inline namespace lock_stats_enabled {
+template <class Mutex>
+class instrumented_mutex : private detail::lock_stats_source {
+ public:
+  using mutex_type = Mutex;
+
+  instrumented_mutex() : instrumented_mutex("") {}
+  template <class... Args>
+  explicit instrumented_mutex(const char* name, Args&&... args)
+      : mtx_(std::forward<Args>(args)...), name_(name) {
+    lock_stats_registry::instance().add(this);
+  }
+  ~instrumented_mutex() { lock_stats_registry::instance().remove(this); }
+
+  instrumented_mutex(const instrumented_mutex&) = delete;
+  instrumented_mutex& operator=(const instrumented_mutex&) = delete;
+
+  void lock() {
+    bool contended = false;
+    if (!mtx_.try_lock()) {
+      contended = true;
+      const auto start = detail::now_ns();
+      mtx_.lock();
+      wait_ns_.record(detail::now_ns() - start);
+    }
+    on_exclusive(contended);
+  }
+
+  bool try_lock() {
+    if (!mtx_.try_lock()) {
+      return false;
+    }
+    on_exclusive(false);
+    return true;
+  }
+
+  void unlock() {
+    hold_ns_.record(detail::now_ns() -
+                    held_since_.load(std::memory_order_relaxed));
+    mtx_.unlock();
+  }
+
+  void lock_shared() {
+    bool contended = false;
+    if (!mtx_.try_lock_shared()) {
+      contended = true;
+      const auto start = detail::now_ns();
+      mtx_.lock_shared();
+      wait_ns_.record(detail::now_ns() - start);
+    }
+    on_shared(contended);
+  }
+
+  bool try_lock_shared() {
+    if (!mtx_.try_lock_shared()) {
+      return false;
+    }
+    on_shared(false);
+    return true;
+  }
+
+  void unlock_shared() {
+    if (readers_.fetch_sub(1, std::memory_order_relaxed) == 1) {
+      shared_hold_ns_.record(
+          detail::now_ns() -
+          shared_since_.load(std::memory_order_relaxed));
+    }
+    mtx_.unlock_shared();
+  }
+
+  lock_stats_snapshot snapshot() const override {
+    lock_stats_snapshot s;
+    s.name = name_;
+    s.exclusive_acquisitions = exclusive_.load(std::memory_order_relaxed);
+    s.shared_acquisitions = shared_.load(std::memory_order_relaxed);
+    s.contended_exclusive = contended_exclusive_.load(std::memory_order_relaxed);
+    s.contended_shared = contended_shared_.load(std::memory_order_relaxed);
+    s.max_readers = max_readers_.load(std::memory_order_relaxed);
+    s.wait_ns = wait_ns_.load();
+    s.hold_ns = hold_ns_.load();
+    s.shared_hold_ns = shared_hold_ns_.load();
+    return s;
+  }
+
+  Mutex& underlying() noexcept { return mtx_; }
+
+ private:
+  void on_exclusive(bool contended) noexcept {
+    exclusive_.fetch_add(1, std::memory_order_relaxed);
+    if (contended) {
+      contended_exclusive_.fetch_add(1, std::memory_order_relaxed);
+    }
+    held_since_.store(detail::now_ns(), std::memory_order_relaxed);
+  }
+
+  void on_shared(bool contended) noexcept {
+    shared_.fetch_add(1, std::memory_order_relaxed);
+    if (contended) {
+      contended_shared_.fetch_add(1, std::memory_order_relaxed);
+    }
+    const std::uint32_t readers =
+        readers_.fetch_add(1, std::memory_order_relaxed) + 1;
+    if (readers == 1) {
+      shared_since_.store(detail::now_ns(), std::memory_order_relaxed);
+    }
+    std::uint32_t seen = max_readers_.load(std::memory_order_relaxed);
+    while (readers > seen && !max_readers_.compare_exchange_weak(
+                                 seen, readers, std::memory_order_relaxed)) {
+    }
+  }
+
+  Mutex mtx_;
+  std::string name_;
+  std::atomic<std::uint64_t> exclusive_{0};
+  std::atomic<std::uint64_t> shared_{0};
+  std::atomic<std::uint64_t> contended_exclusive_{0};
+  std::atomic<std::uint64_t> contended_shared_{0};
+  std::atomic<std::uint32_t> readers_{0};
+  std::atomic<std::uint32_t> max_readers_{0};
+  std::atomic<std::uint64_t> held_since_{0};
+  std::atomic<std::uint64_t> shared_since_{0};
+  detail::atomic_histogram wait_ns_;
+  detail::atomic_histogram hold_ns_;
+  detail::atomic_histogram shared_hold_ns_;
+};
+}  // namespace lock_stats_enabled
+#else
+inline namespace lock_stats_disabled {
+template <class Mutex>
+class instrumented_mutex : public Mutex {
+ public:
+  using mutex_type = Mutex;
+
+  instrumented_mutex() = default;
+  template <class... Args>
+  explicit instrumented_mutex(const char*, Args&&... args)
+      : Mutex(std::forward<Args>(args)...) {}
+
+  lock_stats_snapshot snapshot() const { return {}; }
+  Mutex& underlying() noexcept { return *this; }
+};
+}  // namespace lock_stats_disabled
+#endif
+
+template <class SpinPolicy = adaptive_spin>
+using basic_instrumented_shared_mutex =
+    instrumented_mutex<basic_shared_mutex<SpinPolicy>>;
+using instrumented_shared_mutex = basic_instrumented_shared_mutex<>;
+}  // namespace v1
+
+using v1::basic_instrumented_shared_mutex;
+using v1::instrumented_mutex;
+using v1::instrumented_shared_mutex;
+using v1::lock_histogram;
+using v1::lock_stats_registry;
+using v1::lock_stats_snapshot;
+}  // namespace stdcpp
+
+#endif  // __SCC_STDCPP_LOCK_STATS_HPP__
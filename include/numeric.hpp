@@ -0,0 +1,478 @@
+#ifndef __SCC_STDCPP_NUMERIC_HPP__
+#define __SCC_STDCPP_NUMERIC_HPP__
+#pragma once
+
+#include <algorithm.hpp>
+#include <detail/simd.hpp>
+#include <execution.hpp>
+#include <ranges.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace stdcpp {
+namespace v1 {
+// reduce, transform_reduce and inclusive_scan from C++17, with and without
+// an execution policy. Unlike std::accumulate they may regroup the
+// operations, which must therefore be associative and commutative.
+template <class I, class T, class Op,
+          std::enable_if_t<!detail::is_policy<I>::value, int> = 0>
+T reduce(I first, I last, T init, Op op) {
+  for (; first != last; ++first) {
+    init = op(std::move(init), *first);
+  }
+  return init;
+}
+
+template <class I, class T,
+          std::enable_if_t<!detail::is_policy<I>::value, int> = 0>
+T reduce(I first, I last, T init) {
+  return v1::reduce(first, last, std::move(init), std::plus<>());
+}
+
+template <class I, std::enable_if_t<!detail::is_policy<I>::value, int> = 0>
+typename std::iterator_traits<I>::value_type reduce(I first, I last) {
+  return v1::reduce(first, last,
+                    typename std::iterator_traits<I>::value_type{},
+                    std::plus<>());
+}
+
+template <class I, class T, class Reduce, class Transform,
+          std::enable_if_t<!detail::is_policy<I>::value, int> = 0>
+T transform_reduce(I first, I last, T init, Reduce reduce,
+                   Transform transform) {
+  for (; first != last; ++first) {
+    init = reduce(std::move(init), transform(*first));
+  }
+  return init;
+}
+
+template <class I1, class I2, class T, class Reduce, class Transform,
+          std::enable_if_t<!detail::is_policy<I1>::value, int> = 0>
+T transform_reduce(I1 first1, I1 last1, I2 first2, T init, Reduce reduce,
+                   Transform transform) {
+  for (; first1 != last1; ++first1, ++first2) {
+    init = reduce(std::move(init), transform(*first1, *first2));
+  }
+  return init;
+}
+
+template <class I1, class I2, class T,
+          std::enable_if_t<!detail::is_policy<I1>::value, int> = 0>
+T transform_reduce(I1 first1, I1 last1, I2 first2, T init) {
+  return v1::transform_reduce(first1, last1, first2, std::move(init),
+                              std::plus<>(), std::multiplies<>());
+}
+
+template <class I, class O, class Op, class T,
+          std::enable_if_t<!detail::is_policy<I>::value, int> = 0>
+O inclusive_scan(I first, I last, O out, Op op, T init) {
+  for (; first != last; ++first, ++out) {
+    init = op(std::move(init), *first);
+    *out = init;
+  }
+  return out;
+}
+
+template <class I, class O, class Op,
+          std::enable_if_t<!detail::is_policy<I>::value, int> = 0>
+O inclusive_scan(I first, I last, O out, Op op) {
+  if (first == last) {
+    return out;
+  }
+  typename std::iterator_traits<I>::value_type sum = *first;
+  *out = sum;
+  return v1::inclusive_scan(++first, last, ++out, op, std::move(sum));
+}
+
+template <class I, class O,
+          std::enable_if_t<!detail::is_policy<I>::value, int> = 0>
+O inclusive_scan(I first, I last, O out) {
+  return v1::inclusive_scan(first, last, out, std::plus<>());
+}
+
+namespace detail {
+// Reduces at(i) over each chunk of [0, n) on its own, then the chunk
+// results in order after init.
+template <class P, class T, class Reduce, class At>
+T reduce_chunks(P& policy, std::size_t n, T init, Reduce& reduce, At at) {
+  const chunk_plan plan = plan_chunks(policy, n, element_grain);
+  std::vector<T> partials(plan.count(), init);
+  run_chunks(policy, plan, [&](std::size_t chunk) {
+    const auto begin = static_cast<std::ptrdiff_t>(plan.begin(chunk));
+    const auto end = static_cast<std::ptrdiff_t>(plan.end(chunk));
+    T sum = at(begin);
+    for (std::ptrdiff_t i = begin + 1; i < end; ++i) {
+      sum = reduce(std::move(sum), at(i));
+    }
+    partials[chunk] = std::move(sum);
+  });
+  for (T& partial : partials) {
+    init = reduce(std::move(init), std::move(partial));
+  }
+  return init;
+}
+
+template <class P, class I, class T, class Reduce, class Transform>
+T transform_reduce(P& policy, I first, I last, T init, Reduce& reduce,
+                   Transform& transform, std::true_type) {
+  auto at = [first, &transform](std::ptrdiff_t i) -> decltype(auto) {
+    return transform(first[i]);
+  };
+  return reduce_chunks(policy, static_cast<std::size_t>(last - first),
+                       std::move(init), reduce, at);
+}
+
+template <class P, class I, class T, class Reduce, class Transform>
+T transform_reduce(P&, I first, I last, T init, Reduce& reduce,
+                   Transform& transform, std::false_type) {
+  return v1::transform_reduce(first, last, std::move(init), reduce,
+                              transform);
+}
+
+template <class P, class I1, class I2, class T, class Reduce,
+          class Transform>
+T transform_reduce(P& policy, I1 first1, I1 last1, I2 first2, T init,
+                   Reduce& reduce, Transform& transform, std::true_type) {
+  auto at = [first1, first2, &transform](std::ptrdiff_t i) -> decltype(auto) {
+    return transform(first1[i], first2[i]);
+  };
+  return reduce_chunks(policy, static_cast<std::size_t>(last1 - first1),
+                       std::move(init), reduce, at);
+}
+
+template <class P, class I1, class I2, class T, class Reduce,
+          class Transform>
+T transform_reduce(P&, I1 first1, I1 last1, I2 first2, T init,
+                   Reduce& reduce, Transform& transform, std::false_type) {
+  return v1::transform_reduce(first1, last1, first2, std::move(init), reduce,
+                              transform);
+}
+
+// Scans each chunk's total first, then each chunk again from init and the
+// totals before it.
+template <class P, class I, class O, class Op, class T>
+O inclusive_scan(P& policy, I first, I last, O out, Op& op, T init,
+                 std::true_type) {
+  const chunk_plan plan = plan_chunks(
+      policy, static_cast<std::size_t>(last - first), element_grain);
+  if (plan.count() <= 1) {
+    return v1::inclusive_scan(first, last, out, op, std::move(init));
+  }
+  std::vector<T> totals(plan.count(), init);
+  run_chunks(policy, plan, [&](std::size_t chunk) {
+    const auto begin = static_cast<std::ptrdiff_t>(plan.begin(chunk));
+    const auto end = static_cast<std::ptrdiff_t>(plan.end(chunk));
+    totals[chunk] =
+        v1::reduce(first + begin + 1, first + end, T(first[begin]), op);
+  });
+  totals[0] = op(init, totals[0]);
+  for (std::size_t chunk = 1; chunk < plan.count(); ++chunk) {
+    totals[chunk] = op(totals[chunk - 1], totals[chunk]);
+  }
+  run_chunks(policy, plan, [&](std::size_t chunk) {
+    const auto begin = static_cast<std::ptrdiff_t>(plan.begin(chunk));
+    const auto end = static_cast<std::ptrdiff_t>(plan.end(chunk));
+    v1::inclusive_scan(first + begin, first + end, out + begin, op,
+                       chunk == 0 ? init : totals[chunk - 1]);
+  });
+  return out + (last - first);
+}
+
+template <class P, class I, class O, class Op, class T>
+O inclusive_scan(P&, I first, I last, O out, Op& op, T init,
+                 std::false_type) {
+  return v1::inclusive_scan(first, last, out, op, std::move(init));
+}
+}  // namespace detail
+
+template <class P, class I, class T, class Reduce, class Transform,
+          std::enable_if_t<detail::is_policy<P>::value, int> = 0>
+T transform_reduce(P&& policy, I first, I last, T init, Reduce reduce,
+                   Transform transform) {
+  return detail::transform_reduce(policy, first, last, std::move(init),
+                                  reduce, transform,
+                                  detail::runs_parallel<P, I>{});
+}
+
+template <class P, class I1, class I2, class T, class Reduce,
+          class Transform,
+          std::enable_if_t<detail::is_policy<P>::value, int> = 0>
+T transform_reduce(P&& policy, I1 first1, I1 last1, I2 first2, T init,
+                   Reduce reduce, Transform transform) {
+  return detail::transform_reduce(
+      policy, first1, last1, first2, std::move(init), reduce, transform,
+      std::integral_constant<bool, detail::runs_parallel<P, I1>::value &&
+                                       detail::runs_parallel<P, I2>::value>{});
+}
+
+template <class P, class I1, class I2, class T,
+          std::enable_if_t<detail::is_policy<P>::value, int> = 0>
+T transform_reduce(P&& policy, I1 first1, I1 last1, I2 first2, T init) {
+  return v1::transform_reduce(policy, first1, last1, first2, std::move(init),
+                              std::plus<>(), std::multiplies<>());
+}
+
+template <class P, class I, class T, class Op,
+          std::enable_if_t<detail::is_policy<P>::value, int> = 0>
+T reduce(P&& policy, I first, I last, T init, Op op) {
+  return v1::transform_reduce(
+      policy, first, last, std::move(init), op,
+      [](auto&& x) -> decltype(auto) { return std::forward<decltype(x)>(x); });
+}
+
+template <class P, class I, class T,
+          std::enable_if_t<detail::is_policy<P>::value, int> = 0>
+T reduce(P&& policy, I first, I last, T init) {
+  return v1::reduce(policy, first, last, std::move(init), std::plus<>());
+}
+
+template <class P, class I,
+          std::enable_if_t<detail::is_policy<P>::value, int> = 0>
+typename std::iterator_traits<I>::value_type reduce(P&& policy, I first,
+                                                    I last) {
+  return v1::reduce(policy, first, last,
+                    typename std::iterator_traits<I>::value_type{},
+                    std::plus<>());
+}
+
+template <class P, class I, class O, class Op, class T,
+          std::enable_if_t<detail::is_policy<P>::value, int> = 0>
+O inclusive_scan(P&& policy, I first, I last, O out, Op op, T init) {
+  return detail::inclusive_scan(
+      policy, first, last, out, op, std::move(init),
+      std::integral_constant<bool, detail::runs_parallel<P, I>::value &&
+                                       detail::runs_parallel<P, O>::value>{});
+}
+
+template <class P, class I, class O, class Op,
+          std::enable_if_t<detail::is_policy<P>::value, int> = 0>
+O inclusive_scan(P&& policy, I first, I last, O out, Op op) {
+  if (first == last) {
+    return out;
+  }
+  typename std::iterator_traits<I>::value_type init = *first;
+  *out = init;
+  return v1::inclusive_scan(policy, ++first, last, ++out, op,
+                            std::move(init));
+}
+
+template <class P, class I, class O,
+          std::enable_if_t<detail::is_policy<P>::value, int> = 0>
+O inclusive_scan(P&& policy, I first, I last, O out) {
+  return v1::inclusive_scan(policy, first, last, out, std::plus<>());
+}
+
+namespace detail {
+// Folds block(begin, end), the sum of [begin, end), over [0, n) after
+// init: in chunks on the pool under a parallel policy, else in one block.
+template <class P, class T, class Op, class Block>
+T reduce_blocks(P& policy, std::size_t n, T init, Op& op, Block block,
+                std::true_type /* parallel */) {
+  const chunk_plan plan = plan_chunks(policy, n, simd_grain);
+  std::vector<T> partials(plan.count(), init);
+  run_chunks(policy, plan, [&](std::size_t chunk) {
+    partials[chunk] = block(plan.begin(chunk), plan.end(chunk));
+  });
+  for (T& partial : partials) {
+    init = op(std::move(init), std::move(partial));
+  }
+  return init;
+}
+
+template <class P, class T, class Op, class Block>
+T reduce_blocks(P&, std::size_t n, T init, Op& op, Block block,
+                std::false_type) {
+  return op(std::move(init), block(0, n));
+}
+
+// Whether elements of type E can be summed into a T with op by the SIMD
+// kernels: integers always, since their sums wrap the same in any order,
+// floating point only under unseq or par_unseq.
+template <class P, class E, class T, class Op>
+using is_simd_sum = std::integral_constant<
+    bool, is_simd_type<T>::value && std::is_same<E, T>::value &&
+              (std::is_same<Op, std::plus<>>::value ||
+               std::is_same<Op, std::plus<T>>::value) &&
+              (std::is_integral<T>::value || is_unsequenced_policy<P>::value)>;
+
+template <class P, class R, class T, class Op>
+using is_simd_reduce =
+    is_simd_sum<P, ranges::detail::pointer_element_t<R>, T, Op>;
+
+template <class P, class R1, class R2, class T>
+using is_simd_dot = std::integral_constant<
+    bool, is_simd_sum<P, ranges::detail::pointer_element_t<R1>, T,
+                      std::plus<>>::value &&
+              std::is_same<ranges::detail::pointer_element_t<R1>,
+                           ranges::detail::pointer_element_t<R2>>::value>;
+
+template <class P, class R, class T, class Op>
+T reduce_range(P& policy, R& r, T init, Op& op, std::true_type /* simd */) {
+  using L = simd_sum_t<T>;
+  const T* p = ranges::data(r);
+  return reduce_blocks(
+      policy, static_cast<std::size_t>(ranges::size(r)), std::move(init), op,
+      [p](std::size_t begin, std::size_t end) {
+        return static_cast<T>(simd_sum<L>(p + begin, end - begin));
+      },
+      is_parallel_policy<P>{});
+}
+
+template <class P, class R, class T, class Op>
+T reduce_range(P& policy, R& r, T init, Op& op, std::false_type) {
+  return v1::reduce(policy, ranges::begin(r), ranges::end(r), std::move(init),
+                    op);
+}
+
+template <class P, class R1, class R2, class T>
+T dot_range(P& policy, R1& r1, R2& r2, T init, std::true_type /* simd */) {
+  using L = simd_sum_t<T>;
+  const T* a = ranges::data(r1);
+  const T* b = ranges::data(r2);
+  std::plus<> op;
+  return reduce_blocks(
+      policy, static_cast<std::size_t>(ranges::size(r1)), std::move(init), op,
+      [a, b](std::size_t begin, std::size_t end) {
+        return static_cast<T>(simd_dot<L>(a + begin, b + begin, end - begin));
+      },
+      is_parallel_policy<P>{});
+}
+
+template <class P, class R1, class R2, class T>
+T dot_range(P& policy, R1& r1, R2& r2, T init, std::false_type) {
+  return v1::transform_reduce(policy, ranges::begin(r1), ranges::end(r1),
+                              ranges::begin(r2), std::move(init));
+}
+}  // namespace detail
+
+namespace ranges {
+// reduce and dot over common ranges, with or without an execution policy.
+//
+// Contiguous ranges of integers, float or double, summed into their own
+// value type with std::plus, go through the SIMD kernels in
+// detail/simd.hpp; floating-point ones only under execution::unseq or
+// par_unseq, since summing in lanes rounds differently. Otherwise floating
+// point is summed in order, as by std::accumulate, unless a parallel
+// policy splits the range.
+template <class P, class R, class T, class Op,
+          std::enable_if_t<v1::detail::is_policy<P>::value &&
+                               detail::is_common_range<R>::value,
+                           int> = 0>
+T reduce(P&& policy, R&& r, T init, Op op) {
+  return v1::detail::reduce_range(
+      policy, r, std::move(init), op,
+      v1::detail::is_simd_reduce<P, R, T, Op>{});
+}
+
+template <class P, class R, class T,
+          std::enable_if_t<v1::detail::is_policy<P>::value &&
+                               detail::is_common_range<R>::value,
+                           int> = 0>
+T reduce(P&& policy, R&& r, T init) {
+  return ranges::reduce(policy, r, std::move(init), std::plus<>());
+}
+
+template <class P, class R,
+          std::enable_if_t<v1::detail::is_policy<P>::value &&
+                               detail::is_common_range<R>::value,
+                           int> = 0>
+range_value_t<R> reduce(P&& policy, R&& r) {
+  return ranges::reduce(policy, r, range_value_t<R>{}, std::plus<>());
+}
+
+template <class R, class T, class Op,
+          std::enable_if_t<detail::is_common_range<R>::value, int> = 0>
+T reduce(R&& r, T init, Op op) {
+  return ranges::reduce(execution::seq, r, std::move(init), std::move(op));
+}
+
+template <class R, class T,
+          std::enable_if_t<detail::is_common_range<R>::value, int> = 0>
+T reduce(R&& r, T init) {
+  return ranges::reduce(execution::seq, r, std::move(init), std::plus<>());
+}
+
+template <class R,
+          std::enable_if_t<detail::is_common_range<R>::value, int> = 0>
+range_value_t<R> reduce(R&& r) {
+  return ranges::reduce(execution::seq, r, range_value_t<R>{}, std::plus<>());
+}
+
+// init plus the sum of the products of r1's elements with the elements of
+// r2 at the same positions; r2 must be at least as long as r1.
+namespace detail {
+template <class R1, class R2>
+using is_dot_operands = std::integral_constant<
+    bool, is_common_range<R1>::value &&
+              is_range<std::remove_reference_t<R2>>::value>;
+}  // namespace detail
+
+template <class P, class R1, class R2, class T,
+          std::enable_if_t<v1::detail::is_policy<P>::value &&
+                               detail::is_dot_operands<R1, R2>::value,
+                           int> = 0>
+T dot(P&& policy, R1&& r1, R2&& r2, T init) {
+  return v1::detail::dot_range(policy, r1, r2, std::move(init),
+                               v1::detail::is_simd_dot<P, R1, R2, T>{});
+}
+
+template <class P, class R1, class R2,
+          std::enable_if_t<v1::detail::is_policy<P>::value &&
+                               detail::is_dot_operands<R1, R2>::value,
+                           int> = 0>
+std::common_type_t<range_value_t<R1>, range_value_t<R2>> dot(P&& policy,
+                                                             R1&& r1,
+                                                             R2&& r2) {
+  return ranges::dot(
+      policy, r1, r2,
+      std::common_type_t<range_value_t<R1>, range_value_t<R2>>{});
+}
+
+template <class R1, class R2, class T,
+          std::enable_if_t<detail::is_dot_operands<R1, R2>::value,
+                           int> = 0>
+T dot(R1&& r1, R2&& r2, T init) {
+  return ranges::dot(execution::seq, r1, r2, std::move(init));
+}
+
+template <class R1, class R2,
+          std::enable_if_t<detail::is_dot_operands<R1, R2>::value,
+                           int> = 0>
+std::common_type_t<range_value_t<R1>, range_value_t<R2>> dot(R1&& r1,
+                                                             R2&& r2) {
+  return ranges::dot(execution::seq, r1, r2);
+}
+
+template <class P, class R, class T, class Reduce, class Transform,
+          std::enable_if_t<v1::detail::is_policy<P>::value &&
+                               detail::is_common_range<R>::value,
+                           int> = 0>
+T transform_reduce(P&& policy, R&& r, T init, Reduce reduce,
+                   Transform transform) {
+  return v1::transform_reduce(policy, ranges::begin(r), ranges::end(r),
+                              std::move(init), std::move(reduce),
+                              std::move(transform));
+}
+
+template <class P, class R, class O, class Op = std::plus<>,
+          std::enable_if_t<v1::detail::is_policy<P>::value &&
+                               detail::is_common_range<R>::value,
+                           int> = 0>
+O inclusive_scan(P&& policy, R&& r, O out, Op op = {}) {
+  return v1::inclusive_scan(policy, ranges::begin(r), ranges::end(r),
+                            std::move(out), std::move(op));
+}
+}  // namespace ranges
+}  // namespace v1
+
+using v1::inclusive_scan;
+using v1::reduce;
+using v1::transform_reduce;
+}  // namespace stdcpp
+
+#endif  // __SCC_STDCPP_NUMERIC_HPP__
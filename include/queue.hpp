@@ -0,0 +1,472 @@
+#ifndef __SCC_STDCPP_QUEUE_HPP__
+#define __SCC_STDCPP_QUEUE_HPP__
+#pragma once
+
+#include <atomic.hpp>
+#include <detail/cpu.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Bounded lock-free ring queues for passing items between threads.
+//
+// spsc_queue<T> is for exactly one producer and one consumer thread;
+// mpmc_queue<T> (Dmitry Vyukov's bounded queue) for any number of each.
+// Capacities are rounded up to a power of two. try_push_n()/try_pop_n()
+// move up to n items with a single index update, so a batch costs about
+// as much synchronization as one item.
+//
+// Both take a `Blocking` flag. With it set, push() and pop() wait for
+// space or items with atomic_wait(), and every successful operation checks
+// for waiters: spsc_queue with one fence, mpmc_queue by bumping a counter
+// and reading a count of waiters, waking one of them per single item and
+// all of them after a batch. Without it push() and pop() are not available
+// and the try_* operations touch nothing but the ring.
+
+namespace stdcpp {
+namespace v1 {
+namespace detail {
+inline std::size_t queue_capacity(std::size_t requested) noexcept {
+  std::size_t capacity = 2;
+  while (capacity < requested) {
+    capacity <<= 1;
+  }
+  return capacity;
+}
+
+template <class T>
+using queue_storage =
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+template <class T>
+struct queue_requirements {
+  static_assert(std::is_nothrow_move_constructible<T>::value &&
+                    std::is_nothrow_move_assignable<T>::value &&
+                    std::is_nothrow_destructible<T>::value,
+                "queue elements must be nothrow movable and destructible");
+};
+}  // namespace detail
+
+template <class T, bool Blocking = false>
+class spsc_queue : detail::queue_requirements<T> {
+ public:
+  using value_type = T;
+
+  explicit spsc_queue(std::size_t capacity)
+      : mask_(detail::queue_capacity(capacity) - 1),
+        slots_(new detail::queue_storage<T>[mask_ + 1]) {}
+
+  ~spsc_queue() {
+    for (std::size_t i = tail_.load(std::memory_order_relaxed),
+                     end = head_.load(std::memory_order_relaxed);
+         i != end; ++i) {
+      slot(i)->~T();
+    }
+  }
+
+  spsc_queue(const spsc_queue&) = delete;
+  spsc_queue& operator=(const spsc_queue&) = delete;
+
+  std::size_t capacity() const noexcept { return mask_ + 1; }
+
+  // Exact when called from the producer or consumer and nothing else runs.
+  std::size_t size_approx() const noexcept {
+    return head_.load(std::memory_order_acquire) -
+           tail_.load(std::memory_order_acquire);
+  }
+  bool empty() const noexcept { return size_approx() == 0; }
+
+  // Producer side.
+  bool try_push(const T& value) { return try_emplace(value); }
+  bool try_push(T&& value) { return try_emplace(std::move(value)); }
+
+  template <class... Args>
+  bool try_emplace(Args&&... args) {
+    const std::size_t head = head_.load(std::memory_order_relaxed);
+    if (free_slots(head, 1) == 0) {
+      return false;
+    }
+    // Nothing is published until head_ moves, so a throwing constructor
+    // leaves the queue unchanged.
+    ::new (static_cast<void*>(slot(head))) T(std::forward<Args>(args)...);
+    publish_head(head + 1);
+    return true;
+  }
+
+  // Moves up to n items from `first`, returning how many were taken.
+  template <class InputIt>
+  std::size_t try_push_n(InputIt first, std::size_t n) {
+    const std::size_t head = head_.load(std::memory_order_relaxed);
+    const std::size_t free = free_slots(head, n);
+    if (free < n) {
+      n = free;
+    }
+    std::size_t i = 0;
+    try {
+      for (; i < n; ++i, ++first) {
+        ::new (static_cast<void*>(slot(head + i))) T(std::move(*first));
+      }
+    } catch (...) {
+      if (i != 0) {
+        publish_head(head + i);
+      }
+      throw;
+    }
+    if (n != 0) {
+      publish_head(head + n);
+    }
+    return n;
+  }
+
+  // Consumer side.
+  bool try_pop(T& out) noexcept {
+    const std::size_t tail = tail_.load(std::memory_order_relaxed);
+    if (ready_slots(tail, 1) == 0) {
+      return false;
+    }
+    out = std::move(*slot(tail));
+    slot(tail)->~T();
+    publish_tail(tail + 1);
+    return true;
+  }
+
+  // Moves up to n items to `out`, returning how many were written.
+  template <class OutputIt>
+  std::size_t try_pop_n(OutputIt out, std::size_t n) {
+    const std::size_t tail = tail_.load(std::memory_order_relaxed);
+    const std::size_t ready = ready_slots(tail, n);
+    if (ready < n) {
+      n = ready;
+    }
+    for (std::size_t i = 0; i < n; ++i, ++out) {
+      *out = std::move(*slot(tail + i));
+      slot(tail + i)->~T();
+    }
+    if (n != 0) {
+      publish_tail(tail + n);
+    }
+    return n;
+  }
+
+  // Blocking operations, for spsc_queue<T, true> only.
+  void push(const T& value) { push_impl(value); }
+  void push(T&& value) { push_impl(std::move(value)); }
+
+  void pop(T& out) {
+    static_assert(Blocking, "pop() needs spsc_queue<T, true>");
+    for (;;) {
+      const std::size_t head = head_.load(std::memory_order_acquire);
+      if (try_pop(out)) {
+        return;
+      }
+      v1::atomic_wait_explicit(&head_, head, std::memory_order_acquire);
+    }
+  }
+
+ private:
+  template <class U>
+  void push_impl(U&& value) {
+    static_assert(Blocking, "push() needs spsc_queue<T, true>");
+    for (;;) {
+      const std::size_t tail = tail_.load(std::memory_order_acquire);
+      if (try_emplace(std::forward<U>(value))) {
+        return;
+      }
+      v1::atomic_wait_explicit(&tail_, tail, std::memory_order_acquire);
+    }
+  }
+
+  T* slot(std::size_t index) const noexcept {
+    return reinterpret_cast<T*>(&slots_[index & mask_]);
+  }
+
+  // The producer re-reads tail_ only when its cached copy shows fewer than
+  // `wanted` free slots, and the consumer likewise for head_, so in steady
+  // state neither touches the other's cache line.
+  std::size_t free_slots(std::size_t head, std::size_t wanted) noexcept {
+    std::size_t free = capacity() - (head - cached_tail_);
+    if (free < wanted) {
+      cached_tail_ = tail_.load(std::memory_order_acquire);
+      free = capacity() - (head - cached_tail_);
+    }
+    return free;
+  }
+
+  std::size_t ready_slots(std::size_t tail, std::size_t wanted) noexcept {
+    std::size_t ready = cached_head_ - tail;
+    if (ready < wanted) {
+      cached_head_ = head_.load(std::memory_order_acquire);
+      ready = cached_head_ - tail;
+    }
+    return ready;
+  }
+
+  void publish_head(std::size_t head) noexcept {
+    head_.store(head, std::memory_order_release);
+    if (Blocking) {
+      v1::atomic_notify_one(&head_);
+    }
+  }
+
+  void publish_tail(std::size_t tail) noexcept {
+    tail_.store(tail, std::memory_order_release);
+    if (Blocking) {
+      v1::atomic_notify_one(&tail_);
+    }
+  }
+
+  const std::size_t mask_;
+  const std::unique_ptr<detail::queue_storage<T>[]> slots_;
+  // Producer line: the next index to write and what it last saw of tail_.
+  alignas(detail::cache_line_size) std::atomic<std::size_t> head_{0};
+  std::size_t cached_tail_ = 0;
+  // Consumer line.
+  alignas(detail::cache_line_size) std::atomic<std::size_t> tail_{0};
+  std::size_t cached_head_ = 0;
+};
+
+template <class T, bool Blocking = false>
+class mpmc_queue : detail::queue_requirements<T> {
+ public:
+  using value_type = T;
+
+  explicit mpmc_queue(std::size_t capacity)
+      : mask_(detail::queue_capacity(capacity) - 1),
+        cells_(new cell[mask_ + 1]) {
+    for (std::size_t i = 0; i <= mask_; ++i) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  ~mpmc_queue() {
+    for (std::size_t i = dequeue_pos_.load(std::memory_order_relaxed),
+                     end = enqueue_pos_.load(std::memory_order_relaxed);
+         i != end; ++i) {
+      cells_[i & mask_].value()->~T();
+    }
+  }
+
+  mpmc_queue(const mpmc_queue&) = delete;
+  mpmc_queue& operator=(const mpmc_queue&) = delete;
+
+  std::size_t capacity() const noexcept { return mask_ + 1; }
+
+  std::size_t size_approx() const noexcept {
+    const std::size_t tail = dequeue_pos_.load(std::memory_order_acquire);
+    const std::size_t head = enqueue_pos_.load(std::memory_order_acquire);
+    return head > tail ? head - tail : 0;
+  }
+  bool empty() const noexcept { return size_approx() == 0; }
+
+  bool try_push(const T& value) { return try_emplace(value); }
+  bool try_push(T&& value) { return try_emplace(std::move(value)); }
+
+  // A claimed cell must be filled, so arguments that could throw while
+  // constructing T are turned into a T before claiming one.
+  template <class... Args>
+  bool try_emplace(Args&&... args) {
+    using nothrow = std::is_nothrow_constructible<T, Args...>;
+    return emplace(std::integral_constant<bool, nothrow::value>{},
+                   std::forward<Args>(args)...);
+  }
+
+  // Moves up to n items from `first` using one claim on the ring, returning
+  // how many were taken.
+  template <class InputIt>
+  std::size_t try_push_n(InputIt first, std::size_t n) {
+    static_assert(
+        std::is_nothrow_constructible<T, decltype(std::move(*first))>::value,
+        "claimed cells must be filled without throwing");
+    std::size_t pos;
+    n = claim(enqueue_pos_, 0, n, pos);
+    for (std::size_t i = 0; i < n; ++i, ++first) {
+      cell& c = cells_[(pos + i) & mask_];
+      ::new (static_cast<void*>(c.value())) T(std::move(*first));
+      c.sequence.store(pos + i + 1, std::memory_order_release);
+    }
+    if (n != 0) {
+      published(pushed_, n);
+    }
+    return n;
+  }
+
+  bool try_pop(T& out) noexcept {
+    std::size_t pos;
+    if (claim(dequeue_pos_, 1, 1, pos) == 0) {
+      return false;
+    }
+    take(pos, out);
+    published(popped_, 1);
+    return true;
+  }
+
+  // Moves up to n items to `out` using one claim on the ring, returning how
+  // many were written. Writing to `out` must not throw.
+  template <class OutputIt>
+  std::size_t try_pop_n(OutputIt out, std::size_t n) noexcept {
+    std::size_t pos;
+    n = claim(dequeue_pos_, 1, n, pos);
+    for (std::size_t i = 0; i < n; ++i, ++out) {
+      take(pos + i, *out);
+    }
+    if (n != 0) {
+      published(popped_, n);
+    }
+    return n;
+  }
+
+  // Blocking operations, for mpmc_queue<T, true> only.
+  void push(const T& value) { push_impl(value); }
+  void push(T&& value) { push_impl(std::move(value)); }
+
+  void pop(T& out) {
+    static_assert(Blocking, "pop() needs mpmc_queue<T, true>");
+    for (;;) {
+      const std::uint32_t pushed =
+          pushed_.value.load(std::memory_order_acquire);
+      if (try_pop(out)) {
+        return;
+      }
+      await(pushed_, pushed);
+    }
+  }
+
+ private:
+  // Bumped after each publish when Blocking, with the number of threads
+  // waiting for it to move.
+  struct wait_counter {
+    std::atomic<std::uint32_t> value{0};
+    std::atomic<std::uint32_t> waiters{0};
+  };
+
+  struct cell {
+    // pos while free for the producer of index pos, pos + 1 once it holds
+    // that item, pos + capacity once the consumer has emptied it again.
+    std::atomic<std::size_t> sequence;
+    detail::queue_storage<T> storage;
+
+    T* value() noexcept { return reinterpret_cast<T*>(&storage); }
+  };
+
+  template <class U>
+  void push_impl(U&& value) {
+    static_assert(Blocking, "push() needs mpmc_queue<T, true>");
+    for (;;) {
+      const std::uint32_t popped =
+          popped_.value.load(std::memory_order_acquire);
+      if (try_emplace(std::forward<U>(value))) {
+        return;
+      }
+      await(popped_, popped);
+    }
+  }
+
+  template <class... Args>
+  bool emplace(std::true_type, Args&&... args) noexcept {
+    std::size_t pos;
+    if (claim(enqueue_pos_, 0, 1, pos) == 0) {
+      return false;
+    }
+    cell& c = cells_[pos & mask_];
+    ::new (static_cast<void*>(c.value())) T(std::forward<Args>(args)...);
+    c.sequence.store(pos + 1, std::memory_order_release);
+    published(pushed_, 1);
+    return true;
+  }
+
+  template <class... Args>
+  bool emplace(std::false_type, Args&&... args) {
+    T value(std::forward<Args>(args)...);
+    return emplace(std::true_type{}, std::move(value));
+  }
+
+  template <class Out>
+  void take(std::size_t pos, Out&& out) noexcept {
+    cell& c = cells_[pos & mask_];
+    std::forward<Out>(out) = std::move(*c.value());
+    c.value()->~T();
+    c.sequence.store(pos + mask_ + 1, std::memory_order_release);
+  }
+
+  // Claims up to `n` consecutive indices starting at `pos_ref`, whose cells
+  // must have sequence == index + `lag` (0 for producers, 1 for consumers).
+  // Only those cells can be claimed, and claims serialize on one CAS, so
+  // the claimed cells stay ours until we publish them.
+  std::size_t claim(std::atomic<std::size_t>& pos_ref, std::size_t lag,
+                    std::size_t n, std::size_t& pos) noexcept {
+    if (n == 0) {
+      return 0;
+    }
+    pos = pos_ref.load(std::memory_order_relaxed);
+    for (;;) {
+      const std::size_t seq =
+          cells_[pos & mask_].sequence.load(std::memory_order_acquire);
+      const auto diff = static_cast<std::intptr_t>(seq) -
+                        static_cast<std::intptr_t>(pos + lag);
+      if (diff < 0) {
+        // Full (producer) or empty (consumer).
+        return 0;
+      }
+      if (diff > 0) {
+        // Another thread claimed this index first.
+        pos = pos_ref.load(std::memory_order_relaxed);
+        continue;
+      }
+      std::size_t count = 1;
+      while (count < n &&
+             cells_[(pos + count) & mask_].sequence.load(
+                 std::memory_order_acquire) == pos + count + lag) {
+        ++count;
+      }
+      if (pos_ref.compare_exchange_weak(pos, pos + count,
+                                        std::memory_order_relaxed,
+                                        std::memory_order_relaxed)) {
+        return count;
+      }
+    }
+  }
+
+  // The bump and the waiter count are read and written seq_cst on both
+  // sides, so either the publisher sees a waiter that registered or the
+  // waiter sees the bump and does not sleep.
+  void published(wait_counter& counter, std::size_t count) noexcept {
+    if (Blocking) {
+      counter.value.fetch_add(1, std::memory_order_seq_cst);
+      if (counter.waiters.load(std::memory_order_seq_cst) == 0) {
+        return;
+      }
+      if (count == 1) {
+        v1::atomic_notify_one(&counter.value);
+      } else {
+        v1::atomic_notify_all(&counter.value);
+      }
+    }
+  }
+
+  // Sleeps until `counter` moves on from `seen`.
+  static void await(wait_counter& counter, std::uint32_t seen) {
+    counter.waiters.fetch_add(1, std::memory_order_seq_cst);
+    v1::atomic_wait_explicit(&counter.value, seen, std::memory_order_seq_cst);
+    counter.waiters.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  const std::size_t mask_;
+  const std::unique_ptr<cell[]> cells_;
+  alignas(detail::cache_line_size) std::atomic<std::size_t> enqueue_pos_{0};
+  // Consumers wait on pushed_, producers on popped_.
+  wait_counter pushed_;
+  alignas(detail::cache_line_size) std::atomic<std::size_t> dequeue_pos_{0};
+  wait_counter popped_;
+};
+}  // namespace v1
+
+using v1::mpmc_queue;
+using v1::spsc_queue;
+}  // namespace stdcpp
+
+#endif  // __SCC_STDCPP_QUEUE_HPP__
@@ -4,46 +4,51 @@
 
 #include <utility.hpp>
 
+#include <array>
+#include <cstddef>
+#include <initializer_list>
 #include <iterator>
+#include <memory>
+#include <new>
+#include <tuple>
 #include <type_traits>
+#include <utility>
 
 namespace stdcpp {
 namespace v1 {
 namespace ranges {
-namespace views {}
-
 template <class T>
-constexpr auto begin(T&& r) -> decltype(auto) {
+constexpr auto begin(T&& r) -> decltype(std::begin(std::forward<T>(r))) {
   return std::begin(std::forward<T>(r));
 };
 
 template <class T>
-constexpr auto end(T&& r) -> decltype(auto) {
+constexpr auto end(T&& r) -> decltype(std::end(std::forward<T>(r))) {
   return std::end(std::forward<T>(r));
 };
 
 template <class T>
-constexpr auto cbegin(T&& r) -> decltype(auto) {
+constexpr auto cbegin(T&& r) -> decltype(std::cbegin(std::forward<T>(r))) {
   return std::cbegin(std::forward<T>(r));
 };
 
 template <class T>
-constexpr auto cend(T&& r) -> decltype(auto) {
+constexpr auto cend(T&& r) -> decltype(std::cend(std::forward<T>(r))) {
   return std::cend(std::forward<T>(r));
 };
 
 template <class T>
-constexpr auto rbegin(T&& r) -> decltype(auto) {
+constexpr auto rbegin(T&& r) -> decltype(std::rbegin(std::forward<T>(r))) {
   return std::rbegin(std::forward<T>(r));
 };
 
 template <class T>
-constexpr auto rend(T&& r) -> decltype(auto) {
+constexpr auto rend(T&& r) -> decltype(std::rend(std::forward<T>(r))) {
   return std::rend(std::forward<T>(r));
 };
 
 template <class T>
-constexpr auto size(T&& r) -> decltype(auto) {
+constexpr auto size(T&& r) -> decltype(r.size()) {
   return r.size();
 };
 
@@ -58,7 +63,7 @@ constexpr auto ssize(T&& r) -> decltype(auto) {
 };
 
 template <class T>
-constexpr auto empty(T&& r) -> decltype(auto) {
+constexpr auto empty(T&& r) -> decltype(r.empty()) {
   return r.empty();
 };
 
@@ -73,12 +78,12 @@ constexpr auto empty(std::initializer_list<T> il) noexcept {
 }
 
 template <class T>
-constexpr auto data(T&& r) -> decltype(auto) {
+constexpr auto data(T&& r) -> decltype(r.data()) {
   return r.data();
 };
 
 template <class T>
-constexpr auto data(const T& r) -> decltype(auto) {
+constexpr auto data(const T& r) -> decltype(r.data()) {
   return r.data();
 };
 
@@ -129,12 +134,4037 @@ using range_rvalue_reference_t = iter_rvalue_reference_t<iterator_t<R>>;
 
 template <class R>
 using range_common_reference_t = iter_common_reference_t<iterator_t<R>>;
-}  // namespace ranges
 
-// using views = ranges::views;
-}  // namespace v1
+// Views
+//
+// Views are cheap to copy and compute their elements lazily; adaptors in
+// ranges::views build them and compose with operator|:
+//
+//   auto squares = v | views::filter(is_odd) | views::transform(square);
+//
+// Functions and predicates are stored by value in the view, never behind
+// std::function, so a pipeline is one object whose calls can be inlined and
+// building it allocates nothing. Every view here is a common range: end()
+// returns the same type as begin(), as range-based for and the standard
+// algorithms require in C++14. Views over sized or random-access ranges
+// stay sized and random-access where the adaptor allows it.
+namespace detail {
+template <class R, class = void>
+struct is_range : std::false_type {};
 
-using namespace v1;
-}  // namespace stdcpp
+template <class R>
+struct is_range<R, void_t<decltype(ranges::begin(std::declval<R&>())),
+                          decltype(ranges::end(std::declval<R&>()))>>
+    : std::true_type {};
+
+template <class R, class = void>
+struct is_sized_range : std::false_type {};
+
+template <class R>
+struct is_sized_range<R, void_t<decltype(ranges::size(std::declval<R&>()))>>
+    : std::true_type {};
+
+// Ranges whose elements are contiguous in memory, i.e. with data().
+template <class R, class = void>
+struct is_contiguous_range : std::false_type {};
+
+template <class R>
+struct is_contiguous_range<
+    R, std::enable_if_t<std::is_pointer<
+           decltype(ranges::data(std::declval<R&>()))>::value>>
+    : std::true_type {};
+
+template <class R, class = void>
+struct is_common_range : std::false_type {};
+
+template <class R>
+struct is_common_range<R, std::enable_if_t<is_range<R>::value>>
+    : std::is_same<iterator_t<R>, sentinel_t<R>> {};
+
+template <class I>
+using iterator_category_t = typename std::iterator_traits<I>::iterator_category;
+
+// What the iterator can do, which for iterators yielding prvalues is more
+// than its iterator_category may claim, as with C++20's iterator_concept.
+template <class I, class = void>
+struct iterator_concept {
+  using type = iterator_category_t<I>;
+};
+
+template <class I>
+struct iterator_concept<I, void_t<typename I::iterator_concept>> {
+  using type = typename I::iterator_concept;
+};
+
+template <class I>
+using iterator_concept_t = typename iterator_concept<I>::type;
+
+template <class I, class Tag>
+using is_iterator_at_least = std::is_base_of<Tag, iterator_concept_t<I>>;
+
+// The weaker of two iterator categories.
+template <class A, class B>
+using weaker_category_t =
+    std::conditional_t<std::is_base_of<A, B>::value, A, B>;
+
+template <bool Const, class T>
+using maybe_const_t = std::conditional_t<Const, const T, T>;
+
+// Holds a function object and makes it copy-assignable, which lambdas are
+// not, so that views and their iterators stay assignable.
+template <class T>
+class copyable_box {
+ public:
+  explicit copyable_box(T value) noexcept(
+      std::is_nothrow_move_constructible<T>::value) {
+    ::new (static_cast<void*>(std::addressof(value_))) T(std::move(value));
+    engaged_ = true;
+  }
+  copyable_box(const copyable_box& other) { assign(other.get()); }
+  copyable_box(copyable_box&& other) noexcept(
+      std::is_nothrow_move_constructible<T>::value) {
+    assign(std::move(other.get()));
+  }
+  copyable_box& operator=(const copyable_box& other) {
+    if (this != &other) {
+      reset();
+      assign(other.get());
+    }
+    return *this;
+  }
+  copyable_box& operator=(copyable_box&& other) noexcept(
+      std::is_nothrow_move_constructible<T>::value) {
+    if (this != &other) {
+      reset();
+      assign(std::move(other.get()));
+    }
+    return *this;
+  }
+  ~copyable_box() { reset(); }
+
+  T& get() noexcept { return value_; }
+  const T& get() const noexcept { return value_; }
+  T& operator*() noexcept { return value_; }
+  const T& operator*() const noexcept { return value_; }
+
+ private:
+  template <class U>
+  void assign(U&& value) {
+    ::new (static_cast<void*>(std::addressof(value_)))
+        T(std::forward<U>(value));
+    engaged_ = true;
+  }
+
+  void reset() noexcept {
+    if (engaged_) {
+      value_.~T();
+      engaged_ = false;
+    }
+  }
+
+  // Empty only if a copy threw, as with std::optional.
+  union {
+    T value_;
+  };
+  bool engaged_ = false;
+};
+
+// A begin() remembered by views whose begin() is not O(1). Copies start
+// empty, since the iterator would point into the source view's base.
+template <class I>
+class cached_position {
+ public:
+  cached_position() = default;
+  cached_position(const cached_position&) noexcept {}
+  cached_position& operator=(const cached_position&) noexcept {
+    engaged_ = false;
+    return *this;
+  }
+
+  bool has_value() const noexcept { return engaged_; }
+  const I& get() const noexcept { return it_; }
+  void set(I it) {
+    it_ = std::move(it);
+    engaged_ = true;
+  }
+
+ private:
+  I it_{};
+  bool engaged_ = false;
+};
+
+template <class T>
+struct is_range_closure;
+
+// A range adaptor with its arguments bound: `r | closure` and `closure(r)`
+// apply it to r, and `closure | closure` composes two of them.
+template <class F>
+class range_closure {
+ public:
+  constexpr explicit range_closure(F f) : f_(std::move(f)) {}
+
+  template <class R>
+  constexpr auto operator()(R&& r) const
+      -> decltype(std::declval<const F&>()(std::forward<R>(r))) {
+    return f_(std::forward<R>(r));
+  }
+
+  template <class R, std::enable_if_t<
+                         !is_range_closure<std::decay_t<R>>::value, int> = 0>
+  friend constexpr auto operator|(R&& r, const range_closure& c)
+      -> decltype(c(std::forward<R>(r))) {
+    return c(std::forward<R>(r));
+  }
+
+ private:
+  F f_;
+};
+
+template <class T>
+struct is_range_closure : std::false_type {};
+
+template <class F>
+struct is_range_closure<range_closure<F>> : std::true_type {};
+
+template <class First, class Second>
+class composed_closure {
+ public:
+  constexpr composed_closure(First first, Second second)
+      : first_(std::move(first)), second_(std::move(second)) {}
+
+  template <class R>
+  constexpr auto operator()(R&& r) const
+      -> decltype(std::declval<const Second&>()(
+          std::declval<const First&>()(std::forward<R>(r)))) {
+    return second_(first_(std::forward<R>(r)));
+  }
+
+ private:
+  First first_;
+  Second second_;
+};
+
+template <class F, class G>
+constexpr range_closure<composed_closure<range_closure<F>, range_closure<G>>>
+operator|(range_closure<F> first, range_closure<G> second) {
+  return range_closure<composed_closure<range_closure<F>, range_closure<G>>>(
+      {std::move(first), std::move(second)});
+}
+
+// Adaptor `Fn` with its trailing arguments bound, as in views::filter(p).
+template <class Fn, class... Args>
+class bound_adaptor {
+  using args_type = std::tuple<Args...>;
+
+ public:
+  constexpr explicit bound_adaptor(Args... args) : args_(std::move(args)...) {}
+
+ private:
+  template <class R, std::size_t... I>
+  constexpr auto call(R&& r, std::index_sequence<I...>) const
+      -> decltype(Fn{}(std::forward<R>(r),
+                       std::get<I>(std::declval<const args_type&>())...)) {
+    return Fn{}(std::forward<R>(r), std::get<I>(args_)...);
+  }
+
+ public:
+  template <class R>
+  constexpr auto operator()(R&& r) const
+      -> decltype(this->call(std::forward<R>(r),
+                             std::index_sequence_for<Args...>{})) {
+    return call(std::forward<R>(r), std::index_sequence_for<Args...>{});
+  }
+
+ private:
+  args_type args_;
+};
+
+template <class Fn, class... Args>
+constexpr range_closure<bound_adaptor<Fn, std::decay_t<Args>...>> bind_adaptor(
+    Args&&... args) {
+  return range_closure<bound_adaptor<Fn, std::decay_t<Args>...>>(
+      bound_adaptor<Fn, std::decay_t<Args>...>(std::forward<Args>(args)...));
+}
+}  // namespace detail
+
+struct view_base {};
+
+template <class T>
+struct enable_view : std::is_base_of<view_base, T> {};
+
+// Members every view gets from its begin() and end(), as in C++20.
+template <class D>
+class view_interface : public view_base {
+ public:
+  template <class T = D>
+  constexpr auto empty()
+      -> decltype(ranges::begin(std::declval<T&>()) ==
+                  ranges::end(std::declval<T&>())) {
+    return ranges::begin(derived()) == ranges::end(derived());
+  }
+
+  template <class T = D, class = decltype(std::declval<T&>().empty())>
+  constexpr explicit operator bool() {
+    return !derived().empty();
+  }
+
+  template <class T = D>
+  constexpr auto front() -> decltype(*ranges::begin(std::declval<T&>())) {
+    return *ranges::begin(derived());
+  }
+
+  template <class T = D,
+            std::enable_if_t<
+                detail::is_iterator_at_least<
+                    iterator_t<T>, std::bidirectional_iterator_tag>::value,
+                int> = 0>
+  constexpr decltype(auto) back() {
+    // Not std::prev(), which goes by iterator_category.
+    auto last = ranges::end(derived());
+    --last;
+    return *last;
+  }
+
+  template <class T = D,
+            std::enable_if_t<
+                detail::is_iterator_at_least<
+                    iterator_t<T>, std::random_access_iterator_tag>::value,
+                int> = 0>
+  constexpr decltype(auto) operator[](range_difference_t<T> n) {
+    return ranges::begin(derived())[n];
+  }
+
+  template <class T = D,
+            std::enable_if_t<
+                detail::is_iterator_at_least<
+                    iterator_t<T>, std::random_access_iterator_tag>::value,
+                int> = 0>
+  constexpr auto size()
+      -> decltype(static_cast<std::size_t>(
+          ranges::end(std::declval<T&>()) -
+          ranges::begin(std::declval<T&>()))) {
+    return static_cast<std::size_t>(ranges::end(derived()) -
+                                    ranges::begin(derived()));
+  }
+
+ private:
+  constexpr D& derived() noexcept { return static_cast<D&>(*this); }
+};
+
+// A view of an lvalue range it does not own.
+template <class R>
+class ref_view : public view_interface<ref_view<R>> {
+ public:
+  constexpr ref_view(R& r) noexcept : r_(std::addressof(r)) {}
+
+  constexpr R& base() const noexcept { return *r_; }
+
+  constexpr iterator_t<R> begin() const { return ranges::begin(*r_); }
+  constexpr sentinel_t<R> end() const { return ranges::end(*r_); }
+
+  template <class T = R>
+  constexpr auto size() const -> decltype(ranges::size(std::declval<T&>())) {
+    return ranges::size(*r_);
+  }
+
+  template <class T = R>
+  constexpr auto data() const -> decltype(ranges::data(std::declval<T&>())) {
+    return ranges::data(*r_);
+  }
+
+ private:
+  R* r_;
+};
+
+// A view that owns a range moved into it; move-only, like C++20's.
+template <class R>
+class owning_view : public view_interface<owning_view<R>> {
+ public:
+  constexpr owning_view(R&& r) : r_(std::move(r)) {}
+  owning_view(owning_view&&) = default;
+  owning_view& operator=(owning_view&&) = default;
+
+  constexpr R& base() & noexcept { return r_; }
+  constexpr const R& base() const& noexcept { return r_; }
+  constexpr R&& base() && noexcept { return std::move(r_); }
+
+  constexpr iterator_t<R> begin() { return ranges::begin(r_); }
+  constexpr sentinel_t<R> end() { return ranges::end(r_); }
+
+  template <class T = const R,
+            std::enable_if_t<detail::is_range<T>::value, int> = 0>
+  constexpr iterator_t<T> begin() const {
+    return ranges::begin(r_);
+  }
+  template <class T = const R,
+            std::enable_if_t<detail::is_range<T>::value, int> = 0>
+  constexpr sentinel_t<T> end() const {
+    return ranges::end(r_);
+  }
+
+  template <class T = R>
+  constexpr auto size() -> decltype(ranges::size(std::declval<T&>())) {
+    return ranges::size(r_);
+  }
+  template <class T = const R>
+  constexpr auto size() const -> decltype(ranges::size(std::declval<T&>())) {
+    return ranges::size(r_);
+  }
+
+  template <class T = R>
+  constexpr auto data() -> decltype(ranges::data(std::declval<T&>())) {
+    return ranges::data(r_);
+  }
+  template <class T = const R>
+  constexpr auto data() const -> decltype(ranges::data(std::declval<T&>())) {
+    return ranges::data(r_);
+  }
+
+ private:
+  R r_;
+};
+
+namespace views {
+namespace detail {
+struct all_fn {
+  template <class R, std::enable_if_t<enable_view<std::decay_t<R>>::value,
+                                      int> = 0>
+  constexpr std::decay_t<R> operator()(R&& r) const {
+    return std::forward<R>(r);
+  }
+
+  template <class R,
+            std::enable_if_t<!enable_view<std::decay_t<R>>::value &&
+                                 std::is_lvalue_reference<R>::value,
+                             int> = 0>
+  constexpr ref_view<std::remove_reference_t<R>> operator()(R&& r) const {
+    return ref_view<std::remove_reference_t<R>>(r);
+  }
+
+  template <class R,
+            std::enable_if_t<!enable_view<std::decay_t<R>>::value &&
+                                 !std::is_lvalue_reference<R>::value,
+                             int> = 0>
+  constexpr owning_view<R> operator()(R&& r) const {
+    return owning_view<R>(std::move(r));
+  }
+};
+}  // namespace detail
+
+// The range itself if it is a view, else a view of it: ref_view for lvalues
+// and owning_view for rvalues.
+constexpr ranges::detail::range_closure<detail::all_fn> all{
+    detail::all_fn{}};
+
+template <class R>
+using all_t = decltype(all(std::declval<R>()));
+}  // namespace views
+
+// The elements of V that satisfy Pred, found as the view is iterated.
+// Like the other views here, it is common when V is, and unbounded with
+// unreachable_sentinel as its end when V is.
+template <class V, class Pred>
+class filter_view : public view_interface<filter_view<V, Pred>> {
+ public:
+  class iterator;
+
+  filter_view(V base, Pred pred)
+      : base_(std::move(base)), pred_(std::move(pred)) {}
+
+  V base() const& { return base_; }
+  V base() && { return std::move(base_); }
+  const Pred& pred() const noexcept { return *pred_; }
+
+  // Amortized O(1): the first match is found once and cached.
+  iterator begin() {
+    if (!begin_.has_value()) {
+      begin_.set(find_next(ranges::begin(base_)));
+    }
+    return iterator(*this, begin_.get());
+  }
+
+  template <class T = V,
+            std::enable_if_t<ranges::detail::is_common_range<T>::value,
+                             int> = 0>
+  iterator end() {
+    return iterator(*this, ranges::end(base_));
+  }
+  template <class T = V,
+            std::enable_if_t<!ranges::detail::is_common_range<T>::value,
+                             int> = 0>
+  sentinel_t<T> end() {
+    return ranges::end(base_);
+  }
+
+ private:
+  iterator_t<V> find_next(iterator_t<V> it) {
+    const sentinel_t<V> last = ranges::end(base_);
+    while (it != last && !(*pred_)(*it)) {
+      ++it;
+    }
+    return it;
+  }
+
+  V base_;
+  ranges::detail::copyable_box<Pred> pred_;
+  ranges::detail::cached_position<iterator_t<V>> begin_;
+};
+
+template <class V, class Pred>
+class filter_view<V, Pred>::iterator {
+ public:
+  using iterator_concept = ranges::detail::weaker_category_t<
+      std::bidirectional_iterator_tag,
+      ranges::detail::iterator_concept_t<iterator_t<V>>>;
+  using iterator_category = ranges::detail::weaker_category_t<
+      std::bidirectional_iterator_tag,
+      ranges::detail::iterator_category_t<iterator_t<V>>>;
+  using value_type = range_value_t<V>;
+  using difference_type = range_difference_t<V>;
+  using reference = range_reference_t<V>;
+  using pointer = void;
+
+  iterator() = default;
+  iterator(filter_view& parent, iterator_t<V> current)
+      : current_(std::move(current)), parent_(std::addressof(parent)) {}
+
+  const iterator_t<V>& base() const& noexcept { return current_; }
+  iterator_t<V> base() && { return std::move(current_); }
+
+  reference operator*() const { return *current_; }
+
+  iterator& operator++() {
+    current_ = parent_->find_next(++current_);
+    return *this;
+  }
+  iterator operator++(int) {
+    iterator tmp = *this;
+    ++*this;
+    return tmp;
+  }
+
+  iterator& operator--() {
+    do {
+      --current_;
+    } while (!(*parent_->pred_)(*current_));
+    return *this;
+  }
+  iterator operator--(int) {
+    iterator tmp = *this;
+    --*this;
+    return tmp;
+  }
+
+  friend bool operator==(const iterator& a, const iterator& b) {
+    return a.current_ == b.current_;
+  }
+  friend bool operator!=(const iterator& a, const iterator& b) {
+    return !(a == b);
+  }
+
+ private:
+  iterator_t<V> current_{};
+  filter_view* parent_ = nullptr;
+};
+
+// The elements of V mapped through F, computed on every dereference.
+template <class V, class F>
+class transform_view : public view_interface<transform_view<V, F>> {
+  template <bool Const>
+  class iterator_impl;
+
+ public:
+  using iterator = iterator_impl<false>;
+  using const_iterator = iterator_impl<true>;
+
+  transform_view(V base, F fun)
+      : base_(std::move(base)), fun_(std::move(fun)) {}
+
+  V base() const& { return base_; }
+  V base() && { return std::move(base_); }
+
+  iterator begin() { return iterator(*this, ranges::begin(base_)); }
+
+  template <class T = V,
+            std::enable_if_t<ranges::detail::is_common_range<T>::value,
+                             int> = 0>
+  iterator end() {
+    return iterator(*this, ranges::end(base_));
+  }
+  template <class T = V,
+            std::enable_if_t<!ranges::detail::is_common_range<T>::value,
+                             int> = 0>
+  sentinel_t<T> end() {
+    return ranges::end(base_);
+  }
+
+  template <class T = const V,
+            std::enable_if_t<ranges::detail::is_range<T>::value, int> = 0>
+  iterator_impl<true> begin() const {
+    return iterator_impl<true>(*this, ranges::begin(base_));
+  }
+  template <class T = const V,
+            std::enable_if_t<ranges::detail::is_common_range<T>::value,
+                             int> = 0>
+  iterator_impl<true> end() const {
+    return iterator_impl<true>(*this, ranges::end(base_));
+  }
+  template <class T = const V,
+            std::enable_if_t<ranges::detail::is_range<T>::value &&
+                                 !ranges::detail::is_common_range<T>::value,
+                             int> = 0>
+  sentinel_t<T> end() const {
+    return ranges::end(base_);
+  }
+
+  template <class T = V>
+  auto size() -> decltype(ranges::size(std::declval<T&>())) {
+    return ranges::size(base_);
+  }
+  template <class T = const V>
+  auto size() const -> decltype(ranges::size(std::declval<T&>())) {
+    return ranges::size(base_);
+  }
+
+ private:
+  V base_;
+  ranges::detail::copyable_box<F> fun_;
+};
+
+template <class V, class F>
+template <bool Const>
+class transform_view<V, F>::iterator_impl {
+  using parent_type = ranges::detail::maybe_const_t<Const, transform_view>;
+  using base_type = ranges::detail::maybe_const_t<Const, V>;
+  using base_iterator = iterator_t<base_type>;
+
+ public:
+  using reference = decltype(std::declval<const F&>()(
+      *std::declval<const base_iterator&>()));
+  using iterator_concept = ranges::detail::iterator_concept_t<base_iterator>;
+  // Like C++20: only iterators yielding lvalues keep the base's category.
+  using iterator_category = std::conditional_t<
+      std::is_lvalue_reference<reference>::value,
+      ranges::detail::iterator_category_t<base_iterator>,
+      std::input_iterator_tag>;
+  using value_type = std::remove_cv_t<std::remove_reference_t<reference>>;
+  using difference_type = iter_difference_t<base_iterator>;
+  using pointer = void;
+
+  iterator_impl() = default;
+  iterator_impl(parent_type& parent, base_iterator current)
+      : current_(std::move(current)), parent_(std::addressof(parent)) {}
+  template <bool C = Const, std::enable_if_t<C, int> = 0>
+  iterator_impl(iterator_impl<false> other)
+      : current_(std::move(other.current_)), parent_(other.parent_) {}
+
+  const base_iterator& base() const& noexcept { return current_; }
+  base_iterator base() && { return std::move(current_); }
+
+  reference operator*() const { return (*parent_->fun_)(*current_); }
+  reference operator[](difference_type n) const {
+    return (*parent_->fun_)(current_[n]);
+  }
+
+  iterator_impl& operator++() {
+    ++current_;
+    return *this;
+  }
+  iterator_impl operator++(int) {
+    iterator_impl tmp = *this;
+    ++current_;
+    return tmp;
+  }
+  iterator_impl& operator--() {
+    --current_;
+    return *this;
+  }
+  iterator_impl operator--(int) {
+    iterator_impl tmp = *this;
+    --current_;
+    return tmp;
+  }
+  iterator_impl& operator+=(difference_type n) {
+    current_ += n;
+    return *this;
+  }
+  iterator_impl& operator-=(difference_type n) {
+    current_ -= n;
+    return *this;
+  }
+
+  friend iterator_impl operator+(iterator_impl it, difference_type n) {
+    return it += n;
+  }
+  friend iterator_impl operator+(difference_type n, iterator_impl it) {
+    return it += n;
+  }
+  friend iterator_impl operator-(iterator_impl it, difference_type n) {
+    return it -= n;
+  }
+  friend difference_type operator-(const iterator_impl& a,
+                                   const iterator_impl& b) {
+    return a.current_ - b.current_;
+  }
+
+  friend bool operator==(const iterator_impl& a, const iterator_impl& b) {
+    return a.current_ == b.current_;
+  }
+  friend bool operator!=(const iterator_impl& a, const iterator_impl& b) {
+    return !(a == b);
+  }
+  friend bool operator<(const iterator_impl& a, const iterator_impl& b) {
+    return a.current_ < b.current_;
+  }
+  friend bool operator>(const iterator_impl& a, const iterator_impl& b) {
+    return b < a;
+  }
+  friend bool operator<=(const iterator_impl& a, const iterator_impl& b) {
+    return !(b < a);
+  }
+  friend bool operator>=(const iterator_impl& a, const iterator_impl& b) {
+    return !(a < b);
+  }
+
+ private:
+  friend class iterator_impl<!Const>;
+
+  base_iterator current_{};
+  parent_type* parent_ = nullptr;
+};
+
+namespace views {
+namespace detail {
+struct filter_fn {
+  template <class R, class Pred>
+  constexpr filter_view<all_t<R>, std::decay_t<Pred>> operator()(
+      R&& r, Pred&& pred) const {
+    return filter_view<all_t<R>, std::decay_t<Pred>>(
+        all(std::forward<R>(r)), std::forward<Pred>(pred));
+  }
+
+  template <class Pred>
+  constexpr auto operator()(Pred&& pred) const {
+    return ranges::detail::bind_adaptor<filter_fn>(std::forward<Pred>(pred));
+  }
+};
+
+struct transform_fn {
+  template <class R, class F>
+  constexpr transform_view<all_t<R>, std::decay_t<F>> operator()(
+      R&& r, F&& fun) const {
+    return transform_view<all_t<R>, std::decay_t<F>>(all(std::forward<R>(r)),
+                                                     std::forward<F>(fun));
+  }
+
+  template <class F>
+  constexpr auto operator()(F&& fun) const {
+    return ranges::detail::bind_adaptor<transform_fn>(std::forward<F>(fun));
+  }
+};
+}  // namespace detail
+
+constexpr detail::filter_fn filter{};
+constexpr detail::transform_fn transform{};
+}  // namespace views
+
+namespace detail {
+template <class R>
+using is_random_access_range =
+    is_iterator_at_least<iterator_t<R>, std::random_access_iterator_tag>;
+
+template <class R>
+using has_unreachable_end =
+    std::is_same<sentinel_t<R>, unreachable_sentinel_t>;
+
+// Random-access ranges that are sized or unbounded, whose end is known
+// without walking them.
+template <class R, class = void>
+struct is_indexable_range : std::false_type {};
+
+template <class R>
+struct is_indexable_range<R, std::enable_if_t<is_range<R>::value>>
+    : std::integral_constant<bool, is_random_access_range<R>::value &&
+                                       (is_sized_range<R>::value ||
+                                        has_unreachable_end<R>::value)> {};
+
+// min(n, ranges::size(r)), or n for unbounded ranges.
+template <class R>
+std::size_t size_at_most(R& r, std::size_t n, std::true_type /* sized */) {
+  const std::size_t size = ranges::size(r);
+  return n < size ? n : size;
+}
+
+template <class R>
+std::size_t size_at_most(R&, std::size_t n, std::false_type /* sized */) {
+  return n;
+}
+}  // namespace detail
+
+// An iterator-sentinel pair as a view.
+template <class I, class S = I>
+class subrange : public view_interface<subrange<I, S>> {
+ public:
+  subrange() = default;
+  constexpr subrange(I first, S last)
+      : first_(std::move(first)), last_(std::move(last)) {}
+
+  constexpr I begin() const { return first_; }
+  constexpr S end() const { return last_; }
+  constexpr bool empty() const { return first_ == last_; }
+
+  template <class J = I>
+  constexpr auto size() const -> decltype(static_cast<std::size_t>(
+      std::declval<const S&>() - std::declval<const J&>())) {
+    return static_cast<std::size_t>(last_ - first_);
+  }
+
+  template <class J = I, std::enable_if_t<std::is_pointer<J>::value, int> = 0>
+  constexpr J data() const {
+    return first_;
+  }
+
+ private:
+  I first_{};
+  S last_{};
+};
+
+// One value as a range of one element.
+template <class T>
+class single_view : public view_interface<single_view<T>> {
+ public:
+  single_view() = default;
+  constexpr explicit single_view(T value) : value_(std::move(value)) {}
+
+  T* begin() noexcept { return data(); }
+  T* end() noexcept { return data() + 1; }
+  constexpr const T* begin() const noexcept { return data(); }
+  constexpr const T* end() const noexcept { return data() + 1; }
+
+  static constexpr std::size_t size() noexcept { return 1; }
+  T* data() noexcept { return std::addressof(value_); }
+  constexpr const T* data() const noexcept { return std::addressof(value_); }
+
+ private:
+  T value_{};
+};
+
+// The values value, value + 1, ... up to bound, excluded, or without end.
+// Random access for integral W.
+template <class W, class Bound = unreachable_sentinel_t>
+class iota_view : public view_interface<iota_view<W, Bound>> {
+  static_assert(std::is_same<Bound, W>::value ||
+                    std::is_same<Bound, unreachable_sentinel_t>::value,
+                "the bound must have the type of the values");
+
+ public:
+  class iterator;
+
+  iota_view() = default;
+  constexpr explicit iota_view(W value) : value_(value) {}
+  constexpr iota_view(W value, Bound bound) : value_(value), bound_(bound) {}
+
+  constexpr iterator begin() const { return iterator(value_); }
+
+  template <class B = Bound,
+            std::enable_if_t<std::is_same<B, W>::value, int> = 0>
+  constexpr iterator end() const {
+    return iterator(bound_);
+  }
+  template <class B = Bound,
+            std::enable_if_t<!std::is_same<B, W>::value, int> = 0>
+  constexpr unreachable_sentinel_t end() const {
+    return {};
+  }
+
+  template <class B = Bound,
+            std::enable_if_t<std::is_same<B, W>::value &&
+                                 std::is_integral<W>::value,
+                             int> = 0>
+  constexpr std::size_t size() const {
+    return static_cast<std::size_t>(bound_ - value_);
+  }
+
+ private:
+  W value_{};
+  Bound bound_{};
+};
+
+template <class W, class Bound>
+class iota_view<W, Bound>::iterator {
+ public:
+  using iterator_concept =
+      std::conditional_t<std::is_integral<W>::value,
+                         std::random_access_iterator_tag,
+                         std::forward_iterator_tag>;
+  using iterator_category = std::input_iterator_tag;
+  using value_type = W;
+  using difference_type = std::ptrdiff_t;
+  using reference = W;
+  using pointer = void;
+
+  iterator() = default;
+  constexpr explicit iterator(W value) : value_(value) {}
+
+  constexpr W operator*() const { return value_; }
+  constexpr W operator[](difference_type n) const {
+    return static_cast<W>(value_ + n);
+  }
+
+  constexpr iterator& operator++() {
+    ++value_;
+    return *this;
+  }
+  constexpr iterator operator++(int) {
+    iterator tmp = *this;
+    ++value_;
+    return tmp;
+  }
+  constexpr iterator& operator--() {
+    --value_;
+    return *this;
+  }
+  constexpr iterator operator--(int) {
+    iterator tmp = *this;
+    --value_;
+    return tmp;
+  }
+  constexpr iterator& operator+=(difference_type n) {
+    value_ = static_cast<W>(value_ + n);
+    return *this;
+  }
+  constexpr iterator& operator-=(difference_type n) {
+    value_ = static_cast<W>(value_ - n);
+    return *this;
+  }
+
+  friend constexpr iterator operator+(iterator it, difference_type n) {
+    return it += n;
+  }
+  friend constexpr iterator operator+(difference_type n, iterator it) {
+    return it += n;
+  }
+  friend constexpr iterator operator-(iterator it, difference_type n) {
+    return it -= n;
+  }
+  friend constexpr difference_type operator-(const iterator& a,
+                                             const iterator& b) {
+    return static_cast<difference_type>(a.value_) -
+           static_cast<difference_type>(b.value_);
+  }
+
+  friend constexpr bool operator==(const iterator& a, const iterator& b) {
+    return a.value_ == b.value_;
+  }
+  friend constexpr bool operator!=(const iterator& a, const iterator& b) {
+    return !(a == b);
+  }
+  friend constexpr bool operator<(const iterator& a, const iterator& b) {
+    return a.value_ < b.value_;
+  }
+  friend constexpr bool operator>(const iterator& a, const iterator& b) {
+    return b < a;
+  }
+  friend constexpr bool operator<=(const iterator& a, const iterator& b) {
+    return !(b < a);
+  }
+  friend constexpr bool operator>=(const iterator& a, const iterator& b) {
+    return !(a < b);
+  }
+
+ private:
+  W value_{};
+};
+
+// The first `count` elements of V. Over random-access ranges that are
+// sized or unbounded the iterators are V's own, so the result stays random
+// access, sized and, for contiguous V, has data().
+template <class V, bool = detail::is_indexable_range<V>::value>
+class take_view;
+
+template <class V>
+class take_view<V, true> : public view_interface<take_view<V, true>> {
+ public:
+  take_view(V base, range_difference_t<V> count)
+      : base_(std::move(base)), count_(count) {}
+
+  V base() const& { return base_; }
+  V base() && { return std::move(base_); }
+
+  iterator_t<V> begin() { return ranges::begin(base_); }
+  iterator_t<V> end() { return end_of(base_); }
+
+  template <class T = const V,
+            std::enable_if_t<detail::is_indexable_range<T>::value, int> = 0>
+  iterator_t<T> begin() const {
+    return ranges::begin(base_);
+  }
+  template <class T = const V,
+            std::enable_if_t<detail::is_indexable_range<T>::value, int> = 0>
+  iterator_t<T> end() const {
+    return end_of(base_);
+  }
+
+  std::size_t size() { return size_of(base_); }
+  template <class T = const V,
+            std::enable_if_t<detail::is_indexable_range<T>::value, int> = 0>
+  std::size_t size() const {
+    return size_of(base_);
+  }
+
+  template <class T = V>
+  auto data() -> decltype(ranges::data(std::declval<T&>())) {
+    return ranges::data(base_);
+  }
+  template <class T = const V>
+  auto data() const -> decltype(ranges::data(std::declval<T&>())) {
+    return ranges::data(base_);
+  }
+
+ private:
+  template <class B>
+  std::size_t size_of(B& base) const {
+    return detail::size_at_most(base, static_cast<std::size_t>(count_),
+                                detail::is_sized_range<B>{});
+  }
+
+  template <class B>
+  iterator_t<B> end_of(B& base) const {
+    return ranges::begin(base) +
+           static_cast<range_difference_t<B>>(size_of(base));
+  }
+
+  V base_;
+  range_difference_t<V> count_;
+};
+
+template <class V>
+class take_view<V, false> : public view_interface<take_view<V, false>> {
+ public:
+  class iterator;
+
+  take_view(V base, range_difference_t<V> count)
+      : base_(std::move(base)), count_(count) {}
+
+  V base() const& { return base_; }
+  V base() && { return std::move(base_); }
+
+  iterator begin() {
+    return iterator(ranges::begin(base_), count_, ranges::end(base_));
+  }
+  iterator end() { return iterator(); }
+
+  template <class T = V>
+  auto size() -> decltype(ranges::size(std::declval<T&>())) {
+    return detail::size_at_most(base_, static_cast<std::size_t>(count_),
+                                std::true_type{});
+  }
+
+ private:
+  V base_;
+  range_difference_t<V> count_;
+};
+
+template <class V>
+class take_view<V, false>::iterator {
+ public:
+  using iterator_concept =
+      detail::weaker_category_t<std::forward_iterator_tag,
+                                detail::iterator_concept_t<iterator_t<V>>>;
+  using iterator_category =
+      detail::weaker_category_t<std::forward_iterator_tag,
+                                detail::iterator_category_t<iterator_t<V>>>;
+  using value_type = range_value_t<V>;
+  using difference_type = range_difference_t<V>;
+  using reference = range_reference_t<V>;
+  using pointer = void;
+
+  // The end iterator.
+  iterator() = default;
+  iterator(iterator_t<V> current, difference_type count, sentinel_t<V> end)
+      : current_(std::move(current)), count_(count), end_(std::move(end)) {}
+
+  const iterator_t<V>& base() const& noexcept { return current_; }
+
+  reference operator*() const { return *current_; }
+
+  iterator& operator++() {
+    ++current_;
+    --count_;
+    return *this;
+  }
+  iterator operator++(int) {
+    iterator tmp = *this;
+    ++*this;
+    return tmp;
+  }
+
+  friend bool operator==(const iterator& a, const iterator& b) {
+    const bool a_done = a.done();
+    const bool b_done = b.done();
+    return a_done || b_done ? a_done == b_done : a.current_ == b.current_;
+  }
+  friend bool operator!=(const iterator& a, const iterator& b) {
+    return !(a == b);
+  }
+
+ private:
+  bool done() const { return count_ <= 0 || current_ == end_; }
+
+  iterator_t<V> current_{};
+  difference_type count_ = 0;
+  sentinel_t<V> end_{};
+};
+
+// V without its first `count` elements. O(1) on random-access ranges that
+// are sized or unbounded; otherwise begin() walks once and is cached.
+template <class V>
+class drop_view : public view_interface<drop_view<V>> {
+ public:
+  drop_view(V base, range_difference_t<V> count)
+      : base_(std::move(base)), count_(count) {}
+
+  V base() const& { return base_; }
+  V base() && { return std::move(base_); }
+
+  iterator_t<V> begin() {
+    return begin_of(base_, detail::is_indexable_range<V>{});
+  }
+  sentinel_t<V> end() { return ranges::end(base_); }
+
+  template <class T = const V,
+            std::enable_if_t<detail::is_indexable_range<T>::value, int> = 0>
+  iterator_t<T> begin() const {
+    return begin_of(base_, std::true_type{});
+  }
+  template <class T = const V,
+            std::enable_if_t<detail::is_indexable_range<T>::value, int> = 0>
+  sentinel_t<T> end() const {
+    return ranges::end(base_);
+  }
+
+  template <class T = V>
+  auto size() -> decltype(ranges::size(std::declval<T&>())) {
+    return ranges::size(base_) - offset(base_);
+  }
+  template <class T = const V>
+  auto size() const -> decltype(ranges::size(std::declval<T&>())) {
+    return ranges::size(base_) - offset(base_);
+  }
+
+  template <class T = V,
+            std::enable_if_t<detail::is_sized_range<T>::value, int> = 0>
+  auto data() -> decltype(ranges::data(std::declval<T&>())) {
+    return ranges::data(base_) + offset(base_);
+  }
+  template <class T = const V,
+            std::enable_if_t<detail::is_sized_range<T>::value, int> = 0>
+  auto data() const -> decltype(ranges::data(std::declval<T&>())) {
+    return ranges::data(base_) + offset(base_);
+  }
+
+ private:
+  template <class B>
+  std::size_t offset(B& base) const {
+    return detail::size_at_most(base, static_cast<std::size_t>(count_),
+                                detail::is_sized_range<B>{});
+  }
+
+  template <class B>
+  iterator_t<B> begin_of(B& base, std::true_type /* indexable */) const {
+    return ranges::begin(base) +
+           static_cast<range_difference_t<B>>(offset(base));
+  }
+
+  iterator_t<V> begin_of(V& base, std::false_type /* indexable */) {
+    if (!begin_.has_value()) {
+      iterator_t<V> it = ranges::begin(base);
+      const sentinel_t<V> last = ranges::end(base);
+      for (range_difference_t<V> n = count_; n > 0 && it != last; --n) {
+        ++it;
+      }
+      begin_.set(std::move(it));
+    }
+    return begin_.get();
+  }
+
+  V base_;
+  range_difference_t<V> count_;
+  detail::cached_position<iterator_t<V>> begin_;
+};
+
+// The leading elements of V that satisfy Pred.
+template <class V, class Pred>
+class take_while_view : public view_interface<take_while_view<V, Pred>> {
+ public:
+  class iterator;
+
+  take_while_view(V base, Pred pred)
+      : base_(std::move(base)), pred_(std::move(pred)) {}
+
+  V base() const& { return base_; }
+  V base() && { return std::move(base_); }
+  const Pred& pred() const noexcept { return *pred_; }
+
+  iterator begin() {
+    return iterator(ranges::begin(base_), ranges::end(base_), *this);
+  }
+  iterator end() { return iterator(); }
+
+ private:
+  V base_;
+  detail::copyable_box<Pred> pred_;
+};
+
+template <class V, class Pred>
+class take_while_view<V, Pred>::iterator {
+ public:
+  using iterator_concept =
+      detail::weaker_category_t<std::forward_iterator_tag,
+                                detail::iterator_concept_t<iterator_t<V>>>;
+  using iterator_category =
+      detail::weaker_category_t<std::forward_iterator_tag,
+                                detail::iterator_category_t<iterator_t<V>>>;
+  using value_type = range_value_t<V>;
+  using difference_type = range_difference_t<V>;
+  using reference = range_reference_t<V>;
+  using pointer = void;
+
+  // The end iterator.
+  iterator() = default;
+  iterator(iterator_t<V> current, sentinel_t<V> end, take_while_view& parent)
+      : current_(std::move(current)),
+        end_(std::move(end)),
+        parent_(std::addressof(parent)) {}
+
+  const iterator_t<V>& base() const& noexcept { return current_; }
+
+  reference operator*() const { return *current_; }
+
+  iterator& operator++() {
+    ++current_;
+    return *this;
+  }
+  iterator operator++(int) {
+    iterator tmp = *this;
+    ++current_;
+    return tmp;
+  }
+
+  friend bool operator==(const iterator& a, const iterator& b) {
+    const bool a_done = a.done();
+    const bool b_done = b.done();
+    return a_done || b_done ? a_done == b_done : a.current_ == b.current_;
+  }
+  friend bool operator!=(const iterator& a, const iterator& b) {
+    return !(a == b);
+  }
+
+ private:
+  bool done() const {
+    return parent_ == nullptr || current_ == end_ ||
+           !(*parent_->pred_)(*current_);
+  }
+
+  iterator_t<V> current_{};
+  sentinel_t<V> end_{};
+  take_while_view* parent_ = nullptr;
+};
+
+// V from its first element that does not satisfy Pred. begin() is found
+// once and cached; the iterators are V's own.
+template <class V, class Pred>
+class drop_while_view : public view_interface<drop_while_view<V, Pred>> {
+ public:
+  drop_while_view(V base, Pred pred)
+      : base_(std::move(base)), pred_(std::move(pred)) {}
+
+  V base() const& { return base_; }
+  V base() && { return std::move(base_); }
+  const Pred& pred() const noexcept { return *pred_; }
+
+  iterator_t<V> begin() {
+    if (!begin_.has_value()) {
+      iterator_t<V> it = ranges::begin(base_);
+      const sentinel_t<V> last = ranges::end(base_);
+      while (it != last && (*pred_)(*it)) {
+        ++it;
+      }
+      begin_.set(std::move(it));
+    }
+    return begin_.get();
+  }
+  sentinel_t<V> end() { return ranges::end(base_); }
+
+  template <class T = V,
+            std::enable_if_t<detail::is_random_access_range<T>::value, int> = 0>
+  auto data() -> decltype(ranges::data(std::declval<T&>())) {
+    return ranges::data(base_) + (begin() - ranges::begin(base_));
+  }
+
+ private:
+  V base_;
+  detail::copyable_box<Pred> pred_;
+  detail::cached_position<iterator_t<V>> begin_;
+};
+
+namespace detail {
+template <bool... B>
+using all_of = std::is_same<std::integer_sequence<bool, true, B...>,
+                            std::integer_sequence<bool, B..., true>>;
+
+template <bool... B>
+using any_of = std::integral_constant<bool, !all_of<!B...>::value>;
+
+// The weakest of several iterator categories.
+template <class Tag, class... Tags>
+struct weakest_category {
+  using type = Tag;
+};
+
+template <class Tag, class Next, class... Tags>
+struct weakest_category<Tag, Next, Tags...>
+    : weakest_category<weaker_category_t<Tag, Next>, Tags...> {};
+
+template <class Tuple, class F, std::size_t... I>
+auto tuple_transform(Tuple& t, F& f, std::index_sequence<I...>) {
+  return std::tuple<decltype(f(std::get<I>(t)))...>(f(std::get<I>(t))...);
+}
+
+// The tuple of f applied to each element of t.
+template <class Tuple, class F>
+auto tuple_transform(Tuple& t, F f) {
+  return tuple_transform(
+      t, f,
+      std::make_index_sequence<std::tuple_size<std::decay_t<Tuple>>::value>{});
+}
+
+template <class Tuple, class F, std::size_t... I>
+void tuple_for_each(Tuple& t, F& f, std::index_sequence<I...>) {
+  (void)std::initializer_list<int>{(void(f(std::get<I>(t))), 0)...};
+}
+
+template <class Tuple, class F>
+void tuple_for_each(Tuple& t, F f) {
+  tuple_for_each(
+      t, f,
+      std::make_index_sequence<std::tuple_size<std::decay_t<Tuple>>::value>{});
+}
+
+template <class T, class U, std::size_t... I>
+bool any_element_equal(const T& t, const U& u, std::index_sequence<I...>) {
+  bool equal = false;
+  (void)std::initializer_list<int>{
+      (equal = equal || std::get<I>(t) == std::get<I>(u), 0)...};
+  return equal;
+}
+
+// True if any element of t equals the element of u at the same position.
+template <class... Ts, class... Us>
+bool any_element_equal(const std::tuple<Ts...>& t,
+                       const std::tuple<Us...>& u) {
+  return any_element_equal(t, u, std::index_sequence_for<Ts...>{});
+}
+
+// How zip_view finds its end: from the shortest size when all ranges are
+// indexable, not at all when all of those are unbounded, else as the tuple
+// of their ends if all are common, else through a sentinel.
+enum class zip_end { sized, unbounded, ends, sentinel };
+
+template <class... Rs>
+struct zip_end_kind
+    : std::integral_constant<
+          zip_end,
+          all_of<is_indexable_range<Rs>::value...>::value
+              ? (any_of<is_sized_range<Rs>::value...>::value
+                     ? zip_end::sized
+                     : zip_end::unbounded)
+              : (all_of<is_common_range<Rs>::value...>::value
+                     ? zip_end::ends
+                     : zip_end::sentinel)> {};
+
+// Sized if the unbounded ranges are zipped with at least one sized one.
+template <class... Rs>
+using zip_is_sized = std::integral_constant<
+    bool, all_of<(is_sized_range<Rs>::value ||
+                  has_unreachable_end<Rs>::value)...>::value &&
+              any_of<is_sized_range<Rs>::value...>::value>;
+
+// Calls F with the elements of a tuple, for zip_transform.
+template <class F>
+class tuple_applier {
+ public:
+  explicit tuple_applier(F f) : f_(std::move(f)) {}
+
+ private:
+  template <class Tuple, std::size_t... I>
+  auto call(Tuple&& t, std::index_sequence<I...>) const
+      -> decltype(std::declval<const F&>()(
+          std::get<I>(std::forward<Tuple>(t))...)) {
+    return f_(std::get<I>(std::forward<Tuple>(t))...);
+  }
+
+ public:
+  template <class Tuple,
+            class Indices = std::make_index_sequence<
+                std::tuple_size<std::decay_t<Tuple>>::value>>
+  auto operator()(Tuple&& t) const
+      -> decltype(this->call(std::forward<Tuple>(t), Indices{})) {
+    return call(std::forward<Tuple>(t), Indices{});
+  }
+
+ private:
+  F f_;
+};
+}  // namespace detail
+
+// The reference type of zip and enumerate: a std::tuple, usually of
+// references, that can be assigned and swapped as a prvalue. Assigning or
+// swapping one writes through to the elements, so standard algorithms such
+// as std::sort permute the underlying ranges together.
+template <class... Ts>
+class common_tuple : public std::tuple<Ts...> {
+  using base_type = std::tuple<Ts...>;
+  struct not_swappable;
+
+  // Swapping copies would do nothing; only tuples of references swap.
+  using swap_argument = std::conditional_t<
+      detail::all_of<std::is_reference<Ts>::value...>::value,
+      const common_tuple&, const not_swappable&>;
+
+ public:
+  using base_type::base_type;
+  using base_type::operator=;
+
+  friend void swap(swap_argument a, swap_argument b) {
+    swap_elements(a, b, std::index_sequence_for<Ts...>{});
+  }
+
+ private:
+  template <std::size_t... I>
+  static void swap_elements(const common_tuple& a, const common_tuple& b,
+                            std::index_sequence<I...>) {
+    using std::swap;
+    (void)std::initializer_list<int>{
+        (swap(std::get<I>(a), std::get<I>(b)), 0)...};
+  }
+};
+
+// Vs side by side: the i-th element is a common_tuple of the i-th elements
+// of each, and the view is as long as the shortest of them. Over ranges
+// that are random access and sized or unbounded, the iterators advance
+// together, compare by their first member and stay random access.
+template <class... Vs>
+class zip_view : public view_interface<zip_view<Vs...>> {
+  static_assert(sizeof...(Vs) > 0, "zip needs at least one range");
+
+  template <bool Const>
+  class iterator_impl;
+  template <bool Const>
+  class sentinel_impl;
+
+  template <bool Const>
+  using end_kind = detail::zip_end_kind<detail::maybe_const_t<Const, Vs>...>;
+
+  template <bool Const>
+  using is_range = detail::all_of<
+      detail::is_range<detail::maybe_const_t<Const, Vs>>::value...>;
+
+ public:
+  using iterator = iterator_impl<false>;
+  using const_iterator = iterator_impl<true>;
+
+  zip_view() = default;
+  explicit zip_view(Vs... views) : views_(std::move(views)...) {}
+
+  iterator begin() { return iterator(begins(views_)); }
+  auto end() { return end_of<false>(views_, end_kind<false>{}); }
+
+  template <bool C = true, std::enable_if_t<is_range<C>::value, int> = 0>
+  const_iterator begin() const {
+    return const_iterator(begins(views_));
+  }
+  template <bool C = true, std::enable_if_t<is_range<C>::value, int> = 0>
+  auto end() const {
+    return end_of<true>(views_, end_kind<true>{});
+  }
+
+  template <bool C = false,
+            std::enable_if_t<detail::zip_is_sized<
+                                 detail::maybe_const_t<C, Vs>...>::value,
+                             int> = 0>
+  std::size_t size() {
+    return size_of(views_);
+  }
+  template <bool C = true,
+            std::enable_if_t<detail::zip_is_sized<
+                                 detail::maybe_const_t<C, Vs>...>::value,
+                             int> = 0>
+  std::size_t size() const {
+    return size_of(views_);
+  }
+
+ private:
+  template <detail::zip_end K>
+  using end_tag = std::integral_constant<detail::zip_end, K>;
+
+  template <class Views>
+  static auto begins(Views& views) {
+    return detail::tuple_transform(
+        views, [](auto& v) { return ranges::begin(v); });
+  }
+
+  template <class Views>
+  static auto ends(Views& views) {
+    return detail::tuple_transform(views,
+                                   [](auto& v) { return ranges::end(v); });
+  }
+
+  // The shortest size; unbounded ranges do not count.
+  template <class Views>
+  static std::size_t size_of(Views& views) {
+    std::size_t n = static_cast<std::size_t>(-1);
+    detail::tuple_for_each(views, [&n](auto& v) {
+      n = detail::size_at_most(
+          v, n, detail::is_sized_range<std::remove_reference_t<decltype(v)>>{});
+    });
+    return n;
+  }
+
+  template <bool Const, class Views>
+  static iterator_impl<Const> end_of(Views& views,
+                                     end_tag<detail::zip_end::sized>) {
+    const std::size_t n = size_of(views);
+    return iterator_impl<Const>(detail::tuple_transform(views, [n](auto& v) {
+      return ranges::begin(v) + static_cast<range_difference_t<decltype(v)>>(n);
+    }));
+  }
+
+  template <bool Const, class Views>
+  static unreachable_sentinel_t end_of(Views&,
+                                       end_tag<detail::zip_end::unbounded>) {
+    return {};
+  }
+
+  template <bool Const, class Views>
+  static iterator_impl<Const> end_of(Views& views,
+                                     end_tag<detail::zip_end::ends>) {
+    return iterator_impl<Const>(ends(views));
+  }
+
+  template <bool Const, class Views>
+  static sentinel_impl<Const> end_of(Views& views,
+                                     end_tag<detail::zip_end::sentinel>) {
+    return sentinel_impl<Const>(ends(views));
+  }
+
+  std::tuple<Vs...> views_;
+};
+
+template <class... Vs>
+template <bool Const>
+class zip_view<Vs...>::iterator_impl {
+  using iterators = std::tuple<iterator_t<detail::maybe_const_t<Const, Vs>>...>;
+  using indices = std::index_sequence_for<Vs...>;
+
+  // The end made of the ranges' ends is not in step with the other
+  // iterators: they can only be compared, member by member, and are
+  // forward iterators at most.
+  enum : bool { in_step = end_kind<Const>::value != detail::zip_end::ends };
+
+ public:
+  using iterator_concept = typename detail::weakest_category<
+      std::conditional_t<in_step, std::random_access_iterator_tag,
+                         std::forward_iterator_tag>,
+      detail::iterator_concept_t<
+          iterator_t<detail::maybe_const_t<Const, Vs>>>...>::type;
+  using iterator_category = std::input_iterator_tag;
+  using value_type =
+      std::tuple<range_value_t<detail::maybe_const_t<Const, Vs>>...>;
+  using difference_type = std::common_type_t<
+      range_difference_t<detail::maybe_const_t<Const, Vs>>...>;
+  using reference =
+      common_tuple<range_reference_t<detail::maybe_const_t<Const, Vs>>...>;
+  using pointer = void;
+
+  iterator_impl() = default;
+  explicit iterator_impl(iterators current) : current_(std::move(current)) {}
+  template <bool C = Const, std::enable_if_t<C, int> = 0>
+  iterator_impl(iterator_impl<false> other)
+      : current_(std::move(other.current_)) {}
+
+  reference operator*() const { return dereference(indices{}); }
+  reference operator[](difference_type n) const { return *(*this + n); }
+
+  iterator_impl& operator++() {
+    detail::tuple_for_each(current_, [](auto& it) { ++it; });
+    return *this;
+  }
+  iterator_impl operator++(int) {
+    iterator_impl tmp = *this;
+    ++*this;
+    return tmp;
+  }
+  iterator_impl& operator--() {
+    detail::tuple_for_each(current_, [](auto& it) { --it; });
+    return *this;
+  }
+  iterator_impl operator--(int) {
+    iterator_impl tmp = *this;
+    --*this;
+    return tmp;
+  }
+  iterator_impl& operator+=(difference_type n) {
+    detail::tuple_for_each(current_, [n](auto& it) {
+      it += static_cast<iter_difference_t<std::decay_t<decltype(it)>>>(n);
+    });
+    return *this;
+  }
+  iterator_impl& operator-=(difference_type n) { return *this += -n; }
+
+  friend iterator_impl operator+(iterator_impl it, difference_type n) {
+    return it += n;
+  }
+  friend iterator_impl operator+(difference_type n, iterator_impl it) {
+    return it += n;
+  }
+  friend iterator_impl operator-(iterator_impl it, difference_type n) {
+    return it -= n;
+  }
+  friend difference_type operator-(const iterator_impl& a,
+                                   const iterator_impl& b) {
+    return static_cast<difference_type>(std::get<0>(a.current_) -
+                                        std::get<0>(b.current_));
+  }
+
+  friend bool operator==(const iterator_impl& a, const iterator_impl& b) {
+    return in_step ? std::get<0>(a.current_) == std::get<0>(b.current_)
+                   : detail::any_element_equal(a.current_, b.current_);
+  }
+  friend bool operator!=(const iterator_impl& a, const iterator_impl& b) {
+    return !(a == b);
+  }
+  friend bool operator<(const iterator_impl& a, const iterator_impl& b) {
+    return std::get<0>(a.current_) < std::get<0>(b.current_);
+  }
+  friend bool operator>(const iterator_impl& a, const iterator_impl& b) {
+    return b < a;
+  }
+  friend bool operator<=(const iterator_impl& a, const iterator_impl& b) {
+    return !(b < a);
+  }
+  friend bool operator>=(const iterator_impl& a, const iterator_impl& b) {
+    return !(a < b);
+  }
+
+  friend common_tuple<
+      range_rvalue_reference_t<detail::maybe_const_t<Const, Vs>>...>
+  iter_move(const iterator_impl& it) {
+    return it.move_elements(indices{});
+  }
+  friend void iter_swap(const iterator_impl& a, const iterator_impl& b) {
+    a.swap_elements(b, indices{});
+  }
+
+ private:
+  friend class iterator_impl<!Const>;
+  friend class sentinel_impl<Const>;
+
+  template <std::size_t... I>
+  reference dereference(std::index_sequence<I...>) const {
+    return reference(*std::get<I>(current_)...);
+  }
+
+  template <std::size_t... I>
+  common_tuple<range_rvalue_reference_t<detail::maybe_const_t<Const, Vs>>...>
+  move_elements(std::index_sequence<I...>) const {
+    return common_tuple<
+        range_rvalue_reference_t<detail::maybe_const_t<Const, Vs>>...>(
+        ranges::iter_move(std::get<I>(current_))...);
+  }
+
+  template <std::size_t... I>
+  void swap_elements(const iterator_impl& other,
+                     std::index_sequence<I...>) const {
+    (void)std::initializer_list<int>{
+        (ranges::iter_swap(std::get<I>(current_), std::get<I>(other.current_)),
+         0)...};
+  }
+
+  iterators current_{};
+};
+
+template <class... Vs>
+template <bool Const>
+class zip_view<Vs...>::sentinel_impl {
+  using sentinels = std::tuple<sentinel_t<detail::maybe_const_t<Const, Vs>>...>;
+
+ public:
+  sentinel_impl() = default;
+  explicit sentinel_impl(sentinels end) : end_(std::move(end)) {}
+
+  // Reached when any of the ranges is.
+  friend bool operator==(const iterator_impl<Const>& it,
+                         const sentinel_impl& s) {
+    return s.reached_by(it);
+  }
+  friend bool operator==(const sentinel_impl& s,
+                         const iterator_impl<Const>& it) {
+    return s.reached_by(it);
+  }
+  friend bool operator!=(const iterator_impl<Const>& it,
+                         const sentinel_impl& s) {
+    return !s.reached_by(it);
+  }
+  friend bool operator!=(const sentinel_impl& s,
+                         const iterator_impl<Const>& it) {
+    return !s.reached_by(it);
+  }
+
+ private:
+  bool reached_by(const iterator_impl<Const>& it) const {
+    return detail::any_element_equal(it.current_, end_);
+  }
+
+  sentinels end_{};
+};
+
+// The elements of V with their indices, as common_tuple<index, element>.
+template <class V>
+class enumerate_view : public view_interface<enumerate_view<V>> {
+  template <bool Const>
+  class iterator_impl;
+  template <bool Const>
+  class sentinel_impl;
+
+  // end() is an iterator when its index is known: from the size, or not
+  // needed because the iterators cannot go back from it.
+  template <class R>
+  using has_end_iterator = std::integral_constant<
+      bool, detail::is_common_range<R>::value &&
+                (detail::is_sized_range<R>::value ||
+                 !detail::is_iterator_at_least<
+                     iterator_t<R>, std::bidirectional_iterator_tag>::value)>;
+
+ public:
+  using iterator = iterator_impl<false>;
+  using const_iterator = iterator_impl<true>;
+
+  enumerate_view() = default;
+  explicit enumerate_view(V base) : base_(std::move(base)) {}
+
+  V base() const& { return base_; }
+  V base() && { return std::move(base_); }
+
+  iterator begin() { return iterator(ranges::begin(base_), 0); }
+  auto end() { return end_of<false>(base_, has_end_iterator<V>{}); }
+
+  template <class T = const V,
+            std::enable_if_t<detail::is_range<T>::value, int> = 0>
+  const_iterator begin() const {
+    return const_iterator(ranges::begin(base_), 0);
+  }
+  template <class T = const V,
+            std::enable_if_t<detail::is_range<T>::value, int> = 0>
+  auto end() const {
+    return end_of<true>(base_, has_end_iterator<T>{});
+  }
+
+  template <class T = V>
+  auto size() -> decltype(ranges::size(std::declval<T&>())) {
+    return ranges::size(base_);
+  }
+  template <class T = const V>
+  auto size() const -> decltype(ranges::size(std::declval<T&>())) {
+    return ranges::size(base_);
+  }
+
+ private:
+  template <bool Const, class B>
+  static iterator_impl<Const> end_of(B& base, std::true_type) {
+    return iterator_impl<Const>(
+        ranges::end(base),
+        end_index(base, detail::is_sized_range<B>{}));
+  }
+
+  template <bool Const, class B>
+  static auto end_of(B& base, std::false_type) {
+    return sentinel_of<Const>(base, detail::has_unreachable_end<B>{});
+  }
+
+  template <bool Const, class B>
+  static unreachable_sentinel_t sentinel_of(B&, std::true_type) {
+    return {};
+  }
+
+  template <bool Const, class B>
+  static sentinel_impl<Const> sentinel_of(B& base, std::false_type) {
+    return sentinel_impl<Const>(ranges::end(base));
+  }
+
+  template <class B>
+  static range_difference_t<B> end_index(B& base, std::true_type) {
+    return static_cast<range_difference_t<B>>(ranges::size(base));
+  }
+
+  template <class B>
+  static range_difference_t<B> end_index(B&, std::false_type) {
+    return 0;
+  }
+
+  V base_;
+};
+
+template <class V>
+template <bool Const>
+class enumerate_view<V>::iterator_impl {
+  using base_type = detail::maybe_const_t<Const, V>;
+  using base_iterator = iterator_t<base_type>;
+
+ public:
+  using iterator_concept =
+      detail::weaker_category_t<std::random_access_iterator_tag,
+                                detail::iterator_concept_t<base_iterator>>;
+  using iterator_category = std::input_iterator_tag;
+  using difference_type = range_difference_t<base_type>;
+  using value_type = std::tuple<difference_type, range_value_t<base_type>>;
+  using reference = common_tuple<difference_type, range_reference_t<base_type>>;
+  using pointer = void;
+
+  iterator_impl() = default;
+  iterator_impl(base_iterator current, difference_type index)
+      : current_(std::move(current)), index_(index) {}
+  template <bool C = Const, std::enable_if_t<C, int> = 0>
+  iterator_impl(iterator_impl<false> other)
+      : current_(std::move(other.current_)), index_(other.index_) {}
+
+  const base_iterator& base() const& noexcept { return current_; }
+  base_iterator base() && { return std::move(current_); }
+  difference_type index() const noexcept { return index_; }
+
+  reference operator*() const { return reference(index_, *current_); }
+  reference operator[](difference_type n) const {
+    return reference(index_ + n, current_[n]);
+  }
+
+  iterator_impl& operator++() {
+    ++current_;
+    ++index_;
+    return *this;
+  }
+  iterator_impl operator++(int) {
+    iterator_impl tmp = *this;
+    ++*this;
+    return tmp;
+  }
+  iterator_impl& operator--() {
+    --current_;
+    --index_;
+    return *this;
+  }
+  iterator_impl operator--(int) {
+    iterator_impl tmp = *this;
+    --*this;
+    return tmp;
+  }
+  iterator_impl& operator+=(difference_type n) {
+    current_ += n;
+    index_ += n;
+    return *this;
+  }
+  iterator_impl& operator-=(difference_type n) { return *this += -n; }
+
+  friend iterator_impl operator+(iterator_impl it, difference_type n) {
+    return it += n;
+  }
+  friend iterator_impl operator+(difference_type n, iterator_impl it) {
+    return it += n;
+  }
+  friend iterator_impl operator-(iterator_impl it, difference_type n) {
+    return it -= n;
+  }
+  friend difference_type operator-(const iterator_impl& a,
+                                   const iterator_impl& b) {
+    return a.index_ - b.index_;
+  }
+
+  friend bool operator==(const iterator_impl& a, const iterator_impl& b) {
+    return a.current_ == b.current_;
+  }
+  friend bool operator!=(const iterator_impl& a, const iterator_impl& b) {
+    return !(a == b);
+  }
+  friend bool operator<(const iterator_impl& a, const iterator_impl& b) {
+    return a.index_ < b.index_;
+  }
+  friend bool operator>(const iterator_impl& a, const iterator_impl& b) {
+    return b < a;
+  }
+  friend bool operator<=(const iterator_impl& a, const iterator_impl& b) {
+    return !(b < a);
+  }
+  friend bool operator>=(const iterator_impl& a, const iterator_impl& b) {
+    return !(a < b);
+  }
+
+  friend common_tuple<difference_type, range_rvalue_reference_t<base_type>>
+  iter_move(const iterator_impl& it) {
+    return common_tuple<difference_type, range_rvalue_reference_t<base_type>>(
+        it.index_, ranges::iter_move(it.current_));
+  }
+
+ private:
+  friend class iterator_impl<!Const>;
+  friend class sentinel_impl<Const>;
+
+  base_iterator current_{};
+  difference_type index_ = 0;
+};
+
+template <class V>
+template <bool Const>
+class enumerate_view<V>::sentinel_impl {
+  using base_sentinel = sentinel_t<detail::maybe_const_t<Const, V>>;
+
+ public:
+  sentinel_impl() = default;
+  explicit sentinel_impl(base_sentinel end) : end_(std::move(end)) {}
+
+  friend bool operator==(const iterator_impl<Const>& it,
+                         const sentinel_impl& s) {
+    return s.reached_by(it);
+  }
+  friend bool operator==(const sentinel_impl& s,
+                         const iterator_impl<Const>& it) {
+    return s.reached_by(it);
+  }
+  friend bool operator!=(const iterator_impl<Const>& it,
+                         const sentinel_impl& s) {
+    return !s.reached_by(it);
+  }
+  friend bool operator!=(const sentinel_impl& s,
+                         const iterator_impl<Const>& it) {
+    return !s.reached_by(it);
+  }
+
+ private:
+  bool reached_by(const iterator_impl<Const>& it) const {
+    return it.current_ == end_;
+  }
+
+  base_sentinel end_{};
+};
+
+namespace detail {
+// Moves `it` by n, forwards or backwards, in one step when it is random
+// access. Not std::advance(), which goes by iterator_category.
+template <class I>
+void step(I& it, iter_difference_t<I> n, std::random_access_iterator_tag) {
+  it += n;
+}
+
+template <class I>
+void step(I& it, iter_difference_t<I> n, std::bidirectional_iterator_tag) {
+  for (; n > 0; --n) {
+    ++it;
+  }
+  for (; n < 0; ++n) {
+    --it;
+  }
+}
+
+template <class I>
+void step(I& it, iter_difference_t<I> n, std::input_iterator_tag) {
+  for (; n > 0; --n) {
+    ++it;
+  }
+}
+
+template <class I>
+void step(I& it, iter_difference_t<I> n) {
+  step(it, n, weaker_category_t<std::random_access_iterator_tag,
+                                iterator_concept_t<I>>{});
+}
+
+template <class I, class S, class = void>
+struct is_sized_sentinel : std::false_type {};
+
+template <class I, class S>
+struct is_sized_sentinel<
+    I, S,
+    std::enable_if_t<
+        is_iterator_at_least<I, std::random_access_iterator_tag>::value,
+        void_t<decltype(std::declval<const S&>() -
+                        std::declval<const I&>())>>> : std::true_type {};
+
+template <class I, class S>
+iter_difference_t<I> advance_bounded(I& it, iter_difference_t<I> n,
+                                     const S& last, std::true_type) {
+  const auto left = static_cast<iter_difference_t<I>>(last - it);
+  if (n < left) {
+    it += n;
+    return 0;
+  }
+  it += left;
+  return n - left;
+}
+
+template <class I, class S>
+iter_difference_t<I> advance_bounded(I& it, iter_difference_t<I> n,
+                                     const S& last, std::false_type) {
+  for (; n > 0 && it != last; --n) {
+    ++it;
+  }
+  return n;
+}
+
+template <class I>
+iter_difference_t<I> advance_bounded(I& it, iter_difference_t<I> n,
+                                     unreachable_sentinel_t) {
+  step(it, n);
+  return 0;
+}
+
+// Moves `it` forward by n but not past `last`, and returns how many of the
+// n steps were not taken.
+template <class I, class S>
+iter_difference_t<I> advance_bounded(I& it, iter_difference_t<I> n,
+                                     const S& last) {
+  return advance_bounded(it, n, last, is_sized_sentinel<I, S>{});
+}
+
+template <class I>
+void retreat_bounded(I& it, iter_difference_t<I> n, const I& first,
+                     std::random_access_iterator_tag) {
+  const iter_difference_t<I> left = it - first;
+  it -= n < left ? n : left;
+}
+
+template <class I>
+void retreat_bounded(I& it, iter_difference_t<I> n, const I& first,
+                     std::bidirectional_iterator_tag) {
+  for (; n > 0 && it != first; --n) {
+    --it;
+  }
+}
+
+template <class I>
+void retreat_bounded(I&, iter_difference_t<I>, const I&,
+                     std::forward_iterator_tag) {}
+
+// Moves `it` back by n but not before `first`. Forward iterators stay
+// where they are.
+template <class I>
+void retreat_bounded(I& it, iter_difference_t<I> n, const I& first) {
+  retreat_bounded(it, n, first,
+                  weaker_category_t<std::random_access_iterator_tag,
+                                    iterator_concept_t<I>>{});
+}
+
+// How chunk and slide walk R: through pointers when R is contiguous and
+// sized, so that each slice is a subrange of pointers with data(), else
+// through R's own iterators.
+template <class R, class = void>
+struct slice_traits {
+  using iterator = iterator_t<R>;
+  using sentinel = sentinel_t<R>;
+
+  static iterator first(R& r) { return ranges::begin(r); }
+  static sentinel last(R& r) { return ranges::end(r); }
+};
+
+template <class R>
+struct slice_traits<R, std::enable_if_t<is_contiguous_range<R>::value &&
+                                        is_sized_range<R>::value>> {
+  using iterator = decltype(ranges::data(std::declval<R&>()));
+  using sentinel = iterator;
+
+  static iterator first(R& r) { return ranges::data(r); }
+  static sentinel last(R& r) {
+    return ranges::data(r) + static_cast<std::ptrdiff_t>(ranges::size(r));
+  }
+};
+
+// How chunk and stride end: as an iterator when I and S are the same and
+// the shortfall of the last step is known, from the size, or never needed
+// because the iterators cannot go back; else without end, or as
+// default_sentinel, which the iterators recognize since they hold the end.
+enum class step_end { iterator, unbounded, sentinel };
+
+template <class R, class I, class S>
+using step_end_kind = std::integral_constant<
+    step_end,
+    std::is_same<I, S>::value &&
+            (is_sized_range<R>::value ||
+             !is_iterator_at_least<I, std::bidirectional_iterator_tag>::value)
+        ? step_end::iterator
+        : (std::is_same<S, unreachable_sentinel_t>::value
+               ? step_end::unbounded
+               : step_end::sentinel)>;
+
+// A position in [current, end) that moves n elements at a time and stops at
+// end. missing is how far the last step fell short of n, so that stepping
+// back from the end lands where stepping forward would have.
+template <class I, class S>
+class stepping_cursor {
+ public:
+  using difference_type = iter_difference_t<I>;
+
+  stepping_cursor() = default;
+  stepping_cursor(I current, S end, difference_type n,
+                  difference_type missing = 0)
+      : current_(std::move(current)),
+        end_(std::move(end)),
+        n_(n),
+        missing_(missing) {}
+
+  const I& current() const noexcept { return current_; }
+  const S& end() const noexcept { return end_; }
+  difference_type stride() const noexcept { return n_; }
+  bool at_end() const { return current_ == end_; }
+
+  void advance(difference_type k) {
+    if (k > 0) {
+      missing_ = advance_bounded(current_, n_ * k, end_);
+    } else if (k < 0) {
+      step(current_, n_ * k + missing_);
+      missing_ = 0;
+    }
+  }
+
+  difference_type distance_from(const stepping_cursor& other) const {
+    const difference_type elements =
+        static_cast<difference_type>(current_ - other.current_) + missing_ -
+        other.missing_;
+    return elements / n_;
+  }
+
+ private:
+  I current_{};
+  S end_{};
+  difference_type n_ = 1;
+  difference_type missing_ = 0;
+};
+}  // namespace detail
+
+// V in slices of n elements, the last one possibly shorter. Each slice is
+// a subrange; over contiguous sized ranges it is a subrange of pointers, so
+// ranges::data() and size() hand a whole batch to vectorized code or I/O
+// without a copy.
+template <class V>
+class chunk_view : public view_interface<chunk_view<V>> {
+  template <bool Const>
+  class iterator_impl;
+
+ public:
+  using iterator = iterator_impl<false>;
+  using const_iterator = iterator_impl<true>;
+
+  chunk_view(V base, range_difference_t<V> n)
+      : base_(std::move(base)), n_(n) {}
+
+  V base() const& { return base_; }
+  V base() && { return std::move(base_); }
+
+  iterator begin() { return begin_of<false>(base_); }
+  auto end() { return end_of<false>(base_); }
+
+  template <class T = const V,
+            std::enable_if_t<detail::is_range<T>::value, int> = 0>
+  const_iterator begin() const {
+    return begin_of<true>(base_);
+  }
+  template <class T = const V,
+            std::enable_if_t<detail::is_range<T>::value, int> = 0>
+  auto end() const {
+    return end_of<true>(base_);
+  }
+
+  template <class T = V>
+  auto size() -> decltype(ranges::size(std::declval<T&>())) {
+    return chunks(ranges::size(base_));
+  }
+  template <class T = const V>
+  auto size() const -> decltype(ranges::size(std::declval<T&>())) {
+    return chunks(ranges::size(base_));
+  }
+
+ private:
+  template <class Size>
+  Size chunks(Size size) const {
+    const Size n = static_cast<Size>(n_);
+    return (size + n - 1) / n;
+  }
+
+  template <bool Const, class B>
+  iterator_impl<Const> begin_of(B& base) const {
+    using traits = detail::slice_traits<B>;
+    return iterator_impl<Const>({traits::first(base), traits::last(base), n_});
+  }
+
+  template <bool Const, class B>
+  auto end_of(B& base) const {
+    using traits = detail::slice_traits<B>;
+    return end_as<Const>(
+        base, detail::step_end_kind<B, typename traits::iterator,
+                                    typename traits::sentinel>{});
+  }
+
+  template <bool Const, class B>
+  iterator_impl<Const> end_as(
+      B& base, std::integral_constant<detail::step_end,
+                                      detail::step_end::iterator>) const {
+    using traits = detail::slice_traits<B>;
+    return iterator_impl<Const>(
+        {traits::last(base), traits::last(base), n_,
+         missing(base, detail::is_sized_range<B>{})});
+  }
+
+  template <bool Const, class B>
+  unreachable_sentinel_t end_as(
+      B&, std::integral_constant<detail::step_end,
+                                 detail::step_end::unbounded>) const {
+    return {};
+  }
+
+  template <bool Const, class B>
+  default_sentinel_t end_as(
+      B&, std::integral_constant<detail::step_end,
+                                 detail::step_end::sentinel>) const {
+    return {};
+  }
+
+  // How much shorter than n the last chunk is.
+  template <class B>
+  range_difference_t<V> missing(B& base, std::true_type) const {
+    const auto size = static_cast<range_difference_t<V>>(ranges::size(base));
+    return (n_ - size % n_) % n_;
+  }
+
+  template <class B>
+  range_difference_t<V> missing(B&, std::false_type) const {
+    return 0;
+  }
+
+  V base_;
+  range_difference_t<V> n_;
+};
+
+template <class V>
+template <bool Const>
+class chunk_view<V>::iterator_impl {
+  using base_type = detail::maybe_const_t<Const, V>;
+  using traits = detail::slice_traits<base_type>;
+  using base_iterator = typename traits::iterator;
+  using cursor = detail::stepping_cursor<base_iterator,
+                                         typename traits::sentinel>;
+
+  static_assert(detail::is_iterator_at_least<
+                    base_iterator, std::forward_iterator_tag>::value,
+                "chunk needs a forward range");
+
+ public:
+  using iterator_concept =
+      detail::weaker_category_t<std::random_access_iterator_tag,
+                                detail::iterator_concept_t<base_iterator>>;
+  using iterator_category = std::input_iterator_tag;
+  using value_type = subrange<base_iterator>;
+  using difference_type = range_difference_t<base_type>;
+  using reference = value_type;
+  using pointer = void;
+
+  iterator_impl() = default;
+  explicit iterator_impl(cursor position) : position_(std::move(position)) {}
+  template <bool C = Const, std::enable_if_t<C, int> = 0>
+  iterator_impl(iterator_impl<false> other)
+      : position_(std::move(other.position_)) {}
+
+  const base_iterator& base() const& noexcept { return position_.current(); }
+
+  value_type operator*() const {
+    base_iterator last = position_.current();
+    detail::advance_bounded(last, position_.stride(), position_.end());
+    return value_type(position_.current(), std::move(last));
+  }
+  value_type operator[](difference_type n) const { return *(*this + n); }
+
+  iterator_impl& operator++() {
+    position_.advance(1);
+    return *this;
+  }
+  iterator_impl operator++(int) {
+    iterator_impl tmp = *this;
+    ++*this;
+    return tmp;
+  }
+  iterator_impl& operator--() {
+    position_.advance(-1);
+    return *this;
+  }
+  iterator_impl operator--(int) {
+    iterator_impl tmp = *this;
+    --*this;
+    return tmp;
+  }
+  iterator_impl& operator+=(difference_type n) {
+    position_.advance(n);
+    return *this;
+  }
+  iterator_impl& operator-=(difference_type n) { return *this += -n; }
+
+  friend iterator_impl operator+(iterator_impl it, difference_type n) {
+    return it += n;
+  }
+  friend iterator_impl operator+(difference_type n, iterator_impl it) {
+    return it += n;
+  }
+  friend iterator_impl operator-(iterator_impl it, difference_type n) {
+    return it -= n;
+  }
+  friend difference_type operator-(const iterator_impl& a,
+                                   const iterator_impl& b) {
+    return a.position_.distance_from(b.position_);
+  }
+
+  friend bool operator==(const iterator_impl& a, const iterator_impl& b) {
+    return a.position_.current() == b.position_.current();
+  }
+  friend bool operator!=(const iterator_impl& a, const iterator_impl& b) {
+    return !(a == b);
+  }
+  friend bool operator<(const iterator_impl& a, const iterator_impl& b) {
+    return a.position_.current() < b.position_.current();
+  }
+  friend bool operator>(const iterator_impl& a, const iterator_impl& b) {
+    return b < a;
+  }
+  friend bool operator<=(const iterator_impl& a, const iterator_impl& b) {
+    return !(b < a);
+  }
+  friend bool operator>=(const iterator_impl& a, const iterator_impl& b) {
+    return !(a < b);
+  }
+
+  friend bool operator==(const iterator_impl& it, default_sentinel_t) {
+    return it.position_.at_end();
+  }
+  friend bool operator==(default_sentinel_t, const iterator_impl& it) {
+    return it.position_.at_end();
+  }
+  friend bool operator!=(const iterator_impl& it, default_sentinel_t) {
+    return !it.position_.at_end();
+  }
+  friend bool operator!=(default_sentinel_t, const iterator_impl& it) {
+    return !it.position_.at_end();
+  }
+
+ private:
+  friend class iterator_impl<!Const>;
+
+  cursor position_;
+};
+
+// Every n-th element of V, starting with the first.
+template <class V>
+class stride_view : public view_interface<stride_view<V>> {
+  template <bool Const>
+  class iterator_impl;
+
+ public:
+  using iterator = iterator_impl<false>;
+  using const_iterator = iterator_impl<true>;
+
+  stride_view(V base, range_difference_t<V> n)
+      : base_(std::move(base)), n_(n) {}
+
+  V base() const& { return base_; }
+  V base() && { return std::move(base_); }
+  range_difference_t<V> stride() const noexcept { return n_; }
+
+  iterator begin() {
+    return iterator({ranges::begin(base_), ranges::end(base_), n_});
+  }
+  auto end() { return end_of<false>(base_); }
+
+  template <class T = const V,
+            std::enable_if_t<detail::is_range<T>::value, int> = 0>
+  const_iterator begin() const {
+    return const_iterator({ranges::begin(base_), ranges::end(base_), n_});
+  }
+  template <class T = const V,
+            std::enable_if_t<detail::is_range<T>::value, int> = 0>
+  auto end() const {
+    return end_of<true>(base_);
+  }
+
+  template <class T = V>
+  auto size() -> decltype(ranges::size(std::declval<T&>())) {
+    return strides(ranges::size(base_));
+  }
+  template <class T = const V>
+  auto size() const -> decltype(ranges::size(std::declval<T&>())) {
+    return strides(ranges::size(base_));
+  }
+
+ private:
+  template <class Size>
+  Size strides(Size size) const {
+    const Size n = static_cast<Size>(n_);
+    return (size + n - 1) / n;
+  }
+
+  template <bool Const, class B>
+  auto end_of(B& base) const {
+    return end_as<Const>(
+        base, detail::step_end_kind<B, iterator_t<B>, sentinel_t<B>>{});
+  }
+
+  template <bool Const, class B>
+  iterator_impl<Const> end_as(
+      B& base, std::integral_constant<detail::step_end,
+                                      detail::step_end::iterator>) const {
+    return iterator_impl<Const>({ranges::end(base), ranges::end(base), n_,
+                                 missing(base, detail::is_sized_range<B>{})});
+  }
+
+  template <bool Const, class B>
+  unreachable_sentinel_t end_as(
+      B&, std::integral_constant<detail::step_end,
+                                 detail::step_end::unbounded>) const {
+    return {};
+  }
+
+  template <bool Const, class B>
+  default_sentinel_t end_as(
+      B&, std::integral_constant<detail::step_end,
+                                 detail::step_end::sentinel>) const {
+    return {};
+  }
+
+  template <class B>
+  range_difference_t<V> missing(B& base, std::true_type) const {
+    const auto size = static_cast<range_difference_t<V>>(ranges::size(base));
+    return (n_ - size % n_) % n_;
+  }
+
+  template <class B>
+  range_difference_t<V> missing(B&, std::false_type) const {
+    return 0;
+  }
+
+  V base_;
+  range_difference_t<V> n_;
+};
+
+template <class V>
+template <bool Const>
+class stride_view<V>::iterator_impl {
+  using base_type = detail::maybe_const_t<Const, V>;
+  using base_iterator = iterator_t<base_type>;
+  using cursor = detail::stepping_cursor<base_iterator, sentinel_t<base_type>>;
+
+ public:
+  using iterator_concept =
+      detail::weaker_category_t<std::random_access_iterator_tag,
+                                detail::iterator_concept_t<base_iterator>>;
+  using iterator_category =
+      detail::weaker_category_t<std::random_access_iterator_tag,
+                                detail::iterator_category_t<base_iterator>>;
+  using value_type = range_value_t<base_type>;
+  using difference_type = range_difference_t<base_type>;
+  using reference = range_reference_t<base_type>;
+  using pointer = void;
+
+  iterator_impl() = default;
+  explicit iterator_impl(cursor position) : position_(std::move(position)) {}
+  template <bool C = Const, std::enable_if_t<C, int> = 0>
+  iterator_impl(iterator_impl<false> other)
+      : position_(std::move(other.position_)) {}
+
+  const base_iterator& base() const& noexcept { return position_.current(); }
+
+  reference operator*() const { return *position_.current(); }
+  reference operator[](difference_type n) const { return *(*this + n); }
+
+  iterator_impl& operator++() {
+    position_.advance(1);
+    return *this;
+  }
+  iterator_impl operator++(int) {
+    iterator_impl tmp = *this;
+    ++*this;
+    return tmp;
+  }
+  iterator_impl& operator--() {
+    position_.advance(-1);
+    return *this;
+  }
+  iterator_impl operator--(int) {
+    iterator_impl tmp = *this;
+    --*this;
+    return tmp;
+  }
+  iterator_impl& operator+=(difference_type n) {
+    position_.advance(n);
+    return *this;
+  }
+  iterator_impl& operator-=(difference_type n) { return *this += -n; }
+
+  friend iterator_impl operator+(iterator_impl it, difference_type n) {
+    return it += n;
+  }
+  friend iterator_impl operator+(difference_type n, iterator_impl it) {
+    return it += n;
+  }
+  friend iterator_impl operator-(iterator_impl it, difference_type n) {
+    return it -= n;
+  }
+  friend difference_type operator-(const iterator_impl& a,
+                                   const iterator_impl& b) {
+    return a.position_.distance_from(b.position_);
+  }
+
+  friend bool operator==(const iterator_impl& a, const iterator_impl& b) {
+    return a.position_.current() == b.position_.current();
+  }
+  friend bool operator!=(const iterator_impl& a, const iterator_impl& b) {
+    return !(a == b);
+  }
+  friend bool operator<(const iterator_impl& a, const iterator_impl& b) {
+    return a.position_.current() < b.position_.current();
+  }
+  friend bool operator>(const iterator_impl& a, const iterator_impl& b) {
+    return b < a;
+  }
+  friend bool operator<=(const iterator_impl& a, const iterator_impl& b) {
+    return !(b < a);
+  }
+  friend bool operator>=(const iterator_impl& a, const iterator_impl& b) {
+    return !(a < b);
+  }
+
+  friend bool operator==(const iterator_impl& it, default_sentinel_t) {
+    return it.position_.at_end();
+  }
+  friend bool operator==(default_sentinel_t, const iterator_impl& it) {
+    return it.position_.at_end();
+  }
+  friend bool operator!=(const iterator_impl& it, default_sentinel_t) {
+    return !it.position_.at_end();
+  }
+  friend bool operator!=(default_sentinel_t, const iterator_impl& it) {
+    return !it.position_.at_end();
+  }
+
+ private:
+  friend class iterator_impl<!Const>;
+
+  cursor position_;
+};
+
+// The windows of n consecutive elements of V: [0, n), [1, n + 1) and so on,
+// none if V is shorter than n. Like chunk's slices, the windows are
+// subranges, of pointers over contiguous sized ranges. The iterators hold
+// the first and last element of their window, so both ends move in O(1).
+template <class V>
+class slide_view : public view_interface<slide_view<V>> {
+  template <bool Const>
+  class iterator_impl;
+  template <bool Const>
+  class sentinel_impl;
+
+ public:
+  using iterator = iterator_impl<false>;
+  using const_iterator = iterator_impl<true>;
+
+  slide_view(V base, range_difference_t<V> n)
+      : base_(std::move(base)), n_(n) {}
+
+  V base() const& { return base_; }
+  V base() && { return std::move(base_); }
+
+  iterator begin() { return begin_of<false>(base_); }
+  auto end() { return end_of<false>(base_); }
+
+  template <class T = const V,
+            std::enable_if_t<detail::is_range<T>::value, int> = 0>
+  const_iterator begin() const {
+    return begin_of<true>(base_);
+  }
+  template <class T = const V,
+            std::enable_if_t<detail::is_range<T>::value, int> = 0>
+  auto end() const {
+    return end_of<true>(base_);
+  }
+
+  template <class T = V>
+  auto size() -> decltype(ranges::size(std::declval<T&>())) {
+    return windows(ranges::size(base_));
+  }
+  template <class T = const V>
+  auto size() const -> decltype(ranges::size(std::declval<T&>())) {
+    return windows(ranges::size(base_));
+  }
+
+ private:
+  template <class Size>
+  Size windows(Size size) const {
+    const Size n = static_cast<Size>(n_);
+    return size < n ? 0 : size - n + 1;
+  }
+
+  template <bool Const, class B>
+  iterator_impl<Const> begin_of(B& base) const {
+    using traits = detail::slice_traits<B>;
+    auto first = traits::first(base);
+    auto last = first;
+    detail::advance_bounded(last, n_ - 1, traits::last(base));
+    return iterator_impl<Const>(std::move(first), std::move(last));
+  }
+
+  template <bool Const, class B>
+  auto end_of(B& base) const {
+    using traits = detail::slice_traits<B>;
+    using I = typename traits::iterator;
+    using S = typename traits::sentinel;
+    return end_as<Const>(
+        base, std::integral_constant<
+                  int, std::is_same<I, S>::value
+                           ? 0
+                           : std::is_same<S, unreachable_sentinel_t>::value
+                                 ? 1
+                                 : 2>{});
+  }
+
+  // The last window ends at the end of V; only its first element needs
+  // finding, and only if the iterators can go back.
+  template <bool Const, class B>
+  iterator_impl<Const> end_as(B& base, std::integral_constant<int, 0>) const {
+    using traits = detail::slice_traits<B>;
+    auto last = traits::last(base);
+    auto first = last;
+    detail::retreat_bounded(first, n_ - 1, traits::first(base));
+    return iterator_impl<Const>(std::move(first), std::move(last));
+  }
+
+  template <bool Const, class B>
+  unreachable_sentinel_t end_as(B&, std::integral_constant<int, 1>) const {
+    return {};
+  }
+
+  template <bool Const, class B>
+  sentinel_impl<Const> end_as(B& base, std::integral_constant<int, 2>) const {
+    return sentinel_impl<Const>(detail::slice_traits<B>::last(base));
+  }
+
+  V base_;
+  range_difference_t<V> n_;
+};
+
+template <class V>
+template <bool Const>
+class slide_view<V>::iterator_impl {
+  using base_type = detail::maybe_const_t<Const, V>;
+  using base_iterator = typename detail::slice_traits<base_type>::iterator;
+
+  static_assert(detail::is_iterator_at_least<
+                    base_iterator, std::forward_iterator_tag>::value,
+                "slide needs a forward range");
+
+ public:
+  using iterator_concept =
+      detail::weaker_category_t<std::random_access_iterator_tag,
+                                detail::iterator_concept_t<base_iterator>>;
+  using iterator_category = std::input_iterator_tag;
+  using value_type = subrange<base_iterator>;
+  using difference_type = range_difference_t<base_type>;
+  using reference = value_type;
+  using pointer = void;
+
+  iterator_impl() = default;
+  iterator_impl(base_iterator first, base_iterator last)
+      : first_(std::move(first)), last_(std::move(last)) {}
+  template <bool C = Const, std::enable_if_t<C, int> = 0>
+  iterator_impl(iterator_impl<false> other)
+      : first_(std::move(other.first_)), last_(std::move(other.last_)) {}
+
+  value_type operator*() const {
+    base_iterator end = last_;
+    ++end;
+    return value_type(first_, std::move(end));
+  }
+  value_type operator[](difference_type n) const { return *(*this + n); }
+
+  iterator_impl& operator++() {
+    ++first_;
+    ++last_;
+    return *this;
+  }
+  iterator_impl operator++(int) {
+    iterator_impl tmp = *this;
+    ++*this;
+    return tmp;
+  }
+  iterator_impl& operator--() {
+    --first_;
+    --last_;
+    return *this;
+  }
+  iterator_impl operator--(int) {
+    iterator_impl tmp = *this;
+    --*this;
+    return tmp;
+  }
+  iterator_impl& operator+=(difference_type n) {
+    first_ += n;
+    last_ += n;
+    return *this;
+  }
+  iterator_impl& operator-=(difference_type n) { return *this += -n; }
+
+  friend iterator_impl operator+(iterator_impl it, difference_type n) {
+    return it += n;
+  }
+  friend iterator_impl operator+(difference_type n, iterator_impl it) {
+    return it += n;
+  }
+  friend iterator_impl operator-(iterator_impl it, difference_type n) {
+    return it -= n;
+  }
+  friend difference_type operator-(const iterator_impl& a,
+                                   const iterator_impl& b) {
+    return static_cast<difference_type>(a.last_ - b.last_);
+  }
+
+  // By the last elements, which over a range shorter than n are all at
+  // its end.
+  friend bool operator==(const iterator_impl& a, const iterator_impl& b) {
+    return a.last_ == b.last_;
+  }
+  friend bool operator!=(const iterator_impl& a, const iterator_impl& b) {
+    return !(a == b);
+  }
+  friend bool operator<(const iterator_impl& a, const iterator_impl& b) {
+    return a.last_ < b.last_;
+  }
+  friend bool operator>(const iterator_impl& a, const iterator_impl& b) {
+    return b < a;
+  }
+  friend bool operator<=(const iterator_impl& a, const iterator_impl& b) {
+    return !(b < a);
+  }
+  friend bool operator>=(const iterator_impl& a, const iterator_impl& b) {
+    return !(a < b);
+  }
+
+ private:
+  friend class iterator_impl<!Const>;
+  friend class sentinel_impl<Const>;
+
+  base_iterator first_{};
+  base_iterator last_{};
+};
+
+template <class V>
+template <bool Const>
+class slide_view<V>::sentinel_impl {
+  using base_sentinel =
+      typename detail::slice_traits<detail::maybe_const_t<Const, V>>::sentinel;
+
+ public:
+  sentinel_impl() = default;
+  explicit sentinel_impl(base_sentinel end) : end_(std::move(end)) {}
+
+  friend bool operator==(const iterator_impl<Const>& it,
+                         const sentinel_impl& s) {
+    return s.reached_by(it);
+  }
+  friend bool operator==(const sentinel_impl& s,
+                         const iterator_impl<Const>& it) {
+    return s.reached_by(it);
+  }
+  friend bool operator!=(const iterator_impl<Const>& it,
+                         const sentinel_impl& s) {
+    return !s.reached_by(it);
+  }
+  friend bool operator!=(const sentinel_impl& s,
+                         const iterator_impl<Const>& it) {
+    return !s.reached_by(it);
+  }
+
+ private:
+  bool reached_by(const iterator_impl<Const>& it) const {
+    return it.last_ == end_;
+  }
+
+  base_sentinel end_{};
+};
+
+namespace detail {
+template <class T, std::size_t>
+using repeat_t = T;
+
+template <class T, class Indices>
+struct repeated_tuples;
+
+template <class T, std::size_t... I>
+struct repeated_tuples<T, std::index_sequence<I...>> {
+  using common = common_tuple<repeat_t<T, I>...>;
+  using values = std::tuple<repeat_t<std::remove_cv_t<T>, I>...>;
+};
+}  // namespace detail
+
+// The windows of N consecutive elements of V as tuples, N known at compile
+// time: adjacent<2> gives (v[0], v[1]), (v[1], v[2]) and so on. The
+// iterators hold an iterator per member, so dereferencing costs no more
+// than for N separate iterators.
+template <class V, std::size_t N>
+class adjacent_view : public view_interface<adjacent_view<V, N>> {
+  static_assert(N > 0, "adjacent needs windows of at least one element");
+
+  template <bool Const>
+  class iterator_impl;
+  template <bool Const>
+  class sentinel_impl;
+
+ public:
+  using iterator = iterator_impl<false>;
+  using const_iterator = iterator_impl<true>;
+
+  adjacent_view() = default;
+  explicit adjacent_view(V base) : base_(std::move(base)) {}
+
+  V base() const& { return base_; }
+  V base() && { return std::move(base_); }
+
+  iterator begin() { return begin_of<false>(base_); }
+  auto end() { return end_of<false>(base_); }
+
+  template <class T = const V,
+            std::enable_if_t<detail::is_range<T>::value, int> = 0>
+  const_iterator begin() const {
+    return begin_of<true>(base_);
+  }
+  template <class T = const V,
+            std::enable_if_t<detail::is_range<T>::value, int> = 0>
+  auto end() const {
+    return end_of<true>(base_);
+  }
+
+  template <class T = V>
+  auto size() -> decltype(ranges::size(std::declval<T&>())) {
+    return windows(ranges::size(base_));
+  }
+  template <class T = const V>
+  auto size() const -> decltype(ranges::size(std::declval<T&>())) {
+    return windows(ranges::size(base_));
+  }
+
+ private:
+  template <class Size>
+  static Size windows(Size size) {
+    const Size n = static_cast<Size>(N);
+    return size < n ? 0 : size - n + 1;
+  }
+
+  template <bool Const, class B>
+  static iterator_impl<Const> begin_of(B& base) {
+    std::array<iterator_t<B>, N> current;
+    current[0] = ranges::begin(base);
+    const auto last = ranges::end(base);
+    for (std::size_t i = 1; i < N; ++i) {
+      current[i] = current[i - 1];
+      detail::advance_bounded(current[i], 1, last);
+    }
+    return iterator_impl<Const>(std::move(current));
+  }
+
+  template <bool Const, class B>
+  static auto end_of(B& base) {
+    return end_as<Const>(
+        base, std::integral_constant<
+                  int, detail::is_common_range<B>::value
+                           ? 0
+                           : detail::has_unreachable_end<B>::value ? 1 : 2>{});
+  }
+
+  // Found backwards from the end of V, as in slide_view.
+  template <bool Const, class B>
+  static iterator_impl<Const> end_as(B& base, std::integral_constant<int, 0>) {
+    std::array<iterator_t<B>, N> current;
+    current[N - 1] = ranges::end(base);
+    const auto first = ranges::begin(base);
+    for (std::size_t i = N - 1; i > 0; --i) {
+      current[i - 1] = current[i];
+      detail::retreat_bounded(current[i - 1], 1, first);
+    }
+    return iterator_impl<Const>(std::move(current));
+  }
+
+  template <bool Const, class B>
+  static unreachable_sentinel_t end_as(B&, std::integral_constant<int, 1>) {
+    return {};
+  }
+
+  template <bool Const, class B>
+  static sentinel_impl<Const> end_as(B& base, std::integral_constant<int, 2>) {
+    return sentinel_impl<Const>(ranges::end(base));
+  }
+
+  V base_;
+};
+
+template <class V, std::size_t N>
+template <bool Const>
+class adjacent_view<V, N>::iterator_impl {
+  using base_type = detail::maybe_const_t<Const, V>;
+  using base_iterator = iterator_t<base_type>;
+  using indices = std::make_index_sequence<N>;
+
+  static_assert(detail::is_iterator_at_least<
+                    base_iterator, std::forward_iterator_tag>::value,
+                "adjacent needs a forward range");
+
+ public:
+  using iterator_concept =
+      detail::weaker_category_t<std::random_access_iterator_tag,
+                                detail::iterator_concept_t<base_iterator>>;
+  using iterator_category = std::input_iterator_tag;
+  using value_type = typename detail::repeated_tuples<range_value_t<base_type>,
+                                                      indices>::values;
+  using difference_type = range_difference_t<base_type>;
+  using reference = typename detail::repeated_tuples<
+      range_reference_t<base_type>, indices>::common;
+  using pointer = void;
+
+  iterator_impl() = default;
+  explicit iterator_impl(std::array<base_iterator, N> current)
+      : current_(std::move(current)) {}
+  template <bool C = Const, std::enable_if_t<C, int> = 0>
+  iterator_impl(iterator_impl<false> other) {
+    for (std::size_t i = 0; i < N; ++i) {
+      current_[i] = std::move(other.current_[i]);
+    }
+  }
+
+  reference operator*() const { return dereference(indices{}); }
+  reference operator[](difference_type n) const { return *(*this + n); }
+
+  iterator_impl& operator++() {
+    for (auto& it : current_) {
+      ++it;
+    }
+    return *this;
+  }
+  iterator_impl operator++(int) {
+    iterator_impl tmp = *this;
+    ++*this;
+    return tmp;
+  }
+  iterator_impl& operator--() {
+    for (auto& it : current_) {
+      --it;
+    }
+    return *this;
+  }
+  iterator_impl operator--(int) {
+    iterator_impl tmp = *this;
+    --*this;
+    return tmp;
+  }
+  iterator_impl& operator+=(difference_type n) {
+    for (auto& it : current_) {
+      it += n;
+    }
+    return *this;
+  }
+  iterator_impl& operator-=(difference_type n) { return *this += -n; }
+
+  friend iterator_impl operator+(iterator_impl it, difference_type n) {
+    return it += n;
+  }
+  friend iterator_impl operator+(difference_type n, iterator_impl it) {
+    return it += n;
+  }
+  friend iterator_impl operator-(iterator_impl it, difference_type n) {
+    return it -= n;
+  }
+  friend difference_type operator-(const iterator_impl& a,
+                                   const iterator_impl& b) {
+    return static_cast<difference_type>(a.current_.back() -
+                                        b.current_.back());
+  }
+
+  friend bool operator==(const iterator_impl& a, const iterator_impl& b) {
+    return a.current_.back() == b.current_.back();
+  }
+  friend bool operator!=(const iterator_impl& a, const iterator_impl& b) {
+    return !(a == b);
+  }
+  friend bool operator<(const iterator_impl& a, const iterator_impl& b) {
+    return a.current_.back() < b.current_.back();
+  }
+  friend bool operator>(const iterator_impl& a, const iterator_impl& b) {
+    return b < a;
+  }
+  friend bool operator<=(const iterator_impl& a, const iterator_impl& b) {
+    return !(b < a);
+  }
+  friend bool operator>=(const iterator_impl& a, const iterator_impl& b) {
+    return !(a < b);
+  }
+
+  friend typename detail::repeated_tuples<range_rvalue_reference_t<base_type>,
+                                          indices>::common
+  iter_move(const iterator_impl& it) {
+    return it.move_elements(indices{});
+  }
+
+ private:
+  friend class iterator_impl<!Const>;
+  friend class sentinel_impl<Const>;
+
+  template <std::size_t... I>
+  reference dereference(std::index_sequence<I...>) const {
+    return reference(*current_[I]...);
+  }
+
+  template <std::size_t... I>
+  typename detail::repeated_tuples<range_rvalue_reference_t<base_type>,
+                                   indices>::common
+  move_elements(std::index_sequence<I...>) const {
+    return typename detail::repeated_tuples<
+        range_rvalue_reference_t<base_type>, indices>::common(
+        ranges::iter_move(current_[I])...);
+  }
+
+  std::array<base_iterator, N> current_{};
+};
+
+template <class V, std::size_t N>
+template <bool Const>
+class adjacent_view<V, N>::sentinel_impl {
+  using base_sentinel = sentinel_t<detail::maybe_const_t<Const, V>>;
+
+ public:
+  sentinel_impl() = default;
+  explicit sentinel_impl(base_sentinel end) : end_(std::move(end)) {}
+
+  friend bool operator==(const iterator_impl<Const>& it,
+                         const sentinel_impl& s) {
+    return s.reached_by(it);
+  }
+  friend bool operator==(const sentinel_impl& s,
+                         const iterator_impl<Const>& it) {
+    return s.reached_by(it);
+  }
+  friend bool operator!=(const iterator_impl<Const>& it,
+                         const sentinel_impl& s) {
+    return !s.reached_by(it);
+  }
+  friend bool operator!=(const sentinel_impl& s,
+                         const iterator_impl<Const>& it) {
+    return !s.reached_by(it);
+  }
+
+ private:
+  bool reached_by(const iterator_impl<Const>& it) const {
+    return it.current_.back() == end_;
+  }
+
+  base_sentinel end_{};
+};
+
+namespace detail {
+// Iterator concept of join and join_with: bidirectional if every level can
+// go back and the inner ranges are common, forward if every level is.
+template <class Outer, class InnerRange, class... Others>
+using join_category_t = std::conditional_t<
+    all_of<is_iterator_at_least<Outer, std::bidirectional_iterator_tag>::value,
+           is_iterator_at_least<iterator_t<InnerRange>,
+                                std::bidirectional_iterator_tag>::value,
+           is_common_range<InnerRange>::value>::value,
+    std::bidirectional_iterator_tag,
+    std::conditional_t<
+        all_of<is_iterator_at_least<Outer, std::forward_iterator_tag>::value,
+               is_iterator_at_least<iterator_t<InnerRange>,
+                                    std::forward_iterator_tag>::value,
+               is_iterator_at_least<Others,
+                                    std::forward_iterator_tag>::value...>::
+            value,
+        std::forward_iterator_tag, std::input_iterator_tag>>;
+
+// Whether a join over B can end in an iterator rather than a sentinel.
+template <class B>
+using is_common_join = std::integral_constant<
+    bool,
+    is_common_range<B>::value &&
+        is_iterator_at_least<iterator_t<B>,
+                             std::forward_iterator_tag>::value &&
+        is_common_range<std::remove_reference_t<range_reference_t<B>>>::value>;
+
+template <class B>
+using is_joinable = std::is_lvalue_reference<range_reference_t<B>>;
+}  // namespace detail
+
+// The elements of V's elements, one inner range after another, as in
+// flattening a vector<vector<T>> or vector<string>. The inner ranges must
+// be lvalues.
+//
+// for_each_segment(f) calls f on each inner range in turn, so that
+// ranges::for_each() and ranges::copy() over a join run a tight loop per
+// inner range instead of checking for its end on every element.
+template <class V>
+class join_view : public view_interface<join_view<V>> {
+  static_assert(detail::is_joinable<V>::value,
+                "join needs a range of lvalue ranges");
+
+  template <bool Const>
+  class iterator_impl;
+
+ public:
+  using iterator = iterator_impl<false>;
+  using const_iterator = iterator_impl<true>;
+
+  join_view() = default;
+  explicit join_view(V base) : base_(std::move(base)) {}
+
+  V base() const& { return base_; }
+  V base() && { return std::move(base_); }
+
+  iterator begin() {
+    return iterator(ranges::begin(base_), ranges::end(base_));
+  }
+  auto end() { return end_of<false>(base_); }
+
+  template <class T = const V,
+            std::enable_if_t<detail::is_range<T>::value &&
+                                 detail::is_joinable<T>::value,
+                             int> = 0>
+  const_iterator begin() const {
+    return const_iterator(ranges::begin(base_), ranges::end(base_));
+  }
+  template <class T = const V,
+            std::enable_if_t<detail::is_range<T>::value &&
+                                 detail::is_joinable<T>::value,
+                             int> = 0>
+  auto end() const {
+    return end_of<true>(base_);
+  }
+
+  template <class F>
+  void for_each_segment(F&& f) {
+    segments_of(base_, f);
+  }
+  template <class F, class T = const V,
+            std::enable_if_t<detail::is_range<T>::value &&
+                                 detail::is_joinable<T>::value,
+                             int> = 0>
+  void for_each_segment(F&& f) const {
+    segments_of(base_, f);
+  }
+
+ private:
+  template <bool Const, class B>
+  static auto end_of(B& base) {
+    return end_as<Const>(base, detail::is_common_join<B>{});
+  }
+
+  template <bool Const, class B>
+  static iterator_impl<Const> end_as(B& base, std::true_type) {
+    return iterator_impl<Const>(ranges::end(base), ranges::end(base));
+  }
+
+  template <bool Const, class B>
+  static default_sentinel_t end_as(B&, std::false_type) {
+    return {};
+  }
+
+  template <class B, class F>
+  static void segments_of(B& base, F& f) {
+    const auto last = ranges::end(base);
+    for (auto outer = ranges::begin(base); outer != last; ++outer) {
+      f(*outer);
+    }
+  }
+
+  V base_;
+};
+
+template <class V>
+template <bool Const>
+class join_view<V>::iterator_impl {
+  using base_type = detail::maybe_const_t<Const, V>;
+  using outer_iterator = iterator_t<base_type>;
+  using outer_sentinel = sentinel_t<base_type>;
+  using inner_range = std::remove_reference_t<range_reference_t<base_type>>;
+  using inner_iterator = iterator_t<inner_range>;
+
+ public:
+  using iterator_concept = detail::join_category_t<outer_iterator, inner_range>;
+  using iterator_category = iterator_concept;
+  using value_type = range_value_t<inner_range>;
+  using difference_type =
+      std::common_type_t<range_difference_t<base_type>,
+                         range_difference_t<inner_range>>;
+  using reference = range_reference_t<inner_range>;
+  using pointer = void;
+
+  iterator_impl() = default;
+  iterator_impl(outer_iterator outer, outer_sentinel last)
+      : outer_(std::move(outer)), last_(std::move(last)) {
+    satisfy();
+  }
+  template <bool C = Const, std::enable_if_t<C, int> = 0>
+  iterator_impl(iterator_impl<false> other)
+      : outer_(std::move(other.outer_)),
+        last_(std::move(other.last_)),
+        inner_(std::move(other.inner_)) {}
+
+  reference operator*() const { return *inner_; }
+
+  iterator_impl& operator++() {
+    if (++inner_ == ranges::end(*outer_)) {
+      ++outer_;
+      satisfy();
+    }
+    return *this;
+  }
+  iterator_impl operator++(int) {
+    iterator_impl tmp = *this;
+    ++*this;
+    return tmp;
+  }
+  iterator_impl& operator--() {
+    if (outer_ == last_) {
+      --outer_;
+      inner_ = ranges::end(*outer_);
+    }
+    while (inner_ == ranges::begin(*outer_)) {
+      --outer_;
+      inner_ = ranges::end(*outer_);
+    }
+    --inner_;
+    return *this;
+  }
+  iterator_impl operator--(int) {
+    iterator_impl tmp = *this;
+    --*this;
+    return tmp;
+  }
+
+  friend bool operator==(const iterator_impl& a, const iterator_impl& b) {
+    return a.outer_ == b.outer_ && a.inner_ == b.inner_;
+  }
+  friend bool operator!=(const iterator_impl& a, const iterator_impl& b) {
+    return !(a == b);
+  }
+
+  friend bool operator==(const iterator_impl& it, default_sentinel_t) {
+    return it.outer_ == it.last_;
+  }
+  friend bool operator==(default_sentinel_t, const iterator_impl& it) {
+    return it.outer_ == it.last_;
+  }
+  friend bool operator!=(const iterator_impl& it, default_sentinel_t) {
+    return !(it.outer_ == it.last_);
+  }
+  friend bool operator!=(default_sentinel_t, const iterator_impl& it) {
+    return !(it.outer_ == it.last_);
+  }
+
+ private:
+  friend class iterator_impl<!Const>;
+
+  // Skips empty inner ranges. At the end, inner_ is value-initialized so
+  // that all end iterators compare equal.
+  void satisfy() {
+    for (; outer_ != last_; ++outer_) {
+      inner_ = ranges::begin(*outer_);
+      if (inner_ != ranges::end(*outer_)) {
+        return;
+      }
+    }
+    inner_ = inner_iterator();
+  }
+
+  outer_iterator outer_{};
+  outer_sentinel last_{};
+  inner_iterator inner_{};
+};
+
+// Like join_view, with the elements of Pattern between consecutive inner
+// ranges: views::join_with(words, ' ') puts a space between words. Pattern
+// is held by value; views::join_with() makes it a view of a single element
+// or of the range passed.
+template <class V, class Pattern>
+class join_with_view : public view_interface<join_with_view<V, Pattern>> {
+  static_assert(detail::is_joinable<V>::value,
+                "join_with needs a range of lvalue ranges");
+
+  template <bool Const>
+  class iterator_impl;
+
+ public:
+  using iterator = iterator_impl<false>;
+  using const_iterator = iterator_impl<true>;
+
+  join_with_view() = default;
+  join_with_view(V base, Pattern pattern)
+      : base_(std::move(base)), pattern_(std::move(pattern)) {}
+
+  V base() const& { return base_; }
+  V base() && { return std::move(base_); }
+
+  iterator begin() { return iterator(*this, ranges::begin(base_)); }
+  auto end() { return end_of<false>(*this); }
+
+  template <class T = const V,
+            std::enable_if_t<detail::is_range<T>::value &&
+                                 detail::is_range<const Pattern>::value &&
+                                 detail::is_joinable<T>::value,
+                             int> = 0>
+  const_iterator begin() const {
+    return const_iterator(*this, ranges::begin(base_));
+  }
+  template <class T = const V,
+            std::enable_if_t<detail::is_range<T>::value &&
+                                 detail::is_range<const Pattern>::value &&
+                                 detail::is_joinable<T>::value,
+                             int> = 0>
+  auto end() const {
+    return end_of<true>(*this);
+  }
+
+  template <class F>
+  void for_each_segment(F&& f) {
+    segments_of(*this, f);
+  }
+  template <class F, class T = const V,
+            std::enable_if_t<detail::is_range<T>::value &&
+                                 detail::is_range<const Pattern>::value &&
+                                 detail::is_joinable<T>::value,
+                             int> = 0>
+  void for_each_segment(F&& f) const {
+    segments_of(*this, f);
+  }
+
+ private:
+  template <bool Const, class Parent>
+  static auto end_of(Parent& parent) {
+    return end_as<Const>(
+        parent, detail::is_common_join<detail::maybe_const_t<Const, V>>{});
+  }
+
+  template <bool Const, class Parent>
+  static iterator_impl<Const> end_as(Parent& parent, std::true_type) {
+    return iterator_impl<Const>(parent, ranges::end(parent.base_));
+  }
+
+  template <bool Const, class Parent>
+  static default_sentinel_t end_as(Parent&, std::false_type) {
+    return {};
+  }
+
+  template <class Parent, class F>
+  static void segments_of(Parent& parent, F& f) {
+    const auto last = ranges::end(parent.base_);
+    auto outer = ranges::begin(parent.base_);
+    if (outer == last) {
+      return;
+    }
+    for (f(*outer); ++outer != last; f(*outer)) {
+      f(parent.pattern_);
+    }
+  }
+
+  V base_;
+  Pattern pattern_;
+};
+
+template <class V, class Pattern>
+template <bool Const>
+class join_with_view<V, Pattern>::iterator_impl {
+  using parent_type = detail::maybe_const_t<Const, join_with_view>;
+  using base_type = detail::maybe_const_t<Const, V>;
+  using pattern_type = detail::maybe_const_t<Const, Pattern>;
+  using outer_iterator = iterator_t<base_type>;
+  using inner_range = std::remove_reference_t<range_reference_t<base_type>>;
+  using inner_iterator = iterator_t<inner_range>;
+  using pattern_iterator = iterator_t<pattern_type>;
+
+ public:
+  using iterator_concept =
+      detail::weaker_category_t<std::forward_iterator_tag,
+                                detail::join_category_t<outer_iterator,
+                                                        inner_range,
+                                                        pattern_iterator>>;
+  using iterator_category = iterator_concept;
+  using value_type = std::common_type_t<range_value_t<inner_range>,
+                                        range_value_t<pattern_type>>;
+  using difference_type =
+      std::common_type_t<range_difference_t<base_type>,
+                         range_difference_t<inner_range>,
+                         range_difference_t<pattern_type>>;
+  using reference = common_reference_t<range_reference_t<inner_range>,
+                                       range_reference_t<pattern_type>>;
+  using pointer = void;
+
+  iterator_impl() = default;
+  iterator_impl(parent_type& parent, outer_iterator outer)
+      : parent_(std::addressof(parent)), outer_(std::move(outer)) {
+    if (at_end()) {
+      return;
+    }
+    inner_ = ranges::begin(*outer_);
+    satisfy();
+  }
+  template <bool C = Const, std::enable_if_t<C, int> = 0>
+  iterator_impl(iterator_impl<false> other)
+      : parent_(other.parent_),
+        outer_(std::move(other.outer_)),
+        inner_(std::move(other.inner_)),
+        pattern_(std::move(other.pattern_)),
+        in_pattern_(other.in_pattern_) {}
+
+  reference operator*() const {
+    if (in_pattern_) {
+      return *pattern_;
+    }
+    return *inner_;
+  }
+
+  iterator_impl& operator++() {
+    if (in_pattern_) {
+      ++pattern_;
+    } else {
+      ++inner_;
+    }
+    satisfy();
+    return *this;
+  }
+  iterator_impl operator++(int) {
+    iterator_impl tmp = *this;
+    ++*this;
+    return tmp;
+  }
+
+  friend bool operator==(const iterator_impl& a, const iterator_impl& b) {
+    return a.outer_ == b.outer_ && a.in_pattern_ == b.in_pattern_ &&
+           (a.in_pattern_ ? a.pattern_ == b.pattern_ : a.inner_ == b.inner_);
+  }
+  friend bool operator!=(const iterator_impl& a, const iterator_impl& b) {
+    return !(a == b);
+  }
+
+  friend bool operator==(const iterator_impl& it, default_sentinel_t) {
+    return it.at_end();
+  }
+  friend bool operator==(default_sentinel_t, const iterator_impl& it) {
+    return it.at_end();
+  }
+  friend bool operator!=(const iterator_impl& it, default_sentinel_t) {
+    return !it.at_end();
+  }
+  friend bool operator!=(default_sentinel_t, const iterator_impl& it) {
+    return !it.at_end();
+  }
+
+ private:
+  friend class iterator_impl<!Const>;
+
+  bool at_end() const { return outer_ == ranges::end(parent_->base_); }
+
+  // Moves past the ends of inner ranges and of the pattern, switching
+  // between the two, until at an element or at the end of V.
+  void satisfy() {
+    for (;;) {
+      if (in_pattern_) {
+        if (pattern_ != ranges::end(parent_->pattern_)) {
+          return;
+        }
+        in_pattern_ = false;
+        inner_ = ranges::begin(*outer_);
+      } else {
+        if (inner_ != ranges::end(*outer_)) {
+          return;
+        }
+        ++outer_;
+        if (at_end()) {
+          inner_ = inner_iterator();
+          return;
+        }
+        in_pattern_ = true;
+        pattern_ = ranges::begin(parent_->pattern_);
+      }
+    }
+  }
+
+  parent_type* parent_ = nullptr;
+  outer_iterator outer_{};
+  inner_iterator inner_{};
+  pattern_iterator pattern_{};
+  bool in_pattern_ = false;
+};
+
+namespace views {
+namespace detail {
+struct iota_fn {
+  template <class W>
+  constexpr iota_view<W> operator()(W value) const {
+    return iota_view<W>(value);
+  }
+
+  // Integers of different types meet in their common type, so that
+  // iota(0, v.size()) counts in std::size_t.
+  template <class W, class B,
+            std::enable_if_t<std::is_integral<W>::value &&
+                                 std::is_integral<B>::value,
+                             int> = 0>
+  constexpr auto operator()(W value, B bound) const {
+    using C = std::common_type_t<W, B>;
+    return iota_view<C, C>(static_cast<C>(value), static_cast<C>(bound));
+  }
+
+  template <class W, std::enable_if_t<!std::is_integral<W>::value, int> = 0>
+  constexpr iota_view<W, W> operator()(W value, W bound) const {
+    return iota_view<W, W>(std::move(value), std::move(bound));
+  }
+};
+
+struct counted_fn {
+  // Random-access iterators give a subrange of the same iterators, which
+  // for pointers has data().
+  template <class I,
+            std::enable_if_t<
+                ranges::detail::is_iterator_at_least<
+                    I, std::random_access_iterator_tag>::value,
+                int> = 0>
+  constexpr subrange<I> operator()(I it, iter_difference_t<I> n) const {
+    return subrange<I>(it, it + n);
+  }
+
+  template <class I,
+            std::enable_if_t<
+                !ranges::detail::is_iterator_at_least<
+                    I, std::random_access_iterator_tag>::value,
+                int> = 0>
+  constexpr subrange<counted_iterator<I>> operator()(
+      I it, iter_difference_t<I> n) const {
+    return subrange<counted_iterator<I>>(
+        counted_iterator<I>(std::move(it), n), counted_iterator<I>());
+  }
+};
+
+struct take_fn {
+  template <class R, class N, class V = all_t<R>>
+  constexpr take_view<V> operator()(R&& r, N count) const {
+    return take_view<V>(all(std::forward<R>(r)),
+                        static_cast<range_difference_t<V>>(count));
+  }
+
+  template <class N>
+  constexpr auto operator()(N count) const {
+    return ranges::detail::bind_adaptor<take_fn>(count);
+  }
+};
+
+struct drop_fn {
+  template <class R, class N, class V = all_t<R>>
+  constexpr drop_view<V> operator()(R&& r, N count) const {
+    return drop_view<V>(all(std::forward<R>(r)),
+                        static_cast<range_difference_t<V>>(count));
+  }
+
+  template <class N>
+  constexpr auto operator()(N count) const {
+    return ranges::detail::bind_adaptor<drop_fn>(count);
+  }
+};
+
+struct take_while_fn {
+  template <class R, class Pred>
+  constexpr take_while_view<all_t<R>, std::decay_t<Pred>> operator()(
+      R&& r, Pred&& pred) const {
+    return take_while_view<all_t<R>, std::decay_t<Pred>>(
+        all(std::forward<R>(r)), std::forward<Pred>(pred));
+  }
+
+  template <class Pred>
+  constexpr auto operator()(Pred&& pred) const {
+    return ranges::detail::bind_adaptor<take_while_fn>(
+        std::forward<Pred>(pred));
+  }
+};
+
+struct drop_while_fn {
+  template <class R, class Pred>
+  constexpr drop_while_view<all_t<R>, std::decay_t<Pred>> operator()(
+      R&& r, Pred&& pred) const {
+    return drop_while_view<all_t<R>, std::decay_t<Pred>>(
+        all(std::forward<R>(r)), std::forward<Pred>(pred));
+  }
+
+  template <class Pred>
+  constexpr auto operator()(Pred&& pred) const {
+    return ranges::detail::bind_adaptor<drop_while_fn>(
+        std::forward<Pred>(pred));
+  }
+};
+
+struct zip_fn {
+  template <class... Rs>
+  constexpr zip_view<all_t<Rs>...> operator()(Rs&&... rs) const {
+    return zip_view<all_t<Rs>...>(all(std::forward<Rs>(rs))...);
+  }
+};
+
+// f applied to the elements of a zip, without the tuple in between.
+struct zip_transform_fn {
+  template <class F, class... Rs>
+  constexpr auto operator()(F&& fun, Rs&&... rs) const {
+    using applier = ranges::detail::tuple_applier<std::decay_t<F>>;
+    return transform_view<zip_view<all_t<Rs>...>, applier>(
+        zip_view<all_t<Rs>...>(all(std::forward<Rs>(rs))...),
+        applier(std::forward<F>(fun)));
+  }
+};
+
+struct enumerate_fn {
+  template <class R>
+  constexpr enumerate_view<all_t<R>> operator()(R&& r) const {
+    return enumerate_view<all_t<R>>(all(std::forward<R>(r)));
+  }
+};
+
+// chunk, slide and stride take a positive count.
+struct chunk_fn {
+  template <class R, class N, class V = all_t<R>>
+  constexpr chunk_view<V> operator()(R&& r, N count) const {
+    return chunk_view<V>(all(std::forward<R>(r)),
+                         static_cast<range_difference_t<V>>(count));
+  }
+
+  template <class N>
+  constexpr auto operator()(N count) const {
+    return ranges::detail::bind_adaptor<chunk_fn>(count);
+  }
+};
+
+struct slide_fn {
+  template <class R, class N, class V = all_t<R>>
+  constexpr slide_view<V> operator()(R&& r, N count) const {
+    return slide_view<V>(all(std::forward<R>(r)),
+                         static_cast<range_difference_t<V>>(count));
+  }
+
+  template <class N>
+  constexpr auto operator()(N count) const {
+    return ranges::detail::bind_adaptor<slide_fn>(count);
+  }
+};
+
+struct stride_fn {
+  template <class R, class N, class V = all_t<R>>
+  constexpr stride_view<V> operator()(R&& r, N count) const {
+    return stride_view<V>(all(std::forward<R>(r)),
+                          static_cast<range_difference_t<V>>(count));
+  }
+
+  template <class N>
+  constexpr auto operator()(N count) const {
+    return ranges::detail::bind_adaptor<stride_fn>(count);
+  }
+};
+
+template <std::size_t N>
+struct adjacent_fn {
+  template <class R>
+  constexpr adjacent_view<all_t<R>, N> operator()(R&& r) const {
+    return adjacent_view<all_t<R>, N>(all(std::forward<R>(r)));
+  }
+};
+
+struct join_fn {
+  template <class R>
+  constexpr join_view<all_t<R>> operator()(R&& r) const {
+    return join_view<all_t<R>>(all(std::forward<R>(r)));
+  }
+};
+
+// What join_with holds as its pattern: a single_view of a value, a view as
+// views::all() makes it, or a copy of a range passed as an rvalue, which
+// would not outlive the expression.
+template <class P, std::enable_if_t<!ranges::detail::is_range<
+                                        std::remove_reference_t<P>>::value,
+                                    int> = 0>
+constexpr single_view<std::decay_t<P>> join_pattern(P&& pattern) {
+  return single_view<std::decay_t<P>>(std::forward<P>(pattern));
+}
+
+template <class P,
+          std::enable_if_t<
+              ranges::detail::is_range<std::remove_reference_t<P>>::value &&
+                  (enable_view<std::decay_t<P>>::value ||
+                   std::is_lvalue_reference<P>::value),
+              int> = 0>
+constexpr all_t<P> join_pattern(P&& pattern) {
+  return all(std::forward<P>(pattern));
+}
+
+template <class P,
+          std::enable_if_t<
+              ranges::detail::is_range<std::remove_reference_t<P>>::value &&
+                  !enable_view<std::decay_t<P>>::value &&
+                  !std::is_lvalue_reference<P>::value,
+              int> = 0>
+constexpr std::decay_t<P> join_pattern(P&& pattern) {
+  return std::forward<P>(pattern);
+}
+
+// Builds the view from a pattern join_pattern() has made already.
+struct join_with_pattern_fn {
+  template <class R, class Pattern>
+  constexpr join_with_view<all_t<R>, Pattern> operator()(
+      R&& r, const Pattern& pattern) const {
+    return join_with_view<all_t<R>, Pattern>(all(std::forward<R>(r)),
+                                             pattern);
+  }
+};
+
+struct join_with_fn {
+  template <class R, class P>
+  constexpr auto operator()(R&& r, P&& pattern) const {
+    return join_with_pattern_fn{}(std::forward<R>(r),
+                                  join_pattern(std::forward<P>(pattern)));
+  }
+
+  template <class P>
+  constexpr auto operator()(P&& pattern) const {
+    return ranges::detail::bind_adaptor<join_with_pattern_fn>(
+        join_pattern(std::forward<P>(pattern)));
+  }
+};
+
+struct single_fn {
+  template <class T>
+  constexpr single_view<std::decay_t<T>> operator()(T&& value) const {
+    return single_view<std::decay_t<T>>(std::forward<T>(value));
+  }
+};
+}  // namespace detail
+
+constexpr detail::iota_fn iota{};
+constexpr detail::counted_fn counted{};
+constexpr detail::take_fn take{};
+constexpr detail::drop_fn drop{};
+constexpr detail::take_while_fn take_while{};
+constexpr detail::drop_while_fn drop_while{};
+constexpr detail::zip_fn zip{};
+constexpr detail::zip_transform_fn zip_transform{};
+constexpr ranges::detail::range_closure<detail::enumerate_fn> enumerate{
+    detail::enumerate_fn{}};
+constexpr detail::chunk_fn chunk{};
+constexpr detail::slide_fn slide{};
+constexpr detail::stride_fn stride{};
+template <std::size_t N>
+constexpr ranges::detail::range_closure<detail::adjacent_fn<N>> adjacent{
+    detail::adjacent_fn<N>{}};
+constexpr ranges::detail::range_closure<detail::adjacent_fn<2>> pairwise{
+    detail::adjacent_fn<2>{}};
+constexpr ranges::detail::range_closure<detail::join_fn> join{
+    detail::join_fn{}};
+constexpr detail::join_with_fn join_with{};
+constexpr detail::single_fn single{};
+}  // namespace views
+
+// Conversion of ranges to containers
+//
+// ranges::to<C>(r, args...) builds a C from the elements of r, passing
+// args to C's constructor, and ranges::to<C>(args...) is the closure for
+// `r | ranges::to<C>()`. C may name a template, as in to<std::vector>, for
+// C<range_value_t<R>>, or for C<K, V> from ranges of std::pair<K, V>.
+//
+// C is built directly if it can be from r itself; otherwise empty, after
+// which it reserves ranges::size(r) elements when r is sized and C can
+// reserve. Contiguous ranges of C's trivially copyable value_type are then
+// inserted in one call, which containers turn into a memmove; other
+// ranges are appended element by element. Ranges of ranges whose elements
+// do not convert to C's value_type convert recursively, so that
+// to<std::vector<std::vector<int>>>() works on a range of lists.
+namespace detail {
+// Sized ranges R, for containers C with reserve().
+template <class C, class R, class = void>
+struct can_reserve : std::false_type {};
+
+template <class C, class R>
+struct can_reserve<C, R,
+                   void_t<decltype(std::declval<C&>().reserve(
+                       static_cast<typename C::size_type>(
+                           ranges::size(std::declval<R&>()))))>>
+    : std::true_type {};
+
+template <class C, class R>
+void reserve_for(C& c, R& r, std::true_type) {
+  c.reserve(static_cast<typename C::size_type>(ranges::size(r)));
+}
+
+template <class C, class R>
+void reserve_for(C&, R&, std::false_type) {}
+
+template <class C, class P, class = void>
+struct can_insert_pointers : std::false_type {};
+
+template <class C, class P>
+struct can_insert_pointers<C, P,
+                           void_t<decltype(std::declval<C&>().insert(
+                               std::declval<C&>().end(), std::declval<P>(),
+                               std::declval<P>()))>> : std::true_type {};
+
+// Contiguous ranges of C's trivially copyable value_type, which C can
+// insert as a whole.
+template <class C, class R, class = void>
+struct is_bulk_insertable : std::false_type {};
+
+template <class C, class R>
+struct is_bulk_insertable<
+    C, R,
+    std::enable_if_t<is_contiguous_range<R>::value && is_sized_range<R>::value>>
+    : std::integral_constant<
+          bool,
+          std::is_same<std::remove_cv_t<range_value_t<R>>,
+                       typename C::value_type>::value &&
+              std::is_trivially_copyable<typename C::value_type>::value &&
+              can_insert_pointers<C, decltype(ranges::data(
+                                         std::declval<R&>()))>::value> {};
+
+template <unsigned N>
+struct priority_tag : priority_tag<N - 1> {};
+
+template <>
+struct priority_tag<0> {};
+
+// Appends x with the first of emplace_back(), push_back() and
+// insert(end(), x) that C has.
+template <class C, class T>
+auto append(C& c, T&& x, priority_tag<2>)
+    -> decltype(c.emplace_back(std::forward<T>(x)), void()) {
+  c.emplace_back(std::forward<T>(x));
+}
+
+template <class C, class T>
+auto append(C& c, T&& x, priority_tag<1>)
+    -> decltype(c.push_back(std::forward<T>(x)), void()) {
+  c.push_back(std::forward<T>(x));
+}
+
+template <class C, class T>
+auto append(C& c, T&& x, priority_tag<0>)
+    -> decltype(c.insert(c.end(), std::forward<T>(x)), void()) {
+  c.insert(c.end(), std::forward<T>(x));
+}
+
+template <class C, class R>
+void append_all(C& c, R& r, std::true_type /* bulk */) {
+  const auto first = ranges::data(r);
+  c.insert(c.end(), first,
+           first + static_cast<std::ptrdiff_t>(ranges::size(r)));
+}
+
+template <class C, class R>
+void append_all(C& c, R& r, std::false_type /* bulk */) {
+  const auto last = ranges::end(r);
+  for (auto it = ranges::begin(r); it != last; ++it) {
+    append(c, *it, priority_tag<2>{});
+  }
+}
+
+// Whether the elements of R are themselves converted to C's value_type.
+template <class C, class R, class = void>
+struct is_nested_conversion : std::false_type {};
+
+template <class C, class R>
+struct is_nested_conversion<C, R, void_t<typename C::value_type>>
+    : std::integral_constant<
+          bool, !std::is_convertible<range_reference_t<R>,
+                                     typename C::value_type>::value &&
+                    is_range<std::remove_reference_t<
+                        range_reference_t<R>>>::value> {};
+
+template <class C, class R, class... Args>
+C build_container(R&& r, std::true_type /* constructible */,
+                  Args&&... args) {
+  return C(std::forward<R>(r), std::forward<Args>(args)...);
+}
+
+template <class C, class R, class... Args>
+C build_container(R&& r, std::false_type /* constructible */,
+                  Args&&... args) {
+  C c(std::forward<Args>(args)...);
+  reserve_for(c, r, can_reserve<C, R>{});
+  append_all(c, r, is_bulk_insertable<C, R>{});
+  return c;
+}
+
+template <class C, class R, class... Args>
+C to_container(R&& r, std::false_type /* nested */, Args&&... args) {
+  return build_container<C>(std::forward<R>(r),
+                            std::is_constructible<C, R, Args...>{},
+                            std::forward<Args>(args)...);
+}
+
+template <class C, class R, class... Args>
+C to_container(R&& r, std::true_type /* nested */, Args&&... args) {
+  using value_type = typename C::value_type;
+  C c(std::forward<Args>(args)...);
+  reserve_for(c, r, can_reserve<C, R>{});
+  const auto last = ranges::end(r);
+  for (auto it = ranges::begin(r); it != last; ++it) {
+    auto&& inner = *it;
+    append(c,
+           to_container<value_type>(
+               inner, is_nested_conversion<value_type, decltype(inner)>{}),
+           priority_tag<2>{});
+  }
+  return c;
+}
+
+template <class T>
+struct pair_container_args {};
+
+template <class K, class V>
+struct pair_container_args<std::pair<K, V>> {
+  template <template <class...> class C>
+  using apply = C<std::remove_const_t<K>, V>;
+};
+
+// The C to convert R to for ranges::to<C> with a template C.
+template <template <class...> class C, class R, class = void>
+struct deduce_container {
+  using type = typename pair_container_args<
+      range_value_t<R>>::template apply<C>;
+};
+
+template <template <class...> class C, class R>
+struct deduce_container<C, R, void_t<C<range_value_t<R>>>> {
+  using type = C<range_value_t<R>>;
+};
+
+template <class C>
+struct to_fn {
+  template <class R, class... Args>
+  C operator()(R&& r, const Args&... args) const {
+    return to_container<C>(std::forward<R>(r),
+                           is_nested_conversion<C, R>{}, args...);
+  }
+};
+
+template <template <class...> class C>
+struct to_template_fn {
+  template <class R, class... Args>
+  auto operator()(R&& r, const Args&... args) const {
+    return to_fn<typename deduce_container<C, R>::type>{}(
+        std::forward<R>(r), args...);
+  }
+};
+
+template <class... Args>
+struct starts_with_range : std::false_type {};
+
+template <class First, class... Rest>
+struct starts_with_range<First, Rest...>
+    : is_range<std::remove_reference_t<First>> {};
+}  // namespace detail
+
+template <class C, class R, class... Args,
+          std::enable_if_t<detail::is_range<std::remove_reference_t<R>>::value,
+                           int> = 0>
+C to(R&& r, Args&&... args) {
+  return detail::to_container<C>(std::forward<R>(r),
+                                 detail::is_nested_conversion<C, R>{},
+                                 std::forward<Args>(args)...);
+}
+
+template <template <class...> class C, class R, class... Args,
+          std::enable_if_t<detail::is_range<std::remove_reference_t<R>>::value,
+                           int> = 0>
+auto to(R&& r, Args&&... args) {
+  return ranges::to<typename detail::deduce_container<C, R>::type>(
+      std::forward<R>(r), std::forward<Args>(args)...);
+}
+
+template <class C, class... Args,
+          std::enable_if_t<!detail::starts_with_range<Args...>::value, int> = 0>
+constexpr auto to(Args&&... args) {
+  return detail::bind_adaptor<detail::to_fn<C>>(std::forward<Args>(args)...);
+}
+
+template <template <class...> class C, class... Args,
+          std::enable_if_t<!detail::starts_with_range<Args...>::value, int> = 0>
+constexpr auto to(Args&&... args) {
+  return detail::bind_adaptor<detail::to_template_fn<C>>(
+      std::forward<Args>(args)...);
+}
+}  // namespace ranges
+
+namespace views = ranges::views;
+
+namespace ranges {
+namespace detail {
+template <class T, class U, template <class> class TQual,
+          template <class> class UQual, class = void>
+struct common_tuple_reference {};
+
+template <class... Ts, class... Us, template <class> class TQual,
+          template <class> class UQual>
+struct common_tuple_reference<
+    std::tuple<Ts...>, std::tuple<Us...>, TQual, UQual,
+    std::enable_if_t<sizeof...(Ts) == sizeof...(Us),
+                     void_t<common_reference_t<TQual<Ts>, UQual<Us>>...>>> {
+  using type = common_tuple<common_reference_t<TQual<Ts>, UQual<Us>>...>;
+};
+}  // namespace detail
+}  // namespace ranges
+
+// A common_tuple of references and the std::tuple of values it was read
+// into combine element by element, into a common_tuple of the elements'
+// common references.
+template <class... Ts, class... Us, template <class> class TQual,
+          template <class> class UQual>
+struct basic_common_reference<ranges::common_tuple<Ts...>,
+                              ranges::common_tuple<Us...>, TQual, UQual>
+    : ranges::detail::common_tuple_reference<std::tuple<Ts...>,
+                                             std::tuple<Us...>, TQual, UQual> {
+};
+
+template <class... Ts, class... Us, template <class> class TQual,
+          template <class> class UQual>
+struct basic_common_reference<ranges::common_tuple<Ts...>, std::tuple<Us...>,
+                              TQual, UQual>
+    : ranges::detail::common_tuple_reference<std::tuple<Ts...>,
+                                             std::tuple<Us...>, TQual, UQual> {
+};
+
+template <class... Ts, class... Us, template <class> class TQual,
+          template <class> class UQual>
+struct basic_common_reference<std::tuple<Ts...>, ranges::common_tuple<Us...>,
+                              TQual, UQual>
+    : ranges::detail::common_tuple_reference<std::tuple<Ts...>,
+                                             std::tuple<Us...>, TQual, UQual> {
+};
+}  // namespace v1
+
+using namespace v1;
+}  // namespace stdcpp
+
+namespace std {
+template <class... Ts>
+struct tuple_size<stdcpp::v1::ranges::common_tuple<Ts...>>
+    : std::integral_constant<std::size_t, sizeof...(Ts)> {};
+
+template <std::size_t I, class... Ts>
+struct tuple_element<I, stdcpp::v1::ranges::common_tuple<Ts...>>
+    : std::tuple_element<I, std::tuple<Ts...>> {};
+}  // namespace std
 
 #endif  // __SCC_STDCPP_RANGES_HPP__
\ No newline at end of file
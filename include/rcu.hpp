@@ -0,0 +1,268 @@
+#ifndef __SCC_STDCPP_RCU_HPP__
+#define __SCC_STDCPP_RCU_HPP__
+#pragma once
+
+#include <detail/cpu.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace stdcpp {
+namespace v1 {
+namespace detail {
+// Process-wide epoch domain shared by every rcu_cell.
+//
+// Each thread that reads owns a record announcing the global epoch it
+// observed when it entered its outermost read section (0 while outside).
+// Writers stamp a retired snapshot with the epoch current at unpublish time
+// and free it once every active announcement is newer.
+class rcu_domain {
+ public:
+  // Padded rather than over-aligned: C++14 operator new ignores alignas.
+  struct record {
+    std::atomic<std::uint64_t> epoch{0};
+    std::atomic<bool> in_use{true};
+    record* next = nullptr;
+    unsigned nesting = 0;  // owner thread only
+    char padding[cache_line_size];
+  };
+
+  static rcu_domain& instance() {
+    static rcu_domain domain;
+    return domain;
+  }
+
+  ~rcu_domain() {
+    record* r = head_.load(std::memory_order_acquire);
+    while (r) {
+      record* next = r->next;
+      delete r;
+      r = next;
+    }
+  }
+
+  // Records are never unlinked; a thread that exits hands its record back for
+  // reuse, so the list is bounded by the peak number of reading threads.
+  record* acquire_record() {
+    for (record* r = head_.load(std::memory_order_acquire); r; r = r->next) {
+      bool expected = false;
+      if (!r->in_use.load(std::memory_order_relaxed) &&
+          r->in_use.compare_exchange_strong(expected, true,
+                                            std::memory_order_acquire)) {
+        return r;
+      }
+    }
+    record* r = new record;
+    r->next = head_.load(std::memory_order_relaxed);
+    while (!head_.compare_exchange_weak(r->next, r, std::memory_order_release,
+                                        std::memory_order_relaxed)) {
+    }
+    return r;
+  }
+
+  void release_record(record* r) noexcept {
+    r->epoch.store(0, std::memory_order_release);
+    r->nesting = 0;
+    r->in_use.store(false, std::memory_order_release);
+  }
+
+  void read_lock(record& r) noexcept {
+    if (r.nesting++ == 0) {
+      // An announced epoch greater than a snapshot's stamp means the reader
+      // sees the pointer that replaced it: the acquire load reads from (or
+      // after) the advance() that stamped it, which publish() makes after
+      // swapping the pointer. An announcement at or below the stamp keeps
+      // the snapshot alive; seq_cst pairs it with the writer's scan, so
+      // either the writer sees it or this reader sees the new snapshot.
+      r.epoch.store(epoch_.load(std::memory_order_acquire),
+                    std::memory_order_seq_cst);
+    }
+  }
+
+  void read_unlock(record& r) noexcept {
+    if (--r.nesting == 0) {
+      r.epoch.store(0, std::memory_order_release);
+    }
+  }
+
+  // Returns the epoch a snapshot unpublished just now must be stamped with.
+  std::uint64_t advance() noexcept {
+    return epoch_.fetch_add(1, std::memory_order_seq_cst);
+  }
+
+  // Oldest epoch still announced by a reader, or max() if none is active.
+  std::uint64_t oldest_reader() const noexcept {
+    std::uint64_t oldest = std::numeric_limits<std::uint64_t>::max();
+    for (record* r = head_.load(std::memory_order_acquire); r; r = r->next) {
+      const std::uint64_t e = r->epoch.load(std::memory_order_seq_cst);
+      if (e != 0 && e < oldest) {
+        oldest = e;
+      }
+    }
+    return oldest;
+  }
+
+ private:
+  rcu_domain() = default;
+
+  std::atomic<std::uint64_t> epoch_{1};
+  std::atomic<record*> head_{nullptr};
+};
+
+class rcu_thread_handle {
+ public:
+  rcu_thread_handle() : record_(rcu_domain::instance().acquire_record()) {}
+  ~rcu_thread_handle() { rcu_domain::instance().release_record(record_); }
+
+  rcu_thread_handle(const rcu_thread_handle&) = delete;
+  rcu_thread_handle& operator=(const rcu_thread_handle&) = delete;
+
+  rcu_domain::record& record() noexcept { return *record_; }
+
+ private:
+  rcu_domain::record* record_;
+};
+
+inline rcu_domain::record& this_thread_rcu_record() {
+  thread_local rcu_thread_handle handle;
+  return handle.record();
+}
+}  // namespace detail
+
+// A cell holding an immutable snapshot that readers access without blocking
+// while writers swap in replacements.
+//
+// read() costs one store of the current epoch to a thread-local record (only
+// for the outermost guard on a thread); it never writes a shared cache line.
+// Replaced snapshots are reclaimed once no reader that might still see them
+// remains, which is checked on every publish() and by reclaim().
+//
+// Use it instead of shared_mutex when reads vastly outnumber writes and
+// readers must scale across cores; writers pay for the copy.
+template <class T>
+class rcu_cell {
+ public:
+  using element_type = T;
+
+  class read_guard {
+   public:
+    read_guard(read_guard&& other) noexcept
+        : record_(other.record_), ptr_(other.ptr_) {
+      other.record_ = nullptr;
+      other.ptr_ = nullptr;
+    }
+    read_guard& operator=(read_guard&&) = delete;
+    read_guard(const read_guard&) = delete;
+    read_guard& operator=(const read_guard&) = delete;
+
+    ~read_guard() {
+      if (record_) {
+        detail::rcu_domain::instance().read_unlock(*record_);
+      }
+    }
+
+    const T* get() const noexcept { return ptr_; }
+    const T& operator*() const noexcept { return *ptr_; }
+    const T* operator->() const noexcept { return ptr_; }
+    explicit operator bool() const noexcept { return ptr_ != nullptr; }
+
+   private:
+    friend class rcu_cell;
+    read_guard(detail::rcu_domain::record& record, const T* ptr) noexcept
+        : record_(&record), ptr_(ptr) {}
+
+    detail::rcu_domain::record* record_;
+    const T* ptr_;
+  };
+
+  rcu_cell() noexcept = default;
+  explicit rcu_cell(std::unique_ptr<T> initial) noexcept
+      : current_(initial.release()) {}
+
+  // No reader may hold a guard on this cell when it is destroyed.
+  ~rcu_cell() {
+    delete current_.load(std::memory_order_relaxed);
+    for (auto& r : retired_) {
+      delete r.ptr;
+    }
+  }
+
+  rcu_cell(const rcu_cell&) = delete;
+  rcu_cell& operator=(const rcu_cell&) = delete;
+
+  // Pins the current snapshot until the guard is destroyed. Guards may nest,
+  // including across different cells.
+  read_guard read() const {
+    auto& record = detail::this_thread_rcu_record();
+    detail::rcu_domain::instance().read_lock(record);
+    return read_guard(record, current_.load(std::memory_order_seq_cst));
+  }
+
+  // Atomically replaces the snapshot; the previous one is freed once all
+  // readers that could observe it have left their read sections.
+  void publish(std::unique_ptr<T> next) {
+    T* old = current_.exchange(next.release(), std::memory_order_seq_cst);
+    std::lock_guard<std::mutex> lk(retire_mtx_);
+    if (old) {
+      retired_.push_back({old, detail::rcu_domain::instance().advance()});
+    }
+    reclaim_locked();
+  }
+
+  // Frees what can be freed; returns the number of snapshots still pending.
+  std::size_t reclaim() {
+    std::lock_guard<std::mutex> lk(retire_mtx_);
+    return reclaim_locked();
+  }
+
+  // Blocks until every snapshot retired so far has been freed. Must not be
+  // called from inside a read section.
+  void synchronize() {
+    for (unsigned spins = 0; reclaim() != 0; ++spins) {
+      if (spins < 64) {
+        detail::cpu_relax();
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+ private:
+  struct retired {
+    T* ptr;
+    std::uint64_t epoch;
+  };
+
+  std::size_t reclaim_locked() {
+    if (retired_.empty()) {
+      return 0;
+    }
+    const std::uint64_t oldest = detail::rcu_domain::instance().oldest_reader();
+    std::size_t kept = 0;
+    for (auto& r : retired_) {
+      if (r.epoch < oldest) {
+        delete r.ptr;
+      } else {
+        retired_[kept++] = r;
+      }
+    }
+    retired_.resize(kept);
+    return kept;
+  }
+
+  std::atomic<T*> current_{nullptr};
+  std::mutex retire_mtx_;
+  std::vector<retired> retired_;
+};
+}  // namespace v1
+
+using v1::rcu_cell;
+}  // namespace stdcpp
+
+#endif  // __SCC_STDCPP_RCU_HPP__
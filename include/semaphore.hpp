@@ -0,0 +1,113 @@
+#ifndef __SCC_STDCPP_SEMAPHORE_HPP__
+#define __SCC_STDCPP_SEMAPHORE_HPP__
+#pragma once
+
+#include <atomic.hpp>
+#include <detail/parking.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace stdcpp {
+namespace v1 {
+// C++20 std::counting_semaphore for C++14.
+//
+// The count is a single 32-bit word: acquire() is one CAS decrement when the
+// count is positive and release() one fetch_add. Only when the count is zero
+// does an acquirer spin briefly and then atomic_wait() on the word itself,
+// and release() only makes a wake-up call when someone is waiting.
+template <std::ptrdiff_t LeastMaxValue =
+              std::numeric_limits<std::int32_t>::max()>
+class counting_semaphore {
+  static_assert(LeastMaxValue >= 0, "LeastMaxValue must be non-negative");
+  static_assert(LeastMaxValue <= std::numeric_limits<std::int32_t>::max(),
+                "the count is stored in 32 bits");
+
+ public:
+  static constexpr std::ptrdiff_t max() noexcept { return LeastMaxValue; }
+
+  constexpr explicit counting_semaphore(std::ptrdiff_t desired) noexcept
+      : count_(static_cast<std::int32_t>(desired)) {}
+  ~counting_semaphore() = default;
+
+  counting_semaphore(const counting_semaphore&) = delete;
+  counting_semaphore& operator=(const counting_semaphore&) = delete;
+
+  void release(std::ptrdiff_t update = 1) {
+    count_.fetch_add(static_cast<std::int32_t>(update),
+                     std::memory_order_release);
+    if (update == 1) {
+      v1::atomic_notify_one(&count_);
+    } else {
+      v1::atomic_notify_all(&count_);
+    }
+  }
+
+  void acquire() {
+    if (try_acquire() || spin()) {
+      return;
+    }
+    while (!try_acquire()) {
+      v1::atomic_wait_explicit(&count_, 0, std::memory_order_relaxed);
+    }
+  }
+
+  bool try_acquire() noexcept {
+    std::int32_t count = count_.load(std::memory_order_relaxed);
+    while (count > 0) {
+      if (count_.compare_exchange_weak(count, count - 1,
+                                       std::memory_order_acquire,
+                                       std::memory_order_relaxed)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  template <class Rep, class Period>
+  bool try_acquire_for(const std::chrono::duration<Rep, Period>& rel_time) {
+    return try_acquire_until(std::chrono::steady_clock::now() + rel_time);
+  }
+
+  template <class Clock, class Duration>
+  bool try_acquire_until(
+      const std::chrono::time_point<Clock, Duration>& abs_time) {
+    if (try_acquire() || spin()) {
+      return true;
+    }
+    while (!try_acquire()) {
+      const auto remaining = abs_time - Clock::now();
+      if (remaining <= Clock::duration::zero()) {
+        return false;
+      }
+      detail::atomic_wait_for(
+          &count_, 0, std::memory_order_relaxed,
+          std::chrono::duration_cast<std::chrono::nanoseconds>(remaining) +
+              std::chrono::nanoseconds(1));
+    }
+    return true;
+  }
+
+ private:
+  bool spin() noexcept {
+    return detail::spin_until(
+        [this] {
+          return count_.load(std::memory_order_relaxed) > 0 && try_acquire();
+        },
+        256);
+  }
+
+  std::atomic<std::int32_t> count_;
+};
+
+using binary_semaphore = counting_semaphore<1>;
+}  // namespace v1
+
+using v1::binary_semaphore;
+using v1::counting_semaphore;
+}  // namespace stdcpp
+
+#endif  // __SCC_STDCPP_SEMAPHORE_HPP__
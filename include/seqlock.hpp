@@ -0,0 +1,139 @@
+#ifndef __SCC_STDCPP_SEQLOCK_HPP__
+#define __SCC_STDCPP_SEQLOCK_HPP__
+#pragma once
+
+#include <detail/cpu.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+namespace stdcpp {
+namespace v1 {
+// A sequence lock for small, trivially copyable values that are read far more
+// often than they are written.
+//
+// Readers never write shared memory: they sample the sequence counter, copy
+// the value, and retry if a writer was active or the counter moved. Writers
+// are serialized against each other by claiming the counter (making it odd).
+//
+// The payload is kept in relaxed atomic words so that the optimistic copy is
+// not a data race; the fences follow Boehm, "Can Seqlocks Get Along With
+// Programming Language Memory Models?".
+template <class T>
+class seqlock {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "seqlock<T> requires a trivially copyable T");
+  static_assert(std::is_default_constructible<T>::value,
+                "seqlock<T> requires a default constructible T");
+
+ public:
+  using value_type = T;
+
+  seqlock() noexcept : seqlock(T{}) {}
+  explicit seqlock(const T& value) noexcept { write_words(value); }
+  ~seqlock() = default;
+
+  seqlock(const seqlock&) = delete;
+  seqlock& operator=(const seqlock&) = delete;
+
+  // Returns a consistent copy of the value, retrying while a write overlaps.
+  T load() const noexcept {
+    T value;
+    while (!try_load(value)) {
+      detail::cpu_relax();
+    }
+    return value;
+  }
+
+  // Single optimistic attempt. Returns false (leaving `out` unspecified) if a
+  // writer was active or finished during the copy.
+  bool try_load(T& out) const noexcept {
+    const unsigned before = seq_.load(std::memory_order_acquire);
+    if (before & 1u) {
+      return false;
+    }
+    read_words(out);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return seq_.load(std::memory_order_relaxed) == before;
+  }
+
+  void store(const T& value) noexcept {
+    const unsigned seq = lock_writer();
+    write_words(value);
+    seq_.store(seq + 1, std::memory_order_release);
+  }
+
+  // Read-modify-write under the writer lock; `f` receives a T&.
+  template <class F>
+  void update(F&& f) {
+    const unsigned seq = lock_writer();
+    T value;
+    read_words(value);
+    try {
+      f(value);
+    } catch (...) {
+      seq_.store(seq + 1, std::memory_order_release);
+      throw;
+    }
+    write_words(value);
+    seq_.store(seq + 1, std::memory_order_release);
+  }
+
+  // Number of completed writes; useful to detect changes cheaply.
+  unsigned version() const noexcept {
+    return seq_.load(std::memory_order_acquire) >> 1;
+  }
+
+ private:
+  using word_type = std::size_t;
+  static constexpr std::size_t word_count =
+      (sizeof(T) + sizeof(word_type) - 1) / sizeof(word_type);
+
+  // Claims the counter by moving it from even to odd; returns the odd value.
+  unsigned lock_writer() noexcept {
+    unsigned seq = seq_.load(std::memory_order_relaxed);
+    for (unsigned spins = 0;; ++spins) {
+      if ((seq & 1u) == 0 &&
+          seq_.compare_exchange_weak(seq, seq + 1, std::memory_order_acquire,
+                                     std::memory_order_relaxed)) {
+        // Order the odd counter before the payload stores below.
+        std::atomic_thread_fence(std::memory_order_release);
+        return seq + 1;
+      }
+      if (spins < 64) {
+        detail::cpu_relax();
+      } else {
+        std::this_thread::yield();
+      }
+      seq = seq_.load(std::memory_order_relaxed);
+    }
+  }
+
+  void read_words(T& out) const noexcept {
+    word_type buffer[word_count];
+    for (std::size_t i = 0; i < word_count; ++i) {
+      buffer[i] = words_[i].load(std::memory_order_relaxed);
+    }
+    std::memcpy(&out, buffer, sizeof(T));
+  }
+
+  void write_words(const T& value) noexcept {
+    word_type buffer[word_count] = {};
+    std::memcpy(buffer, &value, sizeof(T));
+    for (std::size_t i = 0; i < word_count; ++i) {
+      words_[i].store(buffer[i], std::memory_order_relaxed);
+    }
+  }
+
+  alignas(detail::cache_line_size) std::atomic<unsigned> seq_{0};
+  std::atomic<word_type> words_[word_count];
+};
+}  // namespace v1
+
+using v1::seqlock;
+}  // namespace stdcpp
+
+#endif  // __SCC_STDCPP_SEQLOCK_HPP__
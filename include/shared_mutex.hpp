@@ -2,86 +2,216 @@
 #define __SCC_STDCPP_SHARED_MUTEX_HPP__
 #pragma once
 
-#include <condition_variable>
-#include <mutex>
-#include <thread>
+#include <atomic.hpp>
+#include <detail/cpu.hpp>
+
+#include <atomic>
 
 namespace stdcpp {
 namespace v1 {
-class shared_mutex {
+// Spin policies decide how long a contended acquisition spins before it
+// parks. A policy provides
+//   unsigned spin_limit();                          // budget, in cpu_relax()s
+//   void on_acquire(unsigned spent, bool parked);   // feedback after spinning
+// and is stored by value in each mutex, so it can be configured per instance.
+
+// Parks immediately on contention.
+struct no_spin {
+  unsigned spin_limit() const noexcept { return 0; }
+  void on_acquire(unsigned, bool) noexcept {}
+};
+
+// Spins for roughly twice as long as recent contended acquisitions had to
+// wait, which tracks how long the lock is typically held. Each acquisition
+// that still had to park halves the budget so long critical sections go
+// straight to sleep; a small floor keeps probing in case hold times drop.
+class adaptive_spin {
  public:
-  shared_mutex() = default;
-  ~shared_mutex() = default;
+  // Enumerators rather than static constexpr members so that odr-uses need
+  // no out-of-line definition in C++14.
+  enum : unsigned { default_max_spins = 4096, min_spins = 16 };
+
+  adaptive_spin() noexcept
+      : adaptive_spin(detail::is_multiprocessor()
+                          ? static_cast<unsigned>(default_max_spins)
+                          : 0u) {}
+  // `max_spins` of 0 disables spinning.
+  explicit adaptive_spin(unsigned max_spins) noexcept
+      : max_spins_(max_spins), estimate_(max_spins / 8) {}
+  adaptive_spin(const adaptive_spin& other) noexcept
+      : max_spins_(other.max_spins_), estimate_(other.estimate()) {}
+  adaptive_spin& operator=(const adaptive_spin& other) noexcept {
+    max_spins_ = other.max_spins_;
+    estimate_.store(other.estimate(), std::memory_order_relaxed);
+    return *this;
+  }
 
-  shared_mutex(const shared_mutex&) = delete;
-  shared_mutex& operator=(const shared_mutex&) = delete;
+  unsigned spin_limit() const noexcept {
+    if (max_spins_ == 0) {
+      return 0;
+    }
+    const unsigned limit = estimate() * 2;
+    return limit < min_spins ? static_cast<unsigned>(min_spins)
+                             : (limit > max_spins_ ? max_spins_ : limit);
+  }
+
+  void on_acquire(unsigned spent, bool parked) noexcept {
+    const unsigned old = estimate();
+    if (parked) {
+      estimate_.store(old / 2, std::memory_order_relaxed);
+      return;
+    }
+    // Exponentially weighted average with a weight of 1/8 on the new sample.
+    const int delta = (static_cast<int>(spent) - static_cast<int>(old)) / 8;
+    estimate_.store(static_cast<unsigned>(static_cast<int>(old) + delta),
+                    std::memory_order_relaxed);
+  }
+
+  unsigned max_spins() const noexcept { return max_spins_; }
+  unsigned estimate() const noexcept {
+    return estimate_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  unsigned max_spins_;
+  std::atomic<unsigned> estimate_;
+};
+
+// Reader-preferring shared mutex. Uncontended lock()/lock_shared() are a
+// single CAS on the state word; contended ones spin as directed by
+// `SpinPolicy` and then atomic_wait() on that same word, so the whole mutex
+// is one word plus the policy (nothing at all for an empty policy).
+template <class SpinPolicy = adaptive_spin>
+class basic_shared_mutex : private SpinPolicy {
+ public:
+  using spin_policy = SpinPolicy;
+
+  basic_shared_mutex() = default;
+  explicit basic_shared_mutex(const SpinPolicy& policy)
+      : SpinPolicy(policy) {}
+  ~basic_shared_mutex() = default;
+
+  basic_shared_mutex(const basic_shared_mutex&) = delete;
+  basic_shared_mutex& operator=(const basic_shared_mutex&) = delete;
 
   // Exclusive locking
   void lock() {
-    std::unique_lock<std::mutex> lk(mtx);
-    exclusive_wait.wait(lk, [this] { return shared_count == 0 && !exclusive; });
-    exclusive = true;
+    if (try_lock()) {
+      return;
+    }
+    auto ready = [this] {
+      return state_.load(std::memory_order_relaxed) == 0;
+    };
+    auto acquire = [this] { return try_lock(); };
+    if (spin(ready, acquire)) {
+      return;
+    }
+    park([](unsigned state) { return state == 0; }, acquire);
   }
 
   bool try_lock() {
-    std::lock_guard<std::mutex> lk(mtx);
-    if (shared_count == 0 && !exclusive) {
-      exclusive = true;
-      return true;
-    }
-    return false;
+    unsigned expected = 0;
+    return state_.compare_exchange_strong(expected, writer_bit,
+                                          std::memory_order_acquire,
+                                          std::memory_order_relaxed);
   }
 
   void unlock() {
-    {
-      std::lock_guard<std::mutex> lk(mtx);
-      exclusive = false;
-    }
-    cv.notify_all();
+    state_.store(0, std::memory_order_release);
+    // Both readers and writers may be waiting; let them all retry.
+    v1::atomic_notify_all(&state_);
   }
 
   // Shared locking
   void lock_shared() {
-    std::unique_lock<std::mutex> lk(mtx);
-    cv.wait(lk, [this] { return !exclusive; });
-    ++shared_count;
+    if (try_lock_shared()) {
+      return;
+    }
+    auto ready = [this] {
+      return (state_.load(std::memory_order_relaxed) & writer_bit) == 0;
+    };
+    auto acquire = [this] { return try_lock_shared(); };
+    if (spin(ready, acquire)) {
+      return;
+    }
+    park([](unsigned state) { return (state & writer_bit) == 0; }, acquire);
   }
 
   bool try_lock_shared() {
-    std::lock_guard<std::mutex> lk(mtx);
-    if (!exclusive) {
-      ++shared_count;
-      return true;
+    unsigned state = state_.load(std::memory_order_relaxed);
+    while ((state & writer_bit) == 0) {
+      if (state_.compare_exchange_weak(state, state + 1,
+                                       std::memory_order_acquire,
+                                       std::memory_order_relaxed)) {
+        return true;
+      }
     }
     return false;
   }
 
   void unlock_shared() {
-    {
-      std::lock_guard<std::mutex> lk(mtx);
-      --shared_count;
-      if (shared_count == 0) {
-        exclusive_wait.notify_one();
-      }
-    }
-    if (shared_count == 0) {
-      cv.notify_one();
+    // Only the last reader out can unblock anyone, and then only writers:
+    // readers never wait while the lock is held shared. A writer that loses
+    // the race for the lock is woken again by whoever won it.
+    if (state_.fetch_sub(1, std::memory_order_release) == 1) {
+      v1::atomic_notify_one(&state_);
     }
   }
 
+  const SpinPolicy& policy() const noexcept { return *this; }
+
   // Native handle (implementation-defined)
   // This example does not implement a native_handle method.
 
  private:
-  std::mutex mtx;
-  std::condition_variable cv;
-  std::condition_variable exclusive_wait;
-  int shared_count = 0;
-  bool exclusive = false;
+  static constexpr unsigned writer_bit = 1u << 31;
+
+  // Spins with exponential backoff while the lock looks taken, retrying the
+  // CAS only when it looks free so the cache line stays shared.
+  template <class Ready, class Acquire>
+  bool spin(Ready ready, Acquire acquire) {
+    SpinPolicy& policy = *this;
+    const unsigned limit = policy.spin_limit();
+    if (limit == 0) {
+      return false;
+    }
+    detail::backoff backoff;
+    unsigned spent = 0;
+    while (spent < limit) {
+      spent += backoff.pause();
+      if (ready() && acquire()) {
+        policy.on_acquire(spent, false);
+        return true;
+      }
+    }
+    policy.on_acquire(spent, true);
+    return false;
+  }
+
+  // Waits for a state that `acceptable` says we could take, then retries.
+  template <class Acceptable, class Acquire>
+  void park(Acceptable acceptable, Acquire acquire) {
+    for (;;) {
+      const unsigned state = state_.load(std::memory_order_relaxed);
+      if (acceptable(state)) {
+        if (acquire()) {
+          return;
+        }
+        continue;
+      }
+      v1::atomic_wait_explicit(&state_, state, std::memory_order_relaxed);
+    }
+  }
+
+  // writer_bit while held exclusively, otherwise the number of readers.
+  std::atomic<unsigned> state_{0};
 };
 }  // namespace v1
 
-using shared_mutex = v1::shared_mutex;
+using v1::adaptive_spin;
+using v1::basic_shared_mutex;
+using v1::no_spin;
+using shared_mutex = v1::basic_shared_mutex<>;
 }  // namespace stdcpp
 
-#endif  // __SCC_STDCPP_SHARED_MUTEX_HPP__
\ No newline at end of file
+#endif  // __SCC_STDCPP_SHARED_MUTEX_HPP__
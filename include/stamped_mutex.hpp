@@ -0,0 +1,246 @@
+#ifndef __SCC_STDCPP_STAMPED_MUTEX_HPP__
+#define __SCC_STDCPP_STAMPED_MUTEX_HPP__
+#pragma once
+
+#include <atomic.hpp>
+#include <detail/cpu.hpp>
+#include <shared_mutex.hpp>
+
+#include <atomic>
+#include <cstdint>
+
+namespace stdcpp {
+namespace v1 {
+// A reader/writer lock with a third, optimistic read mode, after Java's
+// StampedLock.
+//
+// try_optimistic_read() returns a stamp without writing anything; the
+// reader copies what it needs and then validate()s the stamp, retrying
+// (possibly under lock_shared()) if a writer got in between. Readers that
+// meet no writer therefore share the lock's cache line instead of bouncing
+// it, and scale with the number of cores. Data read optimistically may be
+// torn, so it must be read through atomics (relaxed is enough) and only
+// trusted after validate().
+//
+// lock()/lock_shared() behave as in basic_shared_mutex, with the same spin
+// policies, and the try_convert_*() and unlock_*_to_optimistic() members
+// move between modes without releasing the lock in between.
+//
+// The state is one 64-bit word: the reader count in the low 16 bits, the
+// writer bit, and above it a version that every exclusive section bumps. A
+// stamp is the version and writer bit as seen by the reader.
+template <class SpinPolicy = adaptive_spin>
+class basic_stamped_mutex : private SpinPolicy {
+ public:
+  using spin_policy = SpinPolicy;
+  using stamp_type = std::uint64_t;
+
+  basic_stamped_mutex() = default;
+  explicit basic_stamped_mutex(const SpinPolicy& policy)
+      : SpinPolicy(policy) {}
+  ~basic_stamped_mutex() = default;
+
+  basic_stamped_mutex(const basic_stamped_mutex&) = delete;
+  basic_stamped_mutex& operator=(const basic_stamped_mutex&) = delete;
+
+  // Optimistic reading. Returns 0, which never validates, while a writer
+  // holds the lock.
+  stamp_type try_optimistic_read() const noexcept {
+    const std::uint64_t state = state_.load(std::memory_order_acquire);
+    return (state & writer_bit) != 0 ? 0 : state & ~readers_mask;
+  }
+
+  // True if no writer has held the lock since `stamp` was taken. Orders the
+  // reads made before it, as with a seqlock.
+  bool validate(stamp_type stamp) const noexcept {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return stamp != 0 &&
+           (state_.load(std::memory_order_relaxed) & ~readers_mask) == stamp;
+  }
+
+  // Exclusive locking
+  void lock() {
+    if (try_lock()) {
+      return;
+    }
+    auto acceptable = [](std::uint64_t state) {
+      return (state & (writer_bit | readers_mask)) == 0;
+    };
+    auto acquire = [this] { return try_lock(); };
+    if (spin(acceptable, acquire)) {
+      return;
+    }
+    park(acceptable, acquire);
+  }
+
+  bool try_lock() noexcept {
+    std::uint64_t state = state_.load(std::memory_order_relaxed);
+    return (state & (writer_bit | readers_mask)) == 0 &&
+           state_.compare_exchange_strong(state, state | writer_bit,
+                                          std::memory_order_acquire,
+                                          std::memory_order_relaxed) &&
+           fence_writer();
+  }
+
+  void unlock() noexcept {
+    state_.fetch_add(version_unit - writer_bit, std::memory_order_release);
+    v1::atomic_notify_all(&state_);
+  }
+
+  // Shared locking
+  void lock_shared() {
+    if (try_lock_shared()) {
+      return;
+    }
+    auto acceptable = [](std::uint64_t state) {
+      return (state & writer_bit) == 0 &&
+             (state & readers_mask) != readers_mask;
+    };
+    auto acquire = [this] { return try_lock_shared(); };
+    if (spin(acceptable, acquire)) {
+      return;
+    }
+    park(acceptable, acquire);
+  }
+
+  bool try_lock_shared() noexcept {
+    std::uint64_t state = state_.load(std::memory_order_relaxed);
+    while ((state & writer_bit) == 0 &&
+           (state & readers_mask) != readers_mask) {
+      if (state_.compare_exchange_weak(state, state + 1,
+                                       std::memory_order_acquire,
+                                       std::memory_order_relaxed)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void unlock_shared() noexcept { unlock_shared_to_optimistic(); }
+
+  // Conversions. The try_convert_*() members take an optimistic stamp and
+  // succeed only if it still validates.
+  bool try_convert_to_exclusive(stamp_type stamp) noexcept {
+    std::uint64_t expected = stamp;
+    return stamp != 0 &&
+           state_.compare_exchange_strong(expected, stamp | writer_bit,
+                                          std::memory_order_acquire,
+                                          std::memory_order_relaxed) &&
+           fence_writer();
+  }
+
+  bool try_convert_to_shared(stamp_type stamp) noexcept {
+    std::uint64_t state = state_.load(std::memory_order_relaxed);
+    while (stamp != 0 && (state & ~readers_mask) == stamp &&
+           (state & readers_mask) != readers_mask) {
+      if (state_.compare_exchange_weak(state, state + 1,
+                                       std::memory_order_acquire,
+                                       std::memory_order_relaxed)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Shared to exclusive; succeeds only for the sole reader.
+  bool try_upgrade() noexcept {
+    std::uint64_t state = state_.load(std::memory_order_relaxed);
+    while ((state & readers_mask) == 1) {
+      if (state_.compare_exchange_weak(state, (state - 1) | writer_bit,
+                                       std::memory_order_acquire,
+                                       std::memory_order_relaxed)) {
+        return fence_writer();
+      }
+    }
+    return false;
+  }
+
+  // Exclusive to shared. Ends the write, so optimistic stamps taken later
+  // validate while we read.
+  void downgrade() noexcept {
+    state_.fetch_add(version_unit - writer_bit + 1, std::memory_order_release);
+    v1::atomic_notify_all(&state_);
+  }
+
+  // Release the lock and return a stamp that validates until the next
+  // writer.
+  stamp_type unlock_to_optimistic() noexcept {
+    const std::uint64_t state =
+        state_.fetch_add(version_unit - writer_bit,
+                         std::memory_order_release) +
+        (version_unit - writer_bit);
+    v1::atomic_notify_all(&state_);
+    return state & ~readers_mask;
+  }
+
+  stamp_type unlock_shared_to_optimistic() noexcept {
+    const std::uint64_t state =
+        state_.fetch_sub(1, std::memory_order_release);
+    // As in basic_shared_mutex, only the last reader out can unblock
+    // anyone, and then only writers.
+    if ((state & readers_mask) == 1) {
+      v1::atomic_notify_one(&state_);
+    }
+    return state & ~readers_mask;
+  }
+
+  const SpinPolicy& policy() const noexcept { return *this; }
+
+ private:
+  enum : std::uint64_t {
+    readers_mask = 0xffff,
+    writer_bit = 1ull << 16,
+    version_unit = 1ull << 17,
+  };
+
+  // Orders the writer bit before the writer's stores, so an optimistic
+  // reader that sees any of them fails validate(), as in seqlock.
+  static bool fence_writer() noexcept {
+    std::atomic_thread_fence(std::memory_order_release);
+    return true;
+  }
+
+  template <class Acceptable, class Acquire>
+  bool spin(Acceptable acceptable, Acquire acquire) {
+    SpinPolicy& policy = *this;
+    const unsigned limit = policy.spin_limit();
+    if (limit == 0) {
+      return false;
+    }
+    detail::backoff backoff;
+    unsigned spent = 0;
+    while (spent < limit) {
+      spent += backoff.pause();
+      if (acceptable(state_.load(std::memory_order_relaxed)) && acquire()) {
+        policy.on_acquire(spent, false);
+        return true;
+      }
+    }
+    policy.on_acquire(spent, true);
+    return false;
+  }
+
+  template <class Acceptable, class Acquire>
+  void park(Acceptable acceptable, Acquire acquire) {
+    for (;;) {
+      const std::uint64_t state = state_.load(std::memory_order_relaxed);
+      if (acceptable(state)) {
+        if (acquire()) {
+          return;
+        }
+        continue;
+      }
+      v1::atomic_wait_explicit(&state_, state, std::memory_order_relaxed);
+    }
+  }
+
+  // Starts at version 1 so that no valid stamp is 0.
+  std::atomic<std::uint64_t> state_{version_unit};
+};
+}  // namespace v1
+
+using v1::basic_stamped_mutex;
+using stamped_mutex = v1::basic_stamped_mutex<>;
+}  // namespace stdcpp
+
+#endif  // __SCC_STDCPP_STAMPED_MUTEX_HPP__
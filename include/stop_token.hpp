@@ -0,0 +1,405 @@
+#ifndef __SCC_STDCPP_STOP_TOKEN_HPP__
+#define __SCC_STDCPP_STOP_TOKEN_HPP__
+#pragma once
+
+#include <atomic.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+// C++20 cooperative cancellation for C++14: stop_source, stop_token and
+// stop_callback.
+//
+// The shared stop state is one heap object whose state word holds the stop
+// bit and the head of a list of callback slots. A request_stop() on a state
+// nobody registered callbacks with is one fetch_or and therefore
+// wait-free.
+//
+// Registering and removing callbacks is lock-free. A slot holds a pointer
+// to a registered stop_callback, or nothing. Registering claims an empty
+// slot with one CAS, or pushes a new slot onto the list with another;
+// removing empties the slot with a CAS. Slots stay on the list, to be
+// reused, until the state is destroyed, so the list is as long as the most
+// callbacks ever registered at once and is walked without any lock. Only a
+// registration that finds no empty slot allocates.
+//
+// request_stop() sets the stop bit, which freezes the list, and then
+// claims each registered slot before running its callback. Removing a
+// callback that request_stop() already claimed waits for it to finish, as
+// the standard requires, unless that is on the requesting thread.
+
+namespace stdcpp {
+namespace v1 {
+struct nostopstate_t {
+  explicit nostopstate_t() = default;
+};
+constexpr nostopstate_t nostopstate{};
+
+namespace detail {
+struct stop_callback_slot;
+
+struct stop_callback_node {
+  using invoke_fn = void (*)(stop_callback_node*);
+
+  explicit stop_callback_node(invoke_fn fn) noexcept : invoke(fn) {}
+
+  invoke_fn invoke;
+  // The slot this callback is registered in.
+  stop_callback_slot* slot = nullptr;
+  // Set by request_stop() while it runs the callback, so a callback that
+  // destroys its own stop_callback can tell the requester to keep off.
+  bool* destroyed = nullptr;
+  // 1 once the callback has run to completion.
+  std::atomic<std::int32_t> done{0};
+};
+
+struct stop_callback_slot {
+  enum : std::uintptr_t {
+    empty = 0,
+    // Taken by request_stop(), which runs or ran the callback.
+    claimed = 1,
+  };
+
+  // empty, claimed, or the address of a registered stop_callback_node.
+  std::atomic<std::uintptr_t> callback{empty};
+  // Set before the slot is pushed and never changed.
+  stop_callback_slot* next = nullptr;
+};
+
+class stop_state {
+ public:
+  stop_state() = default;
+  stop_state(const stop_state&) = delete;
+  stop_state& operator=(const stop_state&) = delete;
+
+  ~stop_state() {
+    stop_callback_slot* slot = slots(value_.load(std::memory_order_acquire));
+    while (slot != nullptr) {
+      delete std::exchange(slot, slot->next);
+    }
+  }
+
+  void add_owner() noexcept { owners_.fetch_add(1, std::memory_order_relaxed); }
+  void release_owner() noexcept {
+    if (owners_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      delete this;
+    }
+  }
+
+  void add_source() noexcept {
+    sources_.fetch_add(1, std::memory_order_relaxed);
+  }
+  void remove_source() noexcept {
+    sources_.fetch_sub(1, std::memory_order_release);
+  }
+
+  bool stop_requested() const noexcept {
+    return (value_.load(std::memory_order_acquire) & stop_requested_bit) != 0;
+  }
+
+  bool stop_possible() const noexcept {
+    return stop_requested() ||
+           sources_.load(std::memory_order_acquire) != 0;
+  }
+
+  bool request_stop() {
+    const std::uintptr_t old =
+        value_.fetch_or(stop_requested_bit, std::memory_order_seq_cst);
+    if ((old & stop_requested_bit) != 0) {
+      return false;
+    }
+    if (slots(old) == nullptr) {
+      return true;
+    }
+    // Published to removers by the claiming CAS below.
+    requester_ = std::this_thread::get_id();
+    for (stop_callback_slot* slot = slots(old); slot != nullptr;
+         slot = slot->next) {
+      std::uintptr_t callback = slot->callback.load(std::memory_order_seq_cst);
+      // A slot that changes under the CAS was emptied, or refilled by a
+      // registration that will see the stop bit and run its callback
+      // itself.
+      if (callback == stop_callback_slot::empty ||
+          callback == stop_callback_slot::claimed ||
+          !slot->callback.compare_exchange_strong(
+              callback, stop_callback_slot::claimed,
+              std::memory_order_seq_cst)) {
+        continue;
+      }
+      auto* node = reinterpret_cast<stop_callback_node*>(callback);
+      bool destroyed = false;
+      node->destroyed = &destroyed;
+      node->invoke(node);
+      if (!destroyed) {
+        node->destroyed = nullptr;
+        node->done.store(1, std::memory_order_release);
+        // Only the address is used from here on: the owner may already be
+        // gone.
+        v1::atomic_notify_all(&node->done);
+      }
+    }
+    return true;
+  }
+
+  // Returns false, without registering, if stop was already requested; the
+  // caller then runs the callback itself. Allocates, and so may terminate
+  // on allocation failure, only when every slot is taken.
+  bool add(stop_callback_node* node) noexcept {
+    const auto callback = reinterpret_cast<std::uintptr_t>(node);
+    std::uintptr_t head = value_.load(std::memory_order_seq_cst);
+    if ((head & stop_requested_bit) != 0) {
+      return false;
+    }
+    for (stop_callback_slot* slot = slots(head); slot != nullptr;
+         slot = slot->next) {
+      std::uintptr_t expected = stop_callback_slot::empty;
+      if (slot->callback.load(std::memory_order_relaxed) == expected &&
+          slot->callback.compare_exchange_strong(expected, callback,
+                                                 std::memory_order_seq_cst)) {
+        node->slot = slot;
+        // request_stop() may have walked past this slot before we filled
+        // it. Both sides write then read with seq_cst, so if it did, we
+        // see its stop bit here and take the slot back.
+        if (!stop_requested_seq_cst()) {
+          return true;
+        }
+        expected = callback;
+        return !slot->callback.compare_exchange_strong(
+            expected, stop_callback_slot::empty, std::memory_order_seq_cst);
+      }
+    }
+    auto* slot = new stop_callback_slot;
+    slot->callback.store(callback, std::memory_order_relaxed);
+    node->slot = slot;
+    do {
+      if ((head & stop_requested_bit) != 0) {
+        delete slot;
+        return false;
+      }
+      slot->next = slots(head);
+    } while (!value_.compare_exchange_weak(
+        head, reinterpret_cast<std::uintptr_t>(slot),
+        std::memory_order_seq_cst, std::memory_order_seq_cst));
+    return true;
+  }
+
+  // Unregisters `node`. If request_stop() already claimed it, waits for its
+  // callback to finish unless that is running on this very thread.
+  void remove(stop_callback_node* node) noexcept {
+    std::uintptr_t expected = reinterpret_cast<std::uintptr_t>(node);
+    if (node->slot->callback.compare_exchange_strong(
+            expected, stop_callback_slot::empty, std::memory_order_acq_rel,
+            std::memory_order_acquire)) {
+      return;
+    }
+    if (requester_ == std::this_thread::get_id()) {
+      if (node->destroyed != nullptr) {
+        *node->destroyed = true;
+      }
+      return;
+    }
+    v1::atomic_wait_explicit(&node->done, 0, std::memory_order_acquire);
+  }
+
+ private:
+  // The low bit of the state word; the rest is the head of the slot list,
+  // whose nodes are at least pointer aligned.
+  enum : std::uintptr_t { stop_requested_bit = 1 };
+
+  static stop_callback_slot* slots(std::uintptr_t value) noexcept {
+    return reinterpret_cast<stop_callback_slot*>(
+        value & ~std::uintptr_t{stop_requested_bit});
+  }
+
+  bool stop_requested_seq_cst() const noexcept {
+    return (value_.load(std::memory_order_seq_cst) & stop_requested_bit) !=
+           0;
+  }
+
+  std::atomic<std::uintptr_t> value_{0};
+  std::atomic<std::uint32_t> owners_{1};
+  std::atomic<std::uint32_t> sources_{1};
+  // Written once, before request_stop() claims the first slot.
+  std::thread::id requester_;
+};
+}  // namespace detail
+
+class stop_token {
+ public:
+  stop_token() noexcept = default;
+  stop_token(const stop_token& other) noexcept : state_(other.state_) {
+    if (state_ != nullptr) {
+      state_->add_owner();
+    }
+  }
+  stop_token(stop_token&& other) noexcept
+      : state_(std::exchange(other.state_, nullptr)) {}
+  stop_token& operator=(const stop_token& other) noexcept {
+    stop_token(other).swap(*this);
+    return *this;
+  }
+  stop_token& operator=(stop_token&& other) noexcept {
+    stop_token(std::move(other)).swap(*this);
+    return *this;
+  }
+  ~stop_token() {
+    if (state_ != nullptr) {
+      state_->release_owner();
+    }
+  }
+
+  void swap(stop_token& other) noexcept { std::swap(state_, other.state_); }
+
+  bool stop_requested() const noexcept {
+    return state_ != nullptr && state_->stop_requested();
+  }
+  bool stop_possible() const noexcept {
+    return state_ != nullptr && state_->stop_possible();
+  }
+
+  friend bool operator==(const stop_token& a, const stop_token& b) noexcept {
+    return a.state_ == b.state_;
+  }
+  friend bool operator!=(const stop_token& a, const stop_token& b) noexcept {
+    return a.state_ != b.state_;
+  }
+  friend void swap(stop_token& a, stop_token& b) noexcept { a.swap(b); }
+
+ private:
+  friend class stop_source;
+  template <class Callback>
+  friend class stop_callback;
+
+  explicit stop_token(detail::stop_state* state) noexcept : state_(state) {
+    if (state_ != nullptr) {
+      state_->add_owner();
+    }
+  }
+
+  detail::stop_state* state_ = nullptr;
+};
+
+class stop_source {
+ public:
+  stop_source() : state_(new detail::stop_state) {}
+  explicit stop_source(nostopstate_t) noexcept {}
+  stop_source(const stop_source& other) noexcept : state_(other.state_) {
+    if (state_ != nullptr) {
+      state_->add_owner();
+      state_->add_source();
+    }
+  }
+  stop_source(stop_source&& other) noexcept
+      : state_(std::exchange(other.state_, nullptr)) {}
+  stop_source& operator=(const stop_source& other) noexcept {
+    stop_source(other).swap(*this);
+    return *this;
+  }
+  stop_source& operator=(stop_source&& other) noexcept {
+    stop_source(std::move(other)).swap(*this);
+    return *this;
+  }
+  ~stop_source() {
+    if (state_ != nullptr) {
+      state_->remove_source();
+      state_->release_owner();
+    }
+  }
+
+  void swap(stop_source& other) noexcept { std::swap(state_, other.state_); }
+
+  stop_token get_token() const noexcept { return stop_token(state_); }
+
+  bool stop_possible() const noexcept { return state_ != nullptr; }
+  bool stop_requested() const noexcept {
+    return state_ != nullptr && state_->stop_requested();
+  }
+
+  // Runs every registered callback on this thread before returning. Returns
+  // false if stop had already been requested or there is no stop state.
+  bool request_stop() noexcept {
+    return state_ != nullptr && state_->request_stop();
+  }
+
+  friend bool operator==(const stop_source& a, const stop_source& b) noexcept {
+    return a.state_ == b.state_;
+  }
+  friend bool operator!=(const stop_source& a, const stop_source& b) noexcept {
+    return a.state_ != b.state_;
+  }
+  friend void swap(stop_source& a, stop_source& b) noexcept { a.swap(b); }
+
+ private:
+  detail::stop_state* state_ = nullptr;
+};
+
+// Runs `callback` once stop is requested on the token's state: on the
+// requesting thread, or right here in the constructor if stop was already
+// requested. The destructor unregisters it, waiting for a concurrently
+// running invocation to finish.
+template <class Callback>
+class stop_callback : private detail::stop_callback_node {
+ public:
+  using callback_type = Callback;
+
+  template <class C, class = std::enable_if_t<
+                         std::is_constructible<Callback, C>::value>>
+  explicit stop_callback(const stop_token& token, C&& callback) noexcept(
+      std::is_nothrow_constructible<Callback, C>::value)
+      : stop_callback_node(&invoke_callback),
+        callback_(std::forward<C>(callback)) {
+    attach(token.state_);
+  }
+
+  template <class C, class = std::enable_if_t<
+                         std::is_constructible<Callback, C>::value>>
+  explicit stop_callback(stop_token&& token, C&& callback) noexcept(
+      std::is_nothrow_constructible<Callback, C>::value)
+      : stop_callback_node(&invoke_callback),
+        callback_(std::forward<C>(callback)) {
+    attach(token.state_);
+  }
+
+  ~stop_callback() {
+    if (state_ != nullptr) {
+      state_->remove(this);
+      state_->release_owner();
+    }
+  }
+
+  stop_callback(const stop_callback&) = delete;
+  stop_callback& operator=(const stop_callback&) = delete;
+
+ private:
+  static void invoke_callback(stop_callback_node* node) noexcept {
+    std::forward<Callback>(static_cast<stop_callback*>(node)->callback_)();
+  }
+
+  void attach(detail::stop_state* state) noexcept {
+    if (state == nullptr || !state->stop_possible()) {
+      return;
+    }
+    if (state->add(this)) {
+      state->add_owner();
+      state_ = state;
+    } else {
+      invoke_callback(this);
+    }
+  }
+
+  Callback callback_;
+  detail::stop_state* state_ = nullptr;
+};
+}  // namespace v1
+
+using v1::nostopstate;
+using v1::nostopstate_t;
+using v1::stop_callback;
+using v1::stop_source;
+using v1::stop_token;
+}  // namespace stdcpp
+
+#endif  // __SCC_STDCPP_STOP_TOKEN_HPP__
@@ -0,0 +1,111 @@
+#ifndef __SCC_STDCPP_THREAD_HPP__
+#define __SCC_STDCPP_THREAD_HPP__
+#pragma once
+
+#include <stop_token.hpp>
+
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace stdcpp {
+namespace v1 {
+namespace detail {
+// Whether std::thread would call the decayed `F` with a stop_token first.
+template <class F, class... Args>
+struct takes_stop_token {
+ private:
+  template <class G>
+  static auto test(int)
+      -> decltype(std::declval<G>()(std::declval<stop_token>(),
+                                    std::declval<std::decay_t<Args>>()...),
+                  std::true_type{});
+  template <class>
+  static std::false_type test(...);
+
+ public:
+  static constexpr bool value = decltype(test<std::decay_t<F>>(0))::value;
+};
+}  // namespace detail
+
+// C++20 std::jthread for C++14: a std::thread that owns a stop_source,
+// passes its token to the thread function if that accepts one as its first
+// argument, and requests stop and joins on destruction.
+class jthread {
+ public:
+  using id = std::thread::id;
+  using native_handle_type = std::thread::native_handle_type;
+
+  jthread() noexcept : source_(nostopstate) {}
+
+  template <class F, class... Args,
+            class = std::enable_if_t<
+                !std::is_same<std::decay_t<F>, jthread>::value>>
+  explicit jthread(F&& f, Args&&... args)
+      : thread_(start(
+            std::integral_constant<
+                bool, detail::takes_stop_token<F, Args...>::value>{},
+            std::forward<F>(f), std::forward<Args>(args)...)) {}
+
+  ~jthread() { stop_and_join(); }
+
+  jthread(const jthread&) = delete;
+  jthread& operator=(const jthread&) = delete;
+  jthread(jthread&&) noexcept = default;
+  jthread& operator=(jthread&& other) noexcept {
+    if (this != &other) {
+      stop_and_join();
+      source_ = std::move(other.source_);
+      thread_ = std::move(other.thread_);
+    }
+    return *this;
+  }
+
+  void swap(jthread& other) noexcept {
+    source_.swap(other.source_);
+    thread_.swap(other.thread_);
+  }
+  friend void swap(jthread& a, jthread& b) noexcept { a.swap(b); }
+
+  bool joinable() const noexcept { return thread_.joinable(); }
+  void join() { thread_.join(); }
+  void detach() { thread_.detach(); }
+  id get_id() const noexcept { return thread_.get_id(); }
+  native_handle_type native_handle() { return thread_.native_handle(); }
+  static unsigned hardware_concurrency() noexcept {
+    return std::thread::hardware_concurrency();
+  }
+
+  stop_source get_stop_source() noexcept { return source_; }
+  stop_token get_stop_token() const noexcept { return source_.get_token(); }
+  bool request_stop() noexcept { return source_.request_stop(); }
+
+ private:
+  template <class F, class... Args>
+  std::thread start(std::true_type, F&& f, Args&&... args) {
+    return std::thread(std::forward<F>(f), source_.get_token(),
+                       std::forward<Args>(args)...);
+  }
+
+  template <class F, class... Args>
+  std::thread start(std::false_type, F&& f, Args&&... args) {
+    return std::thread(std::forward<F>(f), std::forward<Args>(args)...);
+  }
+
+  void stop_and_join() {
+    if (thread_.joinable()) {
+      source_.request_stop();
+      thread_.join();
+    }
+  }
+
+  // Declared before thread_ so the token exists before the thread starts.
+  stop_source source_;
+  std::thread thread_;
+};
+}  // namespace v1
+
+using v1::jthread;
+}  // namespace stdcpp
+
+#endif  // __SCC_STDCPP_THREAD_HPP__
@@ -0,0 +1,781 @@
+#ifndef __SCC_STDCPP_THREAD_POOL_HPP__
+#define __SCC_STDCPP_THREAD_POOL_HPP__
+#pragma once
+
+#include <atomic.hpp>
+#include <detail/cpu.hpp>
+#include <detail/parking.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// A work-stealing thread pool.
+//
+// Each worker owns a Chase-Lev deque: it pushes and pops its own tasks at
+// the bottom without any read-modify-write in the common case, while idle
+// workers steal from the top of a randomly chosen victim. Tasks submitted
+// from outside the pool land in a per-worker lock-free inbox, which the
+// owner (or a thief) moves into its deque. A worker that finds no work
+// spins briefly and then parks on its own state word, so idle workers cost
+// nothing and a submission wakes at most one of them.
+//
+// Waiting on a task_future or a bulk() from inside a worker runs other
+// tasks meanwhile, so tasks may submit and wait for subtasks freely.
+
+namespace stdcpp {
+namespace v1 {
+class thread_pool;
+
+template <class R>
+class task_future;
+
+namespace detail {
+class pool_task {
+ public:
+  // Runs the task and disposes of it.
+  virtual void run() noexcept = 0;
+
+  // Link in a worker's inbox.
+  pool_task* next = nullptr;
+
+ protected:
+  ~pool_task() = default;
+};
+
+// Chase-Lev work-stealing deque of T*, after Le, Pop, Cohen and Zappa
+// Nardelli, "Correct and Efficient Work-Stealing for Weak Memory Models".
+// push() and take() are for the owning thread only; steal() is for anyone.
+// Outgrown rings are kept until destruction, since a thief may still be
+// reading one.
+template <class T>
+class work_deque {
+ public:
+  explicit work_deque(std::size_t capacity = 256) {
+    rings_.push_back(std::unique_ptr<ring>(new ring(capacity)));
+    ring_.store(rings_.back().get(), std::memory_order_relaxed);
+  }
+
+  work_deque(const work_deque&) = delete;
+  work_deque& operator=(const work_deque&) = delete;
+
+  void push(T* item) {
+    const std::ptrdiff_t b = bottom_.load(std::memory_order_relaxed);
+    const std::ptrdiff_t t = top_.load(std::memory_order_acquire);
+    ring* r = ring_.load(std::memory_order_relaxed);
+    if (b - t > static_cast<std::ptrdiff_t>(r->mask)) {
+      r = grow(r, t, b);
+    }
+    r->put(b, item);
+    bottom_.store(b + 1, std::memory_order_release);
+  }
+
+  // Pops the most recently pushed item, or returns null.
+  T* take() noexcept {
+    const std::ptrdiff_t b = bottom_.load(std::memory_order_relaxed) - 1;
+    ring* r = ring_.load(std::memory_order_relaxed);
+    bottom_.store(b, std::memory_order_release);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::ptrdiff_t t = top_.load(std::memory_order_relaxed);
+    if (t > b) {
+      bottom_.store(b + 1, std::memory_order_release);
+      return nullptr;
+    }
+    T* item = r->get(b);
+    if (t == b) {
+      // The last item: race the thieves for it.
+      if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                        std::memory_order_relaxed)) {
+        item = nullptr;
+      }
+      bottom_.store(b + 1, std::memory_order_release);
+    }
+    return item;
+  }
+
+  // Takes the oldest item, or returns null. `lost` is set if another thread
+  // took it first, in which case more items may remain.
+  T* steal(bool& lost) noexcept {
+    std::ptrdiff_t t = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const std::ptrdiff_t b = bottom_.load(std::memory_order_acquire);
+    lost = false;
+    if (t >= b) {
+      return nullptr;
+    }
+    T* item = ring_.load(std::memory_order_acquire)->get(t);
+    if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+      lost = true;
+      return nullptr;
+    }
+    return item;
+  }
+
+ private:
+  struct ring {
+    explicit ring(std::size_t capacity)
+        : mask(capacity - 1), slots(new std::atomic<T*>[capacity]) {}
+
+    T* get(std::ptrdiff_t i) const noexcept {
+      return slots[static_cast<std::size_t>(i) & mask].load(
+          std::memory_order_relaxed);
+    }
+    void put(std::ptrdiff_t i, T* item) noexcept {
+      slots[static_cast<std::size_t>(i) & mask].store(
+          item, std::memory_order_relaxed);
+    }
+
+    const std::size_t mask;
+    const std::unique_ptr<std::atomic<T*>[]> slots;
+  };
+
+  ring* grow(ring* old, std::ptrdiff_t t, std::ptrdiff_t b) {
+    std::unique_ptr<ring> bigger(new ring((old->mask + 1) * 2));
+    for (std::ptrdiff_t i = t; i != b; ++i) {
+      bigger->put(i, old->get(i));
+    }
+    rings_.push_back(std::move(bigger));
+    ring* r = rings_.back().get();
+    ring_.store(r, std::memory_order_release);
+    return r;
+  }
+
+  // Thieves write top_, the owner bottom_; keep them apart.
+  std::atomic<std::ptrdiff_t> top_{0};
+  char pad_[cache_line_size];
+  std::atomic<std::ptrdiff_t> bottom_{0};
+  std::atomic<ring*> ring_{nullptr};
+  std::vector<std::unique_ptr<ring>> rings_;
+};
+
+// Storage for a task's result; T& and void need no storage of their own.
+template <class R>
+class task_result {
+ public:
+  task_result() = default;
+  task_result(const task_result&) = delete;
+  task_result& operator=(const task_result&) = delete;
+  ~task_result() {
+    if (constructed_) {
+      value()->~R();
+    }
+  }
+
+  template <class F>
+  void set(F& f) {
+    ::new (static_cast<void*>(&storage_)) R(f());
+    constructed_ = true;
+  }
+  R get() { return std::move(*value()); }
+
+ private:
+  R* value() noexcept { return reinterpret_cast<R*>(&storage_); }
+
+  typename std::aligned_storage<sizeof(R), alignof(R)>::type storage_;
+  bool constructed_ = false;
+};
+
+template <class R>
+class task_result<R&> {
+ public:
+  template <class F>
+  void set(F& f) {
+    value_ = &f();
+  }
+  R& get() { return *value_; }
+
+ private:
+  R* value_ = nullptr;
+};
+
+template <>
+class task_result<void> {
+ public:
+  template <class F>
+  void set(F& f) {
+    f();
+  }
+  void get() {}
+};
+
+// State shared by a submitted task and its task_future. Each holds one
+// reference; the last to let go deletes it.
+template <class R>
+class future_state : public pool_task {
+ public:
+  virtual ~future_state() = default;
+
+  void release() noexcept {
+    if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      delete this;
+    }
+  }
+
+  bool ready() const noexcept {
+    return ready_.load(std::memory_order_acquire) != 0;
+  }
+  const std::atomic<std::int32_t>& ready_word() const noexcept {
+    return ready_;
+  }
+
+  R get() {
+    if (error_) {
+      std::rethrow_exception(error_);
+    }
+    return result_.get();
+  }
+
+ protected:
+  template <class F>
+  void complete(F& f) noexcept {
+    try {
+      result_.set(f);
+    } catch (...) {
+      error_ = std::current_exception();
+    }
+    ready_.store(1, std::memory_order_release);
+    v1::atomic_notify_all(&ready_);
+    release();
+  }
+
+ private:
+  std::atomic<std::int32_t> ready_{0};
+  std::atomic<std::int32_t> refs_{2};
+  std::exception_ptr error_;
+  task_result<R> result_;
+};
+
+template <class R, class F>
+class submitted_task final : public future_state<R> {
+ public:
+  template <class G>
+  explicit submitted_task(G&& f) : fn_(std::forward<G>(f)) {}
+
+  void run() noexcept override { this->complete(fn_); }
+
+ private:
+  F fn_;
+};
+
+// A fire-and-forget task. An exception escaping it terminates the program.
+template <class F>
+class executed_task final : public pool_task {
+ public:
+  template <class G>
+  explicit executed_task(G&& f) : fn_(std::forward<G>(f)) {}
+
+  void run() noexcept override {
+    fn_();
+    delete this;
+  }
+
+ private:
+  F fn_;
+};
+
+// One bulk() call: the index range is handed out in chunks of `grain` to
+// the caller and to helper tasks. Helpers that start after the range is
+// exhausted find nothing to do, so the state is reference-counted rather
+// than owned by the caller.
+template <class F>
+class bulk_state {
+ public:
+  bulk_state(F& fn, std::size_t n, std::size_t grain, std::int32_t chunks)
+      : fn_(fn), n_(n), grain_(grain), chunks_left_(chunks) {}
+
+  void add_ref() noexcept { refs_.fetch_add(1, std::memory_order_relaxed); }
+  void release() noexcept {
+    if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      delete this;
+    }
+  }
+
+  // Runs chunks until none are left to claim. After the first exception
+  // the remaining chunks are claimed but skipped.
+  void work() noexcept {
+    for (;;) {
+      const std::size_t begin =
+          next_.fetch_add(grain_, std::memory_order_relaxed);
+      if (begin >= n_) {
+        return;
+      }
+      const std::size_t end = std::min(n_, begin + grain_);
+      if (!failed_.load(std::memory_order_relaxed)) {
+        try {
+          for (std::size_t i = begin; i < end; ++i) {
+            fn_(i);
+          }
+        } catch (...) {
+          if (!failed_.exchange(true, std::memory_order_relaxed)) {
+            error_ = std::current_exception();
+          }
+        }
+      }
+      if (chunks_left_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        v1::atomic_notify_all(&chunks_left_);
+      }
+    }
+  }
+
+  bool done() const noexcept {
+    return chunks_left_.load(std::memory_order_acquire) == 0;
+  }
+  const std::atomic<std::int32_t>& done_word() const noexcept {
+    return chunks_left_;
+  }
+
+  // Valid once done().
+  const std::exception_ptr& error() const noexcept { return error_; }
+
+ private:
+  F& fn_;
+  const std::size_t n_;
+  const std::size_t grain_;
+  std::atomic<std::size_t> next_{0};
+  std::atomic<std::int32_t> chunks_left_;
+  std::atomic<std::int32_t> refs_{1};
+  std::atomic<bool> failed_{false};
+  std::exception_ptr error_;
+};
+
+template <class F>
+class bulk_task final : public pool_task {
+ public:
+  explicit bulk_task(bulk_state<F>* state) noexcept : state_(state) {
+    state_->add_ref();
+  }
+  ~bulk_task() { state_->release(); }
+
+  void run() noexcept override {
+    state_->work();
+    delete this;
+  }
+
+ private:
+  bulk_state<F>* state_;
+};
+
+// The pool and worker index of the calling thread, if it is a worker.
+struct worker_context {
+  thread_pool* pool;
+  std::size_t index;
+};
+
+inline worker_context& this_worker() noexcept {
+  static thread_local worker_context context{nullptr, 0};
+  return context;
+}
+}  // namespace detail
+
+class thread_pool {
+ public:
+  enum : std::size_t { npos = static_cast<std::size_t>(-1) };
+
+  // Starts `workers` threads; 0 means one per hardware thread.
+  explicit thread_pool(std::size_t workers = 0) {
+    if (workers == 0) {
+      workers = std::max(1u, std::thread::hardware_concurrency());
+    }
+    workers_.reserve(workers);
+    for (std::size_t i = 0; i < workers; ++i) {
+      workers_.emplace_back(new worker(static_cast<std::uint32_t>(i)));
+    }
+    try {
+      for (std::size_t i = 0; i < workers; ++i) {
+        workers_[i]->thread = std::thread([this, i] { work(i); });
+      }
+    } catch (...) {
+      shutdown();
+      throw;
+    }
+  }
+
+  // Runs every task submitted so far, including the ones they submit, then
+  // joins the workers.
+  ~thread_pool() { shutdown(); }
+
+  thread_pool(const thread_pool&) = delete;
+  thread_pool& operator=(const thread_pool&) = delete;
+
+  std::size_t size() const noexcept { return workers_.size(); }
+
+  // The calling thread's index among this pool's workers, or npos.
+  std::size_t worker_index() const noexcept {
+    const detail::worker_context& context = detail::this_worker();
+    return context.pool == this ? context.index : npos;
+  }
+
+  // Runs `f()` on some worker. `f` must not throw.
+  template <class F>
+  void execute(F&& f) {
+    execute_to(npos, std::forward<F>(f));
+  }
+
+  // As execute(), but prefers worker `worker % size()`, e.g. the one that
+  // last touched the data `f` works on. Idle workers may still steal it.
+  template <class F>
+  void execute_on(std::size_t worker, F&& f) {
+    execute_to(worker % size(), std::forward<F>(f));
+  }
+
+  // Runs `f()` on some worker; the future yields its result or exception.
+  template <class F>
+  task_future<decltype(std::declval<std::decay_t<F>&>()())> submit(F&& f) {
+    return submit_to(npos, std::forward<F>(f));
+  }
+
+  template <class F>
+  task_future<decltype(std::declval<std::decay_t<F>&>()())> submit_on(
+      std::size_t worker, F&& f) {
+    return submit_to(worker % size(), std::forward<F>(f));
+  }
+
+  // Calls `f(i)` for every i in [0, n) across the pool, the calling thread
+  // included, and returns once all calls have finished. Rethrows the first
+  // exception thrown by `f`; indices after it may be skipped.
+  template <class F>
+  void bulk(std::size_t n, F&& f) {
+    using fn_type = std::remove_reference_t<F>;
+    // A few chunks per worker balance the load without much contention on
+    // the shared index.
+    const std::size_t target = size() * 4;
+    const std::size_t grain = std::max<std::size_t>(1, n / target);
+    const std::size_t chunks = n == 0 ? 0 : (n + grain - 1) / grain;
+    if (chunks <= 1 || size() == 1) {
+      for (std::size_t i = 0; i < n; ++i) {
+        f(i);
+      }
+      return;
+    }
+    auto* state = new detail::bulk_state<fn_type>(
+        f, n, grain, static_cast<std::int32_t>(chunks));
+    const std::size_t self = worker_index();
+    const std::size_t helpers = std::min(chunks, size()) - 1;
+    try {
+      for (std::size_t h = 0; h < helpers; ++h) {
+        std::unique_ptr<detail::bulk_task<fn_type>> task(
+            new detail::bulk_task<fn_type>(state));
+        // From outside, hand one helper to each worker; from inside, let
+        // the others steal them.
+        enqueue(task.get(), self == npos ? h : npos);
+        task.release();
+      }
+    } catch (...) {
+      // Fewer helpers only cost parallelism.
+    }
+    state->work();
+    help_until(state->done_word(), [state] { return state->done(); });
+    const std::exception_ptr error = state->error();
+    state->release();
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+ private:
+  template <class R>
+  friend class task_future;
+
+  enum : std::uint32_t { running = 0, parked = 1 };
+
+  struct worker {
+    explicit worker(std::uint32_t index) noexcept
+        : seed(index * 0x9e3779b9u + 1) {}
+
+    detail::work_deque<detail::pool_task> deque;
+    // Tasks pushed from other threads, newest first.
+    std::atomic<detail::pool_task*> inbox{nullptr};
+    std::atomic<std::uint32_t> state{running};
+    std::uint32_t seed;
+    std::thread thread;
+    char pad[detail::cache_line_size];
+  };
+
+  template <class F>
+  void execute_to(std::size_t hint, F&& f) {
+    std::unique_ptr<detail::executed_task<std::decay_t<F>>> task(
+        new detail::executed_task<std::decay_t<F>>(std::forward<F>(f)));
+    enqueue(task.get(), hint);
+    task.release();
+  }
+
+  template <class F>
+  task_future<decltype(std::declval<std::decay_t<F>&>()())> submit_to(
+      std::size_t hint, F&& f) {
+    using result_type = decltype(std::declval<std::decay_t<F>&>()());
+    auto* state = new detail::submitted_task<result_type, std::decay_t<F>>(
+        std::forward<F>(f));
+    task_future<result_type> future(state);
+    try {
+      enqueue(state, hint);
+    } catch (...) {
+      // Drop the pool's reference; the future drops the other.
+      state->release();
+      throw;
+    }
+    return future;
+  }
+
+  // Queues `task`, on worker `hint` if that is not npos, and wakes a worker
+  // for it. Throws only if the deque cannot grow, leaving `task` unqueued.
+  void enqueue(detail::pool_task* task, std::size_t hint) {
+    const std::size_t self = worker_index();
+    if (self != npos && (hint == npos || hint == self)) {
+      workers_[self]->deque.push(task);
+      wake_any();
+      return;
+    }
+    const bool hinted = hint != npos;
+    if (!hinted) {
+      hint = submit_cursor_.fetch_add(1, std::memory_order_relaxed) % size();
+    }
+    worker& target = *workers_[hint];
+    detail::pool_task* head = target.inbox.load(std::memory_order_relaxed);
+    do {
+      task->next = head;
+    } while (!target.inbox.compare_exchange_weak(head, task,
+                                                 std::memory_order_release,
+                                                 std::memory_order_relaxed));
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    // A hinted task waits for its busy worker unless an awake one steals it.
+    if (!wake(target) && !hinted) {
+      wake_any_after_fence();
+    }
+  }
+
+  void work(std::size_t self) {
+    detail::this_worker() = detail::worker_context{this, self};
+    for (;;) {
+      detail::pool_task* task = find_work(self);
+      if (task == nullptr &&
+          !detail::spin_until(
+              [&] { return (task = find_work(self)) != nullptr; }, 1024)) {
+        if (!park(self, task)) {
+          return;
+        }
+        if (task == nullptr) {
+          continue;
+        }
+      }
+      task->run();
+    }
+  }
+
+  bool run_one(std::size_t self) {
+    detail::pool_task* task = find_work(self);
+    if (task == nullptr) {
+      return false;
+    }
+    task->run();
+    return true;
+  }
+
+  // Own deque first, then own inbox, then other workers in random order.
+  detail::pool_task* find_work(std::size_t self) {
+    worker& me = *workers_[self];
+    if (detail::pool_task* task = me.deque.take()) {
+      return task;
+    }
+    if (detail::pool_task* task = drain(me.inbox, me)) {
+      return task;
+    }
+    const std::size_t n = size();
+    // xorshift32
+    me.seed ^= me.seed << 13;
+    me.seed ^= me.seed >> 17;
+    me.seed ^= me.seed << 5;
+    const std::size_t start = me.seed % n;
+    for (std::size_t k = 0; k < n; ++k) {
+      worker& victim = *workers_[(start + k) % n];
+      if (&victim == &me) {
+        continue;
+      }
+      bool lost;
+      do {
+        if (detail::pool_task* task = victim.deque.steal(lost)) {
+          return task;
+        }
+      } while (lost);
+      if (detail::pool_task* task = drain(victim.inbox, me)) {
+        return task;
+      }
+    }
+    return nullptr;
+  }
+
+  // Moves an inbox into `me`'s deque. The inbox is newest first, so the
+  // deque hands out the oldest task first.
+  detail::pool_task* drain(std::atomic<detail::pool_task*>& inbox,
+                           worker& me) {
+    if (inbox.load(std::memory_order_relaxed) == nullptr) {
+      return nullptr;
+    }
+    detail::pool_task* task =
+        inbox.exchange(nullptr, std::memory_order_acquire);
+    while (task != nullptr) {
+      detail::pool_task* next = task->next;
+      me.deque.push(task);
+      task = next;
+    }
+    return me.deque.take();
+  }
+
+  // Announces the worker as parked, looks for work once more into `task`,
+  // and sleeps until woken if there is none. Returns false once the pool is
+  // stopping and no work is left.
+  bool park(std::size_t self, detail::pool_task*& task) {
+    worker& me = *workers_[self];
+    me.state.store(parked, std::memory_order_relaxed);
+    idle_.fetch_add(1, std::memory_order_seq_cst);
+    // Pairs with the fence in enqueue(): either the submitter sees us
+    // parked, or we see its task.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    // Read before looking, so a stopping pool's last tasks are seen.
+    const bool stopping = stopping_.load(std::memory_order_acquire);
+    task = find_work(self);
+    if (task != nullptr || stopping) {
+      if (me.state.exchange(running, std::memory_order_relaxed) == parked) {
+        idle_.fetch_sub(1, std::memory_order_relaxed);
+      }
+      return task != nullptr;
+    }
+    v1::atomic_wait_explicit(&me.state, static_cast<std::uint32_t>(parked),
+                             std::memory_order_acquire);
+    return true;
+  }
+
+  // Wakes `w` if it is parked. The caller has issued a seq_cst fence after
+  // publishing its task.
+  bool wake(worker& w) noexcept {
+    if (w.state.load(std::memory_order_relaxed) != parked ||
+        w.state.exchange(running, std::memory_order_acq_rel) != parked) {
+      return false;
+    }
+    idle_.fetch_sub(1, std::memory_order_relaxed);
+    v1::atomic_notify_one(&w.state);
+    return true;
+  }
+
+  void wake_any() noexcept {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    wake_any_after_fence();
+  }
+
+  void wake_any_after_fence() noexcept {
+    if (idle_.load(std::memory_order_relaxed) == 0) {
+      return;
+    }
+    const std::size_t n = size();
+    const std::size_t start =
+        wake_cursor_.fetch_add(1, std::memory_order_relaxed);
+    for (std::size_t k = 0; k < n; ++k) {
+      if (wake(*workers_[(start + k) % n])) {
+        return;
+      }
+    }
+  }
+
+  void shutdown() noexcept {
+    stopping_.store(true, std::memory_order_release);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    for (auto& w : workers_) {
+      wake(*w);
+    }
+    for (auto& w : workers_) {
+      if (w->thread.joinable()) {
+        w->thread.join();
+      }
+    }
+  }
+
+  // Waits for `done()`, running pool tasks meanwhile if called on a worker.
+  // `done()` must only become true after `word` changes.
+  template <class Done>
+  static void help_until(const std::atomic<std::int32_t>& word, Done done) {
+    const detail::worker_context context = detail::this_worker();
+    while (!done()) {
+      if (context.pool != nullptr && context.pool->run_one(context.index)) {
+        continue;
+      }
+      if (detail::spin_until(done, 256)) {
+        return;
+      }
+      const std::int32_t current = word.load(std::memory_order_acquire);
+      if (done()) {
+        return;
+      }
+      v1::atomic_wait_explicit(&word, current, std::memory_order_acquire);
+    }
+  }
+
+  std::vector<std::unique_ptr<worker>> workers_;
+  std::atomic<std::size_t> idle_{0};
+  std::atomic<std::size_t> submit_cursor_{0};
+  std::atomic<std::size_t> wake_cursor_{0};
+  std::atomic<bool> stopping_{false};
+};
+
+// The result of thread_pool::submit(). Unlike std::future, destroying it
+// does not wait for the task.
+template <class R>
+class task_future {
+ public:
+  task_future() noexcept = default;
+  task_future(task_future&& other) noexcept
+      : state_(std::exchange(other.state_, nullptr)) {}
+  task_future& operator=(task_future&& other) noexcept {
+    task_future(std::move(other)).swap(*this);
+    return *this;
+  }
+  ~task_future() {
+    if (state_ != nullptr) {
+      state_->release();
+    }
+  }
+
+  task_future(const task_future&) = delete;
+  task_future& operator=(const task_future&) = delete;
+
+  void swap(task_future& other) noexcept { std::swap(state_, other.state_); }
+
+  bool valid() const noexcept { return state_ != nullptr; }
+  bool is_ready() const noexcept { return state_->ready(); }
+
+  void wait() const {
+    detail::future_state<R>* state = state_;
+    thread_pool::help_until(state->ready_word(),
+                            [state] { return state->ready(); });
+  }
+
+  // Waits, then returns the result or rethrows the exception. Leaves the
+  // future invalid.
+  R get() {
+    wait();
+    task_future released(std::move(*this));
+    return released.state_->get();
+  }
+
+ private:
+  friend class thread_pool;
+
+  explicit task_future(detail::future_state<R>* state) noexcept
+      : state_(state) {}
+
+  detail::future_state<R>* state_ = nullptr;
+};
+}  // namespace v1
+
+using v1::task_future;
+using v1::thread_pool;
+}  // namespace stdcpp
+
+#endif  // __SCC_STDCPP_THREAD_POOL_HPP__
@@ -2,10 +2,29 @@
 #define __SCC_STDCPP_HPP__
 #pragma once
 
+#include <algorithm.hpp>
+#include <async_shared_mutex.hpp>
+#include <atomic.hpp>
+#include <barrier.hpp>
+#include <concurrent_unordered_map.hpp>
+#include <condition_variable.hpp>
+#include <execution.hpp>
+#include <hazard_pointer.hpp>
 #include <iterator.hpp>
+#include <latch.hpp>
+#include <lock_stats.hpp>
+#include <numeric.hpp>
+#include <queue.hpp>
 #include <ranges.hpp>
+#include <rcu.hpp>
+#include <seqlock.hpp>
+#include <semaphore.hpp>
 #include <shared_mutex.hpp>
+#include <stamped_mutex.hpp>
+#include <stop_token.hpp>
 #include <string.hpp>
+#include <thread.hpp>
+#include <thread_pool.hpp>
 #include <type_traits.hpp>
 #include <utility.hpp>
 
@@ -0,0 +1,395 @@
+#include <gtest/gtest.h>
+#include <algorithm.hpp>
+
+#include <chrono.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <list>
+#include <numeric>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+// A join of rows that counts the segments it hands to algorithms.
+struct counted_join {
+  std::vector<std::vector<int>>* rows;
+  int* visited;
+
+  auto begin() const { return (*rows | stdcpp::views::join).begin(); }
+  auto end() const { return (*rows | stdcpp::views::join).end(); }
+
+  template <class F>
+  void for_each_segment(F&& f) const {
+    for (auto& row : *rows) {
+      ++*visited;
+      f(row);
+    }
+  }
+};
+
+// A user type that is contiguous through data() and size().
+struct byte_buffer {
+  std::vector<unsigned char> bytes;
+
+  unsigned char* data() { return bytes.data(); }
+  const unsigned char* data() const { return bytes.data(); }
+  std::size_t size() const { return bytes.size(); }
+  auto begin() { return bytes.begin(); }
+  auto end() { return bytes.end(); }
+  auto begin() const { return bytes.begin(); }
+  auto end() const { return bytes.end(); }
+};
+}  // namespace
+
+TEST(stdcpp_algorithm, for_each) {
+  std::vector<int> v{1, 2, 3};
+  int sum = 0;
+  auto result = stdcpp::ranges::for_each(v, [&sum](int& x) {
+    sum += x;
+    x *= 2;
+  });
+  ASSERT_EQ(sum, 6);
+  ASSERT_EQ(result.in, v.end());
+  ASSERT_EQ(v, (std::vector<int>{2, 4, 6}));
+
+  std::list<int> l{4, 5};
+  auto counter = stdcpp::ranges::for_each(l.begin(), l.end(),
+                                          [n = 0](int) mutable { ++n; });
+  ASSERT_EQ(counter.in, l.end());
+}
+
+TEST(stdcpp_algorithm, copy) {
+  std::vector<int> v{1, 2, 3};
+  std::vector<int> out(3);
+  auto result = stdcpp::ranges::copy(v, out.begin());
+  ASSERT_EQ(result.in, v.end());
+  ASSERT_EQ(result.out, out.end());
+  ASSERT_EQ(out, v);
+
+  std::list<char> l{'a', 'b'};
+  std::string s;
+  stdcpp::ranges::copy(l.begin(), l.end(), std::back_inserter(s));
+  ASSERT_EQ(s, "ab");
+}
+
+TEST(stdcpp_algorithm, segmented_ranges_go_segment_by_segment) {
+  std::vector<std::vector<int>> vv{{1, 2}, {}, {3, 4, 5}};
+  std::vector<int> out;
+  auto joined = vv | stdcpp::views::join;
+  auto result = stdcpp::ranges::copy(joined, std::back_inserter(out));
+  ASSERT_EQ(out, (std::vector<int>{1, 2, 3, 4, 5}));
+  ASSERT_TRUE(result.in == joined.end());
+
+  std::vector<std::string> words{"ab", "cd", "e"};
+  std::string s;
+  stdcpp::ranges::for_each(words | stdcpp::views::join_with(std::string(", ")),
+                           [&s](char c) { s += c; });
+  ASSERT_EQ(s, "ab, cd, e");
+
+  int visited = 0;
+  std::vector<std::vector<int>> rows{{1}, {2, 3}};
+  int sum = 0;
+  stdcpp::ranges::for_each(counted_join{&rows, &visited},
+                           [&sum](int x) { sum += x; });
+  ASSERT_EQ(sum, 6);
+  ASSERT_EQ(visited, 2);
+}
+
+TEST(stdcpp_algorithm, parallel_for_each_and_transform) {
+  stdcpp::thread_pool pool(4);
+  auto par = stdcpp::execution::par.on(pool).with_grain(100);
+  std::vector<int> v(10000);
+  std::iota(v.begin(), v.end(), 0);
+  std::atomic<long> sum{0};
+  stdcpp::for_each(par, v.begin(), v.end(), [&sum](int x) { sum += x; });
+  ASSERT_EQ(sum.load(), 10000L * 9999 / 2);
+
+  std::vector<int> doubled(v.size());
+  stdcpp::ranges::transform(par, v, doubled.begin(),
+                            [](int x) { return 2 * x; });
+  std::vector<int> diff(v.size());
+  stdcpp::transform(stdcpp::execution::par_unseq, doubled.begin(),
+                    doubled.end(), v.begin(), diff.begin(), std::minus<>());
+  ASSERT_EQ(diff, v);
+
+  // Not random access: runs sequentially.
+  std::list<int> l{1, 2, 3};
+  stdcpp::ranges::for_each(par, l, [](int& x) { x *= 10; });
+  ASSERT_EQ(l, (std::list<int>{10, 20, 30}));
+}
+
+TEST(stdcpp_algorithm, parallel_copy_if_keeps_order) {
+  stdcpp::thread_pool pool(4);
+  std::vector<int> v(10000);
+  std::iota(v.begin(), v.end(), 0);
+  auto odd = [](int x) { return x % 2 != 0 && x % 3 != 0; };
+  std::vector<int> expected;
+  std::copy_if(v.begin(), v.end(), std::back_inserter(expected), odd);
+  std::vector<int> out(v.size());
+  auto last = stdcpp::ranges::copy_if(
+      stdcpp::execution::par.on(pool).with_grain(100), v, out.begin(), odd);
+  out.erase(last, out.end());
+  ASSERT_EQ(out, expected);
+}
+
+TEST(stdcpp_algorithm, parallel_sort) {
+  stdcpp::thread_pool pool(4);
+  std::mt19937 rng(42);
+  for (std::size_t n : {0u, 1u, 100u, 4099u, 50000u}) {
+    std::vector<int> v(n);
+    for (auto& x : v) {
+      x = static_cast<int>(rng() % 1000);
+    }
+    auto expected = v;
+    std::sort(expected.begin(), expected.end());
+    stdcpp::sort(stdcpp::execution::par.on(pool).with_grain(1000), v.begin(),
+                 v.end());
+    ASSERT_EQ(v, expected);
+  }
+
+  std::vector<std::string> words;
+  for (int i = 0; i < 5000; ++i) {
+    words.push_back(std::to_string(rng()));
+  }
+  auto expected = words;
+  std::sort(expected.begin(), expected.end(), std::greater<>());
+  stdcpp::ranges::sort(stdcpp::execution::par.on(pool).with_grain(300), words,
+                       std::greater<>());
+  ASSERT_EQ(words, expected);
+
+  std::vector<int> small{3, 1, 2};
+  stdcpp::ranges::sort(stdcpp::execution::seq, small);
+  ASSERT_EQ(small, (std::vector<int>{1, 2, 3}));
+}
+
+TEST(stdcpp_algorithm, count_and_find) {
+  // Long enough for the SIMD kernels, with hits near both ends.
+  std::vector<int> v(1000, 5);
+  v[3] = 7;
+  v[998] = 7;
+  ASSERT_EQ(stdcpp::ranges::count(v, 7), 2);
+  ASSERT_EQ(stdcpp::ranges::count(v, 5), 998);
+  ASSERT_EQ(stdcpp::ranges::find(v, 7), v.begin() + 3);
+  ASSERT_EQ(stdcpp::ranges::find(v, 8), v.end());
+  ASSERT_EQ(stdcpp::ranges::find(v.data() + 4, v.data() + v.size(), 7),
+            v.data() + 998);
+
+  // More matches than an 8-bit lane can count.
+  std::vector<unsigned char> bytes(5000, 'x');
+  ASSERT_EQ(stdcpp::ranges::count(bytes, 'x'), 5000);
+  // 'x' + 256 is not an unsigned char, so nothing matches it.
+  ASSERT_EQ(stdcpp::ranges::count(bytes, 'x' + 256), 0);
+  ASSERT_EQ(stdcpp::ranges::find(bytes, 'x' + 256), bytes.end());
+
+  std::vector<double> d{0.1, 0.2, 0.3};
+  ASSERT_EQ(stdcpp::ranges::count(d, 0.2), 1);
+  ASSERT_EQ(stdcpp::ranges::count(d, 0.2f), 0);
+
+  std::list<std::string> l{"a", "b", "a"};
+  ASSERT_EQ(stdcpp::ranges::count(l, "a"), 2);
+  ASSERT_EQ(*stdcpp::ranges::find(l, "b"), "b");
+
+  std::vector<std::vector<int>> rows{{7, 1}, {}, {7}};
+  ASSERT_EQ(stdcpp::ranges::count(rows | stdcpp::views::join, 7), 2);
+}
+
+TEST(stdcpp_algorithm, minmax) {
+  std::vector<int> v(1000);
+  std::iota(v.begin(), v.end(), -500);
+  std::swap(v[0], v[700]);
+  auto result = stdcpp::ranges::minmax(v);
+  ASSERT_EQ(result.min, -500);
+  ASSERT_EQ(result.max, 499);
+
+  std::vector<float> f{2.5f, -1.0f, 8.0f};
+  ASSERT_EQ(stdcpp::ranges::minmax(f).min, -1.0f);
+  ASSERT_EQ(stdcpp::ranges::minmax(f).max, 8.0f);
+
+  // The first least and the last greatest.
+  std::vector<std::pair<int, int>> pairs{{1, 0}, {0, 1}, {1, 2}, {0, 3}};
+  auto by_first = [](const auto& a, const auto& b) {
+    return a.first < b.first;
+  };
+  auto p = stdcpp::ranges::minmax(pairs, by_first);
+  ASSERT_EQ(p.min, std::make_pair(0, 1));
+  ASSERT_EQ(p.max, std::make_pair(1, 2));
+
+  std::list<int> l{3, 1, 2};
+  auto reversed = stdcpp::ranges::minmax(l, std::greater<>());
+  ASSERT_EQ(reversed.min, 3);
+  ASSERT_EQ(reversed.max, 1);
+}
+
+TEST(stdcpp_algorithm, equal_mismatch_and_lexicographical_compare) {
+  std::vector<int> a(1000);
+  std::iota(a.begin(), a.end(), 0);
+  std::vector<int> b = a;
+  ASSERT_TRUE(stdcpp::ranges::equal(a, b));
+  b[700] = -1;
+  ASSERT_FALSE(stdcpp::ranges::equal(a, b));
+  auto diff = stdcpp::ranges::mismatch(a, b);
+  ASSERT_EQ(diff.in1, a.begin() + 700);
+  ASSERT_EQ(diff.in2, b.begin() + 700);
+  ASSERT_TRUE(stdcpp::ranges::lexicographical_compare(b, a));
+  ASSERT_FALSE(stdcpp::ranges::lexicographical_compare(a, b));
+
+  std::vector<int> prefix(a.begin(), a.begin() + 10);
+  ASSERT_FALSE(stdcpp::ranges::equal(a, prefix));
+  ASSERT_TRUE(stdcpp::ranges::lexicographical_compare(prefix, a));
+  ASSERT_FALSE(stdcpp::ranges::lexicographical_compare(a, prefix));
+  ASSERT_EQ(stdcpp::ranges::mismatch(prefix, a).in1, prefix.end());
+
+  byte_buffer x{{1, 2, 3}};
+  byte_buffer y{{1, 2, 200}};
+  ASSERT_FALSE(stdcpp::ranges::equal(x, y));
+  ASSERT_TRUE(stdcpp::ranges::lexicographical_compare(x, y));
+  ASSERT_EQ(stdcpp::ranges::mismatch(x, y).in2, y.begin() + 2);
+  ASSERT_EQ(stdcpp::ranges::find(y, 200), y.begin() + 2);
+
+  // Plain char may be signed, which memcmp does not know about.
+  std::string high("\xff");
+  std::string low("a");
+  ASSERT_EQ(stdcpp::ranges::lexicographical_compare(high, low),
+            high[0] < low[0]);
+
+  // Equal floating-point values need not have equal bytes.
+  std::vector<double> zero{0.0};
+  std::vector<double> negative_zero{-0.0};
+  ASSERT_TRUE(stdcpp::ranges::equal(zero, negative_zero));
+
+  std::list<std::string> words{"a", "b"};
+  std::vector<std::string> same{"a", "b"};
+  ASSERT_TRUE(stdcpp::ranges::equal(words, same));
+  ASSERT_TRUE(stdcpp::ranges::equal(a, b, [](int, int) { return true; }));
+}
+
+TEST(stdcpp_algorithm, fill_and_copy_arrays) {
+  std::vector<double> d(100, 1.0);
+  ASSERT_EQ(stdcpp::ranges::fill(d, 0.0), d.end());
+  ASSERT_EQ(d[99], 0.0);
+  stdcpp::ranges::fill(d, -0.0);
+  ASSERT_TRUE(std::signbit(d[50]));
+  stdcpp::ranges::fill(d, 2.5);
+  ASSERT_EQ(d[0], 2.5);
+
+  byte_buffer buffer{std::vector<unsigned char>(64)};
+  stdcpp::ranges::fill(buffer, 0xab);
+  ASSERT_EQ(stdcpp::ranges::count(buffer, 0xab), 64);
+
+  std::list<int> l(3);
+  stdcpp::ranges::fill(l, 7);
+  ASSERT_EQ(l, (std::list<int>{7, 7, 7}));
+
+  // Overlapping arrays, as with memmove.
+  int values[5] = {1, 2, 3, 4, 5};
+  auto result = stdcpp::ranges::copy(values + 1, values + 5, values);
+  ASSERT_EQ(result.in, values + 5);
+  ASSERT_EQ(result.out, values + 4);
+  ASSERT_EQ(values[0], 2);
+  ASSERT_EQ(values[3], 5);
+
+  std::vector<int> source{1, 2, 3};
+  std::vector<int> target(3);
+  ASSERT_EQ(stdcpp::ranges::copy(source, target.data()).out,
+            target.data() + 3);
+  ASSERT_EQ(target, source);
+}
+
+TEST(stdcpp_algorithm, radix_sort) {
+  std::mt19937_64 rng(7);
+  for (std::size_t n : {0u, 1u, 40u, 1000u}) {
+    std::vector<long long> v(n);
+    for (auto& x : v) {
+      x = static_cast<long long>(rng());
+    }
+    auto expected = v;
+    std::sort(expected.begin(), expected.end());
+    ASSERT_EQ(stdcpp::ranges::radix_sort(v), v.end());
+    ASSERT_EQ(v, expected);
+  }
+
+  std::vector<unsigned char> bytes{200, 3, 255, 0, 3};
+  stdcpp::ranges::radix_sort(bytes);
+  ASSERT_EQ(bytes, (std::vector<unsigned char>{0, 3, 3, 200, 255}));
+
+  std::vector<double> d;
+  for (int i = 0; i < 500; ++i) {
+    d.push_back((static_cast<double>(rng() % 2001) - 1000.0) / 7.0);
+  }
+  d.push_back(-std::numeric_limits<double>::infinity());
+  d.push_back(std::numeric_limits<double>::max());
+  d.push_back(-0.0);
+  auto expected = d;
+  std::stable_sort(expected.begin(), expected.end());
+  stdcpp::ranges::radix_sort(d);
+  ASSERT_EQ(d, expected);
+
+  std::vector<float> f{2.5f, -1.0f, 0.0f, -3.5f, 1e-30f, -1e-30f};
+  stdcpp::ranges::radix_sort(f);
+  ASSERT_EQ(f, (std::vector<float>{-3.5f, -1.0f, -1e-30f, 0.0f, 1e-30f,
+                                   2.5f}));
+
+  // Stable, by a projected key that is the same in its low bytes.
+  std::vector<std::pair<int, int>> pairs;
+  for (int i = 0; i < 300; ++i) {
+    pairs.emplace_back((i % 3 - 1) << 16, i);
+  }
+  auto by_first = pairs;
+  std::stable_sort(by_first.begin(), by_first.end(),
+                   [](const auto& a, const auto& b) {
+                     return a.first < b.first;
+                   });
+  stdcpp::ranges::radix_sort(pairs, &std::pair<int, int>::first);
+  ASSERT_EQ(pairs, by_first);
+
+  using stdcpp::sys_time;
+  using std::chrono::seconds;
+  std::vector<sys_time<seconds>> times{sys_time<seconds>(seconds(30)),
+                                       sys_time<seconds>(seconds(-5)),
+                                       sys_time<seconds>(seconds(10))};
+  stdcpp::ranges::radix_sort(times);
+  ASSERT_EQ(times[0].time_since_epoch(), seconds(-5));
+  ASSERT_EQ(times[2].time_since_epoch(), seconds(30));
+
+  std::vector<std::string> words{"ccc", "a", "bb"};
+  stdcpp::ranges::radix_sort(words, [](const std::string& s) {
+    return -std::chrono::seconds(static_cast<long long>(s.size()));
+  });
+  ASSERT_EQ(words, (std::vector<std::string>{"ccc", "bb", "a"}));
+}
+
+TEST(stdcpp_algorithm, parallel_radix_sort) {
+  stdcpp::thread_pool pool(4);
+  std::mt19937 rng(42);
+  for (std::size_t n : {100u, 70000u}) {
+    std::vector<std::pair<std::uint32_t, std::size_t>> v(n);
+    for (std::size_t i = 0; i < n; ++i) {
+      // Keys share their top byte, so buckets split by the byte below.
+      v[i] = {0x7f000000u | (rng() & 0xffffu), i};
+    }
+    auto expected = v;
+    std::stable_sort(expected.begin(), expected.end(),
+                     [](const auto& a, const auto& b) {
+                       return a.first < b.first;
+                     });
+    stdcpp::ranges::radix_sort(stdcpp::execution::par.on(pool), v,
+                               &std::pair<std::uint32_t, std::size_t>::first);
+    ASSERT_EQ(v, expected);
+  }
+
+  std::vector<int> same(40000, 5);
+  stdcpp::ranges::radix_sort(stdcpp::execution::par.on(pool), same);
+  ASSERT_EQ(same, std::vector<int>(40000, 5));
+
+  std::vector<int> small{3, -1, 2};
+  stdcpp::ranges::radix_sort(stdcpp::execution::seq, small);
+  ASSERT_EQ(small, (std::vector<int>{-1, 2, 3}));
+}
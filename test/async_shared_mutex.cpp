@@ -0,0 +1,184 @@
+#include <gtest/gtest.h>
+#include <async_shared_mutex.hpp>
+
+// Built as C++20 when the compiler supports it; see CMakeLists.txt.
+#if __cplusplus >= 202002L
+
+#include <atomic>
+#include <coroutine>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+// A coroutine that starts eagerly and frees itself when it finishes.
+struct detached {
+  struct promise_type {
+    detached get_return_object() noexcept { return {}; }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() noexcept {}
+    void unhandled_exception() noexcept { std::terminate(); }
+  };
+};
+
+// Suspends until set() is called.
+class manual_event {
+ public:
+  bool await_ready() const noexcept { return set_; }
+  void await_suspend(std::coroutine_handle<> h) noexcept { waiter_ = h; }
+  void await_resume() noexcept {}
+
+  void set() {
+    set_ = true;
+    if (waiter_) {
+      std::exchange(waiter_, nullptr).resume();
+    }
+  }
+
+ private:
+  bool set_ = false;
+  std::coroutine_handle<> waiter_;
+};
+
+detached write(stdcpp::async_shared_mutex& mtx, std::string& log, char id) {
+  co_await mtx.lock_async();
+  log += id;
+  mtx.unlock();
+}
+
+detached read(stdcpp::async_shared_mutex& mtx, std::string& log, char id) {
+  co_await mtx.lock_shared_async();
+  log += id;
+  mtx.unlock_shared();
+}
+
+detached read_until(stdcpp::async_shared_mutex& mtx, manual_event& done,
+                    int& holders) {
+  auto lock = co_await mtx.scoped_lock_shared_async();
+  ++holders;
+  co_await done;
+  --holders;
+}
+}  // namespace
+
+TEST(stdcpp_async_shared_mutex, uncontended_lock_completes_inline) {
+  stdcpp::async_shared_mutex mtx;
+  std::string log;
+  write(mtx, log, 'w');
+  read(mtx, log, 'r');
+  ASSERT_EQ(log, "wr");
+  ASSERT_TRUE(mtx.try_lock());
+  ASSERT_FALSE(mtx.try_lock_shared());
+  mtx.unlock();
+  ASSERT_TRUE(mtx.try_lock_shared());
+  ASSERT_TRUE(mtx.try_lock_shared());
+  ASSERT_FALSE(mtx.try_lock());
+  mtx.unlock_shared();
+  mtx.unlock_shared();
+}
+
+TEST(stdcpp_async_shared_mutex, waiters_resume_in_fifo_order) {
+  stdcpp::async_shared_mutex mtx;
+  std::string log;
+  ASSERT_TRUE(mtx.try_lock());
+  write(mtx, log, 'a');
+  read(mtx, log, 'b');
+  read(mtx, log, 'c');
+  write(mtx, log, 'd');
+  read(mtx, log, 'e');
+  ASSERT_EQ(log, "");
+  mtx.unlock();
+  ASSERT_EQ(log, "abcde");
+  ASSERT_TRUE(mtx.try_lock());
+  mtx.unlock();
+}
+
+TEST(stdcpp_async_shared_mutex, readers_behind_a_writer_wait) {
+  stdcpp::async_shared_mutex mtx;
+  manual_event done;
+  int holders = 0;
+  std::string log;
+  read_until(mtx, done, holders);
+  ASSERT_EQ(holders, 1);
+  write(mtx, log, 'w');
+  // Queued behind the writer, although only readers hold the lock.
+  read_until(mtx, done, holders);
+  ASSERT_FALSE(mtx.try_lock_shared());
+  ASSERT_EQ(holders, 1);
+  ASSERT_EQ(log, "");
+
+  // The first reader leaves, the writer runs, then the second reader.
+  done.set();
+  ASSERT_EQ(log, "w");
+  ASSERT_EQ(holders, 0);
+  ASSERT_TRUE(mtx.try_lock());
+  mtx.unlock();
+}
+
+TEST(stdcpp_async_shared_mutex, queued_readers_are_granted_together) {
+  stdcpp::async_shared_mutex mtx;
+  manual_event first;
+  manual_event second;
+  int holders = 0;
+  ASSERT_TRUE(mtx.try_lock());
+  read_until(mtx, first, holders);
+  read_until(mtx, second, holders);
+  ASSERT_EQ(holders, 0);
+  mtx.unlock();
+  ASSERT_EQ(holders, 2);
+  ASSERT_FALSE(mtx.try_lock());
+  first.set();
+  ASSERT_FALSE(mtx.try_lock());
+  second.set();
+  ASSERT_EQ(holders, 0);
+  ASSERT_TRUE(mtx.try_lock());
+  mtx.unlock();
+}
+
+TEST(stdcpp_async_shared_mutex, scoped_locks_own_the_mutex) {
+  stdcpp::async_shared_mutex mtx;
+  bool owned = false;
+  [](stdcpp::async_shared_mutex& mtx, bool& owned) -> detached {
+    auto lock = co_await mtx.scoped_lock_async();
+    owned = lock.owns_lock() && lock.mutex() == &mtx;
+  }(mtx, owned);
+  ASSERT_TRUE(owned);
+  ASSERT_TRUE(mtx.try_lock());
+  mtx.unlock();
+}
+
+TEST(stdcpp_async_shared_mutex, coroutines_on_many_threads) {
+  stdcpp::async_shared_mutex mtx;
+  constexpr int kThreads = 4;
+  constexpr int kCoroutines = 2000;
+  long value = 0;
+  std::atomic<int> finished{0};
+  auto body = [](stdcpp::async_shared_mutex& mtx, long& value,
+                 std::atomic<int>& finished, int i) -> detached {
+    if (i % 4 == 0) {
+      auto lock = co_await mtx.scoped_lock_async();
+      ++value;
+    } else {
+      auto lock = co_await mtx.scoped_lock_shared_async();
+      EXPECT_LE(value, kThreads * kCoroutines / 4);
+    }
+    finished.fetch_add(1, std::memory_order_release);
+  };
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&] {
+      for (int i = 0; i < kCoroutines; ++i) {
+        body(mtx, value, finished, i);
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  // Suspended coroutines were resumed by whichever thread unlocked last.
+  ASSERT_EQ(finished.load(std::memory_order_acquire), kThreads * kCoroutines);
+  ASSERT_EQ(value, kThreads * kCoroutines / 4);
+}
+
+#endif  // __cplusplus >= 202002L
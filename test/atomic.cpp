@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include <atomic.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace {
+// One thread flips the value and notifies; the other waits for each flip.
+template <class T>
+void ping_pong(T first, T second) {
+  std::atomic<T> value{first};
+  constexpr int kRounds = 1000;
+  std::thread other([&] {
+    for (int i = 0; i < kRounds; ++i) {
+      stdcpp::atomic_wait(&value, first);
+      value.store(first);
+      stdcpp::atomic_notify_one(&value);
+    }
+  });
+  for (int i = 0; i < kRounds; ++i) {
+    value.store(second);
+    stdcpp::atomic_notify_one(&value);
+    stdcpp::atomic_wait(&value, second);
+  }
+  other.join();
+  ASSERT_EQ(value.load(), first);
+}
+}  // namespace
+
+TEST(stdcpp_atomic, wait_returns_when_value_differs) {
+  std::atomic<int> value{1};
+  stdcpp::atomic_wait(&value, 0);
+  stdcpp::atomic_wait_explicit(&value, 2, std::memory_order_acquire);
+  std::atomic<std::uint64_t> wide{5};
+  stdcpp::atomic_wait(&wide, 4);
+}
+
+TEST(stdcpp_atomic, notify_without_waiters) {
+  std::atomic<int> value{0};
+  stdcpp::atomic_notify_one(&value);
+  stdcpp::atomic_notify_all(&value);
+  std::atomic<bool> flag{false};
+  stdcpp::atomic_notify_all(&flag);
+}
+
+TEST(stdcpp_atomic, ping_pong_32_bit) {
+  ping_pong<std::int32_t>(0, 1);
+}
+
+TEST(stdcpp_atomic, ping_pong_other_sizes) {
+  ping_pong<bool>(false, true);
+  ping_pong<std::uint8_t>(0, 1);
+  ping_pong<std::uint64_t>(0, std::uint64_t{1} << 40);
+}
+
+TEST(stdcpp_atomic, notify_all_wakes_every_waiter) {
+  std::atomic<std::int32_t> gate{0};
+  std::atomic<std::uint64_t> wide_gate{0};
+  std::atomic<int> passed{0};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 8; ++t) {
+    threads.emplace_back([&, t] {
+      if (t % 2 == 0) {
+        stdcpp::atomic_wait(&gate, 0);
+      } else {
+        stdcpp::atomic_wait(&wide_gate, 0);
+      }
+      passed.fetch_add(1);
+    });
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  ASSERT_EQ(passed.load(), 0);
+  gate.store(1);
+  stdcpp::atomic_notify_all(&gate);
+  wide_gate.store(1);
+  stdcpp::atomic_notify_all(&wide_gate);
+  for (auto& th : threads) {
+    th.join();
+  }
+  ASSERT_EQ(passed.load(), 8);
+}
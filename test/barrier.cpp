@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+#include <barrier.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+struct count_phases {
+  int* phases;
+  void operator()() noexcept { ++*phases; }
+};
+
+// Every thread bumps its own slot once per phase; the completion function
+// checks that all of them arrived before the phase ended.
+void run_phases(int threads, int phases) {
+  std::vector<int> progress(threads, 0);
+  int completed = 0;
+  bool consistent = true;
+  auto check = [&]() noexcept {
+    ++completed;
+    for (int p : progress) {
+      consistent = consistent && p == completed;
+    }
+  };
+  stdcpp::barrier<decltype(check)> sync(threads, check);
+  std::vector<std::thread> pool;
+  for (int t = 0; t < threads; ++t) {
+    pool.emplace_back([&, t] {
+      for (int i = 0; i < phases; ++i) {
+        ++progress[t];
+        sync.arrive_and_wait();
+      }
+    });
+  }
+  for (auto& th : pool) {
+    th.join();
+  }
+  ASSERT_EQ(completed, phases);
+  ASSERT_TRUE(consistent);
+}
+}  // namespace
+
+TEST(stdcpp_barrier, single_thread_phases) {
+  int phases = 0;
+  stdcpp::barrier<count_phases> sync(1, count_phases{&phases});
+  for (int i = 0; i < 5; ++i) {
+    sync.arrive_and_wait();
+  }
+  ASSERT_EQ(phases, 5);
+}
+
+TEST(stdcpp_barrier, arrive_with_update) {
+  int phases = 0;
+  stdcpp::barrier<count_phases> sync(4, count_phases{&phases});
+  auto token = sync.arrive(3);
+  ASSERT_EQ(phases, 0);
+  sync.arrive();
+  ASSERT_EQ(phases, 1);
+  sync.wait(std::move(token));
+}
+
+TEST(stdcpp_barrier, default_completion) {
+  stdcpp::barrier<> sync(2);
+  std::thread other([&] { sync.arrive_and_wait(); });
+  sync.arrive_and_wait();
+  other.join();
+}
+
+TEST(stdcpp_barrier, phases_with_even_and_odd_counts) {
+  for (int threads : {2, 3, 4, 5, 7, 8, 13}) {
+    run_phases(threads, 200);
+  }
+}
+
+TEST(stdcpp_barrier, arrive_and_drop_shrinks_later_phases) {
+  int phases = 0;
+  stdcpp::barrier<count_phases> sync(3, count_phases{&phases});
+  std::thread leaver([&] { sync.arrive_and_drop(); });
+  std::thread stayer([&] {
+    for (int i = 0; i < 50; ++i) {
+      sync.arrive_and_wait();
+    }
+  });
+  for (int i = 0; i < 50; ++i) {
+    sync.arrive_and_wait();
+  }
+  leaver.join();
+  stayer.join();
+  ASSERT_EQ(phases, 50);
+}
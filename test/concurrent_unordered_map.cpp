@@ -0,0 +1,207 @@
+#include <gtest/gtest.h>
+#include <concurrent_unordered_map.hpp>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(stdcpp_concurrent_unordered_map, insert_visit_erase) {
+  stdcpp::concurrent_unordered_map<int, int> map(4);
+  ASSERT_EQ(map.stripe_count(), 4u);
+  ASSERT_TRUE(map.empty());
+  ASSERT_TRUE(map.insert({1, 10}));
+  ASSERT_FALSE(map.insert({1, 11}));
+  ASSERT_TRUE(map.try_emplace(2, 20));
+  ASSERT_FALSE(map.try_emplace(2, 21));
+  ASSERT_FALSE(map.insert_or_assign(2, 22));
+  ASSERT_TRUE(map.insert_or_assign(3, 30));
+  ASSERT_EQ(map.size(), 3u);
+
+  int seen = 0;
+  ASSERT_EQ(map.cvisit(2, [&](const std::pair<const int, int>& kv) {
+    seen = kv.second;
+  }), 1u);
+  ASSERT_EQ(seen, 22);
+  ASSERT_EQ(map.visit(1, [](std::pair<const int, int>& kv) { ++kv.second; }),
+            1u);
+  ASSERT_EQ(map.visit(9, [](std::pair<const int, int>&) { FAIL(); }), 0u);
+  map.cvisit(1, [&](const std::pair<const int, int>& kv) { seen = kv.second; });
+  ASSERT_EQ(seen, 11);
+
+  ASSERT_TRUE(map.contains(3));
+  ASSERT_EQ(map.erase(3), 1u);
+  ASSERT_EQ(map.erase(3), 0u);
+  ASSERT_FALSE(map.contains(3));
+  ASSERT_EQ(map.erase_if(1, [](const std::pair<const int, int>& kv) {
+    return kv.second == 0;
+  }), 0u);
+  ASSERT_EQ(map.size(), 2u);
+  map.clear();
+  ASSERT_TRUE(map.empty());
+}
+
+TEST(stdcpp_concurrent_unordered_map, insert_or_visit) {
+  stdcpp::concurrent_unordered_map<std::string, int> counts;
+  for (const char* word : {"a", "b", "a", "c", "a", "b"}) {
+    counts.insert_or_visit({word, 1},
+                           [](std::pair<const std::string, int>& kv) {
+                             ++kv.second;
+                           });
+  }
+  int a = 0, b = 0, c = 0;
+  counts.cvisit("a", [&](const std::pair<const std::string, int>& kv) {
+    a = kv.second;
+  });
+  counts.cvisit(std::string("b"),
+                [&](const std::pair<const std::string, int>& kv) {
+                  b = kv.second;
+                });
+  counts.cvisit(stdcpp::string_view("c"),
+                [&](const std::pair<const std::string, int>& kv) {
+                  c = kv.second;
+                });
+  ASSERT_EQ(a, 3);
+  ASSERT_EQ(b, 2);
+  ASSERT_EQ(c, 1);
+}
+
+TEST(stdcpp_concurrent_unordered_map, heterogeneous_lookup) {
+  stdcpp::concurrent_unordered_map<std::string, int> map;
+  map.try_emplace("a fairly long key that defeats small strings", 1);
+  const stdcpp::string_view key("a fairly long key that defeats small strings");
+  ASSERT_TRUE(map.contains(key));
+  ASSERT_EQ(map.count(key.substr(0, 7)), 0u);
+  ASSERT_TRUE(map.contains("a fairly long key that defeats small strings"));
+  ASSERT_EQ(map.erase(key), 1u);
+  ASSERT_TRUE(map.empty());
+  ASSERT_EQ(stdcpp::string_hash()(key),
+            stdcpp::string_hash()(std::string(key.data(), key.size())));
+}
+
+TEST(stdcpp_concurrent_unordered_map, grows_and_reuses_slots) {
+  stdcpp::concurrent_unordered_map<int, std::unique_ptr<int>> map(2);
+  for (int i = 0; i < 10000; ++i) {
+    ASSERT_TRUE(map.try_emplace(i, new int(i)));
+  }
+  ASSERT_EQ(map.size(), 10000u);
+  for (int i = 0; i < 10000; i += 2) {
+    ASSERT_EQ(map.erase(i), 1u);
+  }
+  // Churn through tombstones without growing without bound.
+  for (int round = 0; round < 5; ++round) {
+    for (int i = 0; i < 10000; i += 2) {
+      ASSERT_TRUE(map.try_emplace(i, new int(i)));
+    }
+    for (int i = 0; i < 10000; i += 2) {
+      ASSERT_EQ(map.erase(i), 1u);
+    }
+  }
+  ASSERT_EQ(map.size(), 5000u);
+  long sum = 0;
+  ASSERT_EQ(map.cvisit_all(
+                [&](const std::pair<const int, std::unique_ptr<int>>& kv) {
+                  ASSERT_EQ(kv.first, *kv.second);
+                  sum += kv.first;
+                }),
+            5000u);
+  ASSERT_EQ(sum, 5000L * 5000);
+  ASSERT_EQ(map.erase_if([](const std::pair<const int, std::unique_ptr<int>>&
+                                kv) { return kv.first < 5000; }),
+            2500u);
+  ASSERT_EQ(map.size(), 2500u);
+}
+
+namespace {
+struct fragile {
+  static int budget;
+  explicit fragile(int v) : value(v) {}
+  fragile(const fragile& other) : value(other.value) {
+    if (budget-- == 0) {
+      throw std::runtime_error("copy");
+    }
+  }
+  int value;
+};
+int fragile::budget = -1;
+}  // namespace
+
+TEST(stdcpp_concurrent_unordered_map, failed_growth_keeps_elements) {
+  stdcpp::concurrent_unordered_map<int, fragile> map(1);
+  for (int i = 0; i < 7; ++i) {
+    map.try_emplace(i, i);
+  }
+  // The next insertion grows the only stripe and the one after it starts
+  // copying the throwing values across.
+  ASSERT_TRUE(map.try_emplace(7, 7));
+  fragile::budget = 3;
+  ASSERT_THROW(map.try_emplace(8, 8), std::runtime_error);
+  fragile::budget = -1;
+  ASSERT_EQ(map.size(), 8u);
+  for (int i = 0; i < 8; ++i) {
+    int value = -1;
+    map.cvisit(i, [&](const std::pair<const int, fragile>& kv) {
+      value = kv.second.value;
+    });
+    ASSERT_EQ(value, i);
+  }
+  ASSERT_TRUE(map.try_emplace(8, 8));
+  ASSERT_EQ(map.size(), 9u);
+}
+
+TEST(stdcpp_concurrent_unordered_map, growth_moves_elements_a_few_at_a_time) {
+  stdcpp::concurrent_unordered_map<int, int> map(1);
+  for (int i = 0; i < 1000; ++i) {
+    ASSERT_TRUE(map.try_emplace(i, i));
+    // Every element stays reachable, whichever table holds it.
+    if (i % 97 == 0) {
+      for (int j = 0; j <= i; ++j) {
+        ASSERT_TRUE(map.contains(j));
+      }
+      ASSERT_EQ(map.cvisit_all([](const std::pair<const int, int>&) {}),
+                static_cast<std::size_t>(i + 1));
+    }
+  }
+  // Erase and update elements that may still sit in the old table.
+  map.reserve(4000);
+  for (int i = 0; i < 1000; i += 3) {
+    ASSERT_EQ(map.erase(i), 1u);
+  }
+  for (int i = 1; i < 1000; i += 3) {
+    ASSERT_EQ(map.visit(i, [](auto& kv) { kv.second = -kv.first; }), 1u);
+  }
+  ASSERT_EQ(map.size(), 666u);
+  for (int i = 0; i < 1000; ++i) {
+    int value = 0;
+    const std::size_t found = map.cvisit(
+        i, [&](const std::pair<const int, int>& kv) { value = kv.second; });
+    ASSERT_EQ(found, i % 3 == 0 ? 0u : 1u);
+    ASSERT_EQ(value, i % 3 == 0 ? 0 : i % 3 == 1 ? -i : i);
+  }
+}
+
+TEST(stdcpp_concurrent_unordered_map, concurrent_updates) {
+  stdcpp::concurrent_unordered_map<int, long> map(8);
+  const int threads = 4, keys = 512, rounds = 2000;
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back([&, t] {
+      for (int r = 0; r < rounds; ++r) {
+        const int key = (r * 7919 + t) % keys;
+        map.insert_or_visit({key, 1}, [](std::pair<const int, long>& kv) {
+          ++kv.second;
+        });
+        map.cvisit((key + 1) % keys, [](const std::pair<const int, long>&) {});
+      }
+    });
+  }
+  for (auto& w : workers) {
+    w.join();
+  }
+  long total = 0;
+  map.cvisit_all([&](const std::pair<const int, long>& kv) {
+    total += kv.second;
+  });
+  ASSERT_EQ(total, static_cast<long>(threads) * rounds);
+}
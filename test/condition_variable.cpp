@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#include <condition_variable.hpp>
+#include <shared_mutex.hpp>
+#include <thread.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+TEST(stdcpp_condition_variable_any, notify_wakes_predicate_wait) {
+  stdcpp::condition_variable_any cv;
+  std::mutex mtx;
+  bool ready = false;
+  std::thread waiter([&] {
+    std::unique_lock<std::mutex> lk(mtx);
+    cv.wait(lk, [&] { return ready; });
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  {
+    std::lock_guard<std::mutex> lk(mtx);
+    ready = true;
+  }
+  cv.notify_one();
+  waiter.join();
+}
+
+TEST(stdcpp_condition_variable_any, wait_for_times_out) {
+  stdcpp::condition_variable_any cv;
+  std::mutex mtx;
+  std::unique_lock<std::mutex> lk(mtx);
+  const auto start = std::chrono::steady_clock::now();
+  ASSERT_EQ(cv.wait_for(lk, std::chrono::milliseconds(20)),
+            std::cv_status::timeout);
+  ASSERT_GE(std::chrono::steady_clock::now() - start,
+            std::chrono::milliseconds(20));
+  ASSERT_FALSE(cv.wait_for(lk, std::chrono::milliseconds(1), [] {
+    return false;
+  }));
+  ASSERT_TRUE(lk.owns_lock());
+}
+
+TEST(stdcpp_condition_variable_any, shared_lock_of_shared_mutex) {
+  stdcpp::condition_variable_any cv;
+  stdcpp::shared_mutex mtx;
+  int generation = 0;
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 4; ++t) {
+    readers.emplace_back([&] {
+      std::shared_lock<stdcpp::shared_mutex> lk(mtx);
+      cv.wait(lk, [&] { return generation == 1; });
+    });
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  {
+    std::unique_lock<stdcpp::shared_mutex> lk(mtx);
+    generation = 1;
+  }
+  cv.notify_all();
+  for (auto& th : readers) {
+    th.join();
+  }
+}
+
+TEST(stdcpp_condition_variable_any, stop_request_interrupts_wait) {
+  stdcpp::condition_variable_any cv;
+  stdcpp::shared_mutex mtx;
+  bool woke_by_predicate = true;
+  {
+    stdcpp::jthread waiter([&](stdcpp::stop_token token) {
+      std::unique_lock<stdcpp::shared_mutex> lk(mtx);
+      woke_by_predicate = cv.wait(lk, token, [] { return false; });
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  ASSERT_FALSE(woke_by_predicate);
+}
+
+TEST(stdcpp_condition_variable_any, stop_token_wait_until_times_out) {
+  stdcpp::condition_variable_any cv;
+  std::mutex mtx;
+  stdcpp::stop_source source;
+  std::unique_lock<std::mutex> lk(mtx);
+  ASSERT_FALSE(cv.wait_for(lk, source.get_token(),
+                           std::chrono::milliseconds(5), [] { return false; }));
+  source.request_stop();
+  ASSERT_TRUE(cv.wait_for(lk, source.get_token(), std::chrono::seconds(10),
+                          [] { return true; }));
+}
+
+TEST(stdcpp_condition_variable_any, stop_racing_wait_is_never_lost) {
+  stdcpp::condition_variable_any cv;
+  std::mutex mtx;
+  for (int round = 0; round < 500; ++round) {
+    std::atomic<bool> started{false};
+    stdcpp::jthread waiter([&](stdcpp::stop_token token) {
+      std::unique_lock<std::mutex> lk(mtx);
+      started.store(true, std::memory_order_relaxed);
+      if (round % 2 == 0) {
+        cv.wait(lk, token, [] { return false; });
+      } else {
+        cv.wait_for(lk, token, std::chrono::hours(1), [] { return false; });
+      }
+    });
+    // Request the stop at varying points of the waiter's way in; a missed
+    // wakeup hangs the jthread's join.
+    for (int spin = 0; spin < round % 50; ++spin) {
+      if (started.load(std::memory_order_relaxed)) {
+        break;
+      }
+      std::this_thread::yield();
+    }
+    waiter.request_stop();
+  }
+}
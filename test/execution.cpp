@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+#include <execution.hpp>
+
+#include <type_traits>
+
+TEST(stdcpp_execution, policies_are_execution_policies) {
+  static_assert(stdcpp::is_execution_policy<
+                    stdcpp::execution::sequenced_policy>::value,
+                "");
+  static_assert(stdcpp::is_execution_policy<
+                    stdcpp::execution::unsequenced_policy>::value,
+                "");
+  static_assert(
+      stdcpp::is_execution_policy<stdcpp::execution::parallel_policy>::value,
+      "");
+  static_assert(stdcpp::is_execution_policy<
+                    stdcpp::execution::parallel_unsequenced_policy>::value,
+                "");
+  static_assert(!stdcpp::is_execution_policy<int>::value, "");
+  static_assert(stdcpp::v1::detail::is_policy<
+                    decltype(stdcpp::execution::par)>::value,
+                "");
+}
+
+TEST(stdcpp_execution, policies_name_a_pool_and_grain) {
+  ASSERT_EQ(&stdcpp::execution::par.pool(),
+            &stdcpp::execution::default_pool());
+  ASSERT_EQ(stdcpp::execution::par.grain(), 0u);
+
+  stdcpp::thread_pool pool(2);
+  auto policy = stdcpp::execution::par_unseq.on(pool).with_grain(100);
+  static_assert(std::is_same<decltype(policy),
+                             stdcpp::execution::parallel_unsequenced_policy>::
+                    value,
+                "");
+  ASSERT_EQ(&policy.pool(), &pool);
+  ASSERT_EQ(policy.grain(), 100u);
+}
+
+TEST(stdcpp_execution, chunks_cover_the_input) {
+  stdcpp::thread_pool pool(2);
+  auto policy = stdcpp::execution::par.on(pool);
+  // Eight chunks for two workers, unless that would go below the grain.
+  auto plan = stdcpp::v1::detail::plan_chunks(policy, 8000, 10);
+  ASSERT_EQ(plan.count(), 8u);
+  ASSERT_EQ(plan.begin(0), 0u);
+  ASSERT_EQ(plan.end(7), 8000u);
+  ASSERT_EQ(stdcpp::v1::detail::plan_chunks(policy, 8000, 4000).count(), 2u);
+  ASSERT_EQ(
+      stdcpp::v1::detail::plan_chunks(policy.with_grain(3000), 8000, 10)
+          .count(),
+      3u);
+  ASSERT_EQ(stdcpp::v1::detail::plan_chunks(policy, 0, 10).count(), 0u);
+}
@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include <hazard_pointer.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+std::atomic<int> live{0};
+
+struct node : stdcpp::hazard_pointer_obj_base<node> {
+  explicit node(int v) : value(v) { live.fetch_add(1); }
+  ~node() {
+    value = -1;
+    live.fetch_sub(1);
+  }
+  int value;
+};
+
+// Retires `n` fresh nodes on a new thread, which then exits.
+void retire_on_thread(int n) {
+  std::thread([n] {
+    for (int i = 0; i < n; ++i) {
+      (new node(i))->retire();
+    }
+  }).join();
+}
+}  // namespace
+
+TEST(stdcpp_hazard_pointer, empty_and_move) {
+  stdcpp::hazard_pointer empty;
+  ASSERT_TRUE(empty.empty());
+  stdcpp::hazard_pointer hp = stdcpp::make_hazard_pointer();
+  ASSERT_FALSE(hp.empty());
+  stdcpp::hazard_pointer moved(std::move(hp));
+  ASSERT_TRUE(hp.empty());
+  ASSERT_FALSE(moved.empty());
+  swap(moved, empty);
+  ASSERT_TRUE(moved.empty());
+  ASSERT_FALSE(empty.empty());
+  moved = std::move(empty);
+  ASSERT_FALSE(moved.empty());
+}
+
+TEST(stdcpp_hazard_pointer, protect_reads_current_value) {
+  node a(1), b(2);
+  std::atomic<node*> src{&a};
+  stdcpp::hazard_pointer hp = stdcpp::make_hazard_pointer();
+  ASSERT_EQ(hp.protect(src), &a);
+  node* ptr = &a;
+  ASSERT_TRUE(hp.try_protect(ptr, src));
+  src.store(&b);
+  ASSERT_FALSE(hp.try_protect(ptr, src));
+  ASSERT_EQ(ptr, &b);
+  hp.reset_protection();
+}
+
+TEST(stdcpp_hazard_pointer, retired_objects_are_reclaimed) {
+  const int before = live.load();
+  retire_on_thread(1000);
+  ASSERT_EQ(live.load(), before);
+}
+
+TEST(stdcpp_hazard_pointer, protected_object_outlives_retire) {
+  const int before = live.load();
+  std::atomic<node*> src{new node(7)};
+  stdcpp::hazard_pointer hp = stdcpp::make_hazard_pointer();
+  node* guarded = hp.protect(src);
+  std::thread([&src] {
+    src.exchange(nullptr)->retire();
+    for (int i = 0; i < 500; ++i) {
+      (new node(i))->retire();
+    }
+  }).join();
+  // Everything but the protected node is gone, and it is still intact.
+  ASSERT_EQ(live.load(), before + 1);
+  ASSERT_EQ(guarded->value, 7);
+  hp.reset_protection();
+  // The next scan, on any thread, picks it up.
+  retire_on_thread(500);
+  ASSERT_EQ(live.load(), before);
+}
+
+namespace {
+struct pooled : stdcpp::hazard_pointer_obj_base<pooled, void (*)(pooled*)> {};
+std::atomic<int> custom_deletes{0};
+}  // namespace
+
+TEST(stdcpp_hazard_pointer, custom_deleter) {
+  std::thread([] {
+    for (int i = 0; i < 10; ++i) {
+      (new pooled)->retire([](pooled* p) {
+        custom_deletes.fetch_add(1);
+        delete p;
+      });
+    }
+  }).join();
+  ASSERT_EQ(custom_deletes.load(), 10);
+}
+
+TEST(stdcpp_hazard_pointer, readers_never_see_freed_nodes) {
+  const int before = live.load();
+  std::atomic<node*> src{new node(0)};
+  std::atomic<bool> stop{false};
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 4; ++t) {
+    readers.emplace_back([&] {
+      stdcpp::hazard_pointer hp = stdcpp::make_hazard_pointer();
+      while (!stop.load(std::memory_order_relaxed)) {
+        node* n = hp.protect(src);
+        // A reclaimed node would read -1 (or trip the address sanitizer).
+        ASSERT_GE(n->value, 0);
+        hp.reset_protection();
+      }
+    });
+  }
+  std::thread writer([&] {
+    for (int i = 1; i <= 20000; ++i) {
+      src.exchange(new node(i))->retire();
+    }
+    stop.store(true);
+  });
+  writer.join();
+  for (auto& t : readers) {
+    t.join();
+  }
+  std::thread([&src] { src.exchange(nullptr)->retire(); }).join();
+  // Adopts whatever the writer left protected when it exited.
+  retire_on_thread(200);
+  ASSERT_EQ(live.load(), before);
+}
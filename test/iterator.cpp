@@ -160,6 +160,30 @@ TEST(CommonReferenceTest, EdgeCasesAndSingleType) {
                 "Single type should deduce to itself.");
 }
 
+// A proxy reference to an int, as a proxy iterator would return.
+struct IntProxy {
+  int* p;
+  operator int&() const { return *p; }
+};
+
+namespace stdcpp {
+namespace v1 {
+template <template <typename> class TQual, template <typename> class UQual>
+struct basic_common_reference<IntProxy, int, TQual, UQual> {
+  using type = int&;
+};
+}  // namespace v1
+}  // namespace stdcpp
+
+TEST(CommonReferenceTest, BasicCommonReferenceAndFallbacks) {
+  static_assert(
+      stdcpp::is_same_v<stdcpp::v1::common_reference_t<IntProxy, int&>, int&>,
+      "basic_common_reference should combine proxy references.");
+  static_assert(
+      stdcpp::is_same_v<stdcpp::v1::common_reference_t<int, long>, long>,
+      "Values should combine as in the conditional operator.");
+}
+
 TEST(IteratorTraitsTest, CustomIteratorDifferenceType) {
   // Assuming CustomIterator defines a custom difference_type
   static_assert(stdcpp::is_same_v<stdcpp::v1::iter_difference_t<CustomIterator>,
@@ -197,3 +221,26 @@ TEST(IteratorTraitsTest, CustomIteratorCommonReference) {
       "Custom iterator should deduce its common reference type correctly with "
       "other types.");
 }
+
+TEST(stdcpp_iterator, counted_iterator) {
+  const int a[] = {1, 2, 3, 4};
+  stdcpp::counted_iterator<const int*> it(a, 3);
+  const stdcpp::counted_iterator<const int*> last;
+  ASSERT_EQ(it.count(), 3);
+  ASSERT_EQ(last - it, 3);
+  ASSERT_EQ(*it, 1);
+  ASSERT_EQ(it[2], 3);
+  ++it;
+  ASSERT_EQ(*it, 2);
+  ASSERT_EQ(it.count(), 2);
+  it += 2;
+  ASSERT_TRUE(it == last);
+  ASSERT_EQ(it.base(), a + 3);
+}
+
+TEST(stdcpp_iterator, unreachable_sentinel) {
+  const int a[] = {1, 2, 3};
+  const int* p = a;
+  ASSERT_FALSE(p == stdcpp::unreachable_sentinel);
+  ASSERT_TRUE(stdcpp::unreachable_sentinel != p);
+}
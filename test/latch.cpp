@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+#include <latch.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+TEST(stdcpp_latch, max) {
+  ASSERT_GE(stdcpp::latch::max(), 1 << 30);
+}
+
+TEST(stdcpp_latch, count_down_to_zero) {
+  stdcpp::latch done(3);
+  ASSERT_FALSE(done.try_wait());
+  done.count_down();
+  ASSERT_FALSE(done.try_wait());
+  done.count_down(2);
+  ASSERT_TRUE(done.try_wait());
+  done.wait();
+}
+
+TEST(stdcpp_latch, zero_is_already_open) {
+  stdcpp::latch done(0);
+  ASSERT_TRUE(done.try_wait());
+  done.wait();
+}
+
+TEST(stdcpp_latch, releases_all_waiters) {
+  stdcpp::latch start(1);
+  std::atomic<int> passed{0};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 6; ++t) {
+    threads.emplace_back([&] {
+      start.wait();
+      passed.fetch_add(1);
+    });
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  ASSERT_EQ(passed.load(), 0);
+  start.count_down();
+  for (auto& th : threads) {
+    th.join();
+  }
+  ASSERT_EQ(passed.load(), 6);
+}
+
+TEST(stdcpp_latch, arrive_and_wait_sees_every_write) {
+  constexpr int kThreads = 8;
+  stdcpp::latch done(kThreads);
+  std::vector<int> results(kThreads, 0);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&, t] {
+      results[t] = t + 1;
+      done.arrive_and_wait();
+      int sum = 0;
+      for (int v : results) {
+        sum += v;
+      }
+      ASSERT_EQ(sum, kThreads * (kThreads + 1) / 2);
+    });
+  }
+  for (auto& th : threads) {
+    th.join();
+  }
+}
@@ -0,0 +1,104 @@
+#define STDCPP_ENABLE_LOCK_STATS
+#include <gtest/gtest.h>
+#include <lock_stats.hpp>
+
+#include <chrono>
+#include <mutex>
+#include <shared_mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+TEST(stdcpp_lock_stats, histogram_percentile) {
+  stdcpp::lock_histogram h;
+  ASSERT_EQ(h.percentile(0.5), 0u);
+  h.buckets[3] = 90;   // [8, 16) ns
+  h.buckets[10] = 10;  // [1024, 2048) ns
+  ASSERT_EQ(h.count(), 100u);
+  ASSERT_EQ(h.percentile(0.5), 16u);
+  ASSERT_EQ(h.percentile(0.99), 2048u);
+}
+
+TEST(stdcpp_lock_stats, counts_uncontended_acquisitions) {
+  stdcpp::instrumented_shared_mutex mtx("uncontended");
+  mtx.lock();
+  mtx.unlock();
+  {
+    std::shared_lock<stdcpp::instrumented_shared_mutex> a(mtx);
+    std::shared_lock<stdcpp::instrumented_shared_mutex> b(mtx);
+  }
+  ASSERT_TRUE(mtx.try_lock());
+  mtx.unlock();
+
+  const auto s = mtx.snapshot();
+  ASSERT_EQ(s.name, "uncontended");
+  ASSERT_EQ(s.exclusive_acquisitions, 2u);
+  ASSERT_EQ(s.shared_acquisitions, 2u);
+  ASSERT_EQ(s.contended_exclusive, 0u);
+  ASSERT_EQ(s.contended_shared, 0u);
+  ASSERT_EQ(s.max_readers, 2u);
+  ASSERT_EQ(s.hold_ns.count(), 2u);
+  ASSERT_EQ(s.shared_hold_ns.count(), 1u);
+  ASSERT_EQ(s.wait_ns.count(), 0u);
+}
+
+TEST(stdcpp_lock_stats, records_contention_and_wait_time) {
+  stdcpp::instrumented_mutex<std::mutex> mtx("contended");
+  mtx.lock();
+  std::thread waiter([&] {
+    mtx.lock();
+    mtx.unlock();
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  mtx.unlock();
+  waiter.join();
+
+  const auto s = mtx.snapshot();
+  ASSERT_EQ(s.exclusive_acquisitions, 2u);
+  ASSERT_EQ(s.contended_exclusive, 1u);
+  ASSERT_EQ(s.wait_ns.count(), 1u);
+  // The waiter blocked for most of the 20ms sleep.
+  ASSERT_GE(s.wait_ns.percentile(1.0), 1000000u);
+}
+
+TEST(stdcpp_lock_stats, registry_tracks_live_locks) {
+  const auto before = stdcpp::lock_stats_registry::instance().snapshot().size();
+  {
+    stdcpp::instrumented_shared_mutex a("registry-a");
+    stdcpp::instrumented_shared_mutex b("registry-b");
+    b.lock();
+    b.unlock();
+    auto all = stdcpp::lock_stats_registry::instance().snapshot();
+    ASSERT_EQ(all.size(), before + 2);
+
+    std::ostringstream os;
+    stdcpp::lock_stats_registry::instance().dump(os);
+    ASSERT_NE(os.str().find("registry-a: exclusive=0"), std::string::npos);
+    ASSERT_NE(os.str().find("registry-b: exclusive=1"), std::string::npos);
+  }
+  ASSERT_EQ(stdcpp::lock_stats_registry::instance().snapshot().size(), before);
+}
+
+TEST(stdcpp_lock_stats, concurrent_readers_and_writers) {
+  stdcpp::instrumented_shared_mutex mtx("stress");
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&, t] {
+      for (int i = 0; i < 1000; ++i) {
+        if (t == 0) {
+          std::lock_guard<stdcpp::instrumented_shared_mutex> lk(mtx);
+        } else {
+          std::shared_lock<stdcpp::instrumented_shared_mutex> lk(mtx);
+        }
+      }
+    });
+  }
+  for (auto& th : threads) {
+    th.join();
+  }
+  const auto s = mtx.snapshot();
+  ASSERT_EQ(s.exclusive_acquisitions, 1000u);
+  ASSERT_EQ(s.shared_acquisitions, 3000u);
+  ASSERT_GE(s.max_readers, 1u);
+  ASSERT_LE(s.max_readers, 3u);
+}
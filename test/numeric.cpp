@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include <numeric.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <numeric>
+#include <string>
+#include <vector>
+
+TEST(stdcpp_numeric, reduce) {
+  std::vector<int> v{1, 2, 3, 4};
+  ASSERT_EQ(stdcpp::reduce(v.begin(), v.end()), 10);
+  ASSERT_EQ(stdcpp::reduce(v.begin(), v.end(), 1, std::multiplies<>()), 24);
+
+  stdcpp::thread_pool pool(4);
+  auto par = stdcpp::execution::par.on(pool).with_grain(100);
+  std::vector<long> big(10000);
+  std::iota(big.begin(), big.end(), 1);
+  ASSERT_EQ(stdcpp::reduce(par, big.begin(), big.end()), 10000L * 10001 / 2);
+  ASSERT_EQ(stdcpp::ranges::reduce(par, big, 5L), 10000L * 10001 / 2 + 5);
+
+  // Chunks are combined in order, so non-commutative operations still work.
+  std::vector<std::string> letters(1000, "a");
+  letters[0] = "b";
+  std::string joined = stdcpp::reduce(
+      stdcpp::execution::par.on(pool).with_grain(10), letters.begin(),
+      letters.end(), std::string());
+  ASSERT_EQ(joined, "b" + std::string(999, 'a'));
+
+  std::list<int> l{1, 2, 3};
+  ASSERT_EQ(stdcpp::ranges::reduce(par, l, 0), 6);
+}
+
+TEST(stdcpp_numeric, transform_reduce) {
+  stdcpp::thread_pool pool(4);
+  auto par = stdcpp::execution::par.on(pool).with_grain(100);
+  std::vector<double> a(10000, 0.5);
+  std::vector<double> b(10000, 4.0);
+  ASSERT_EQ(stdcpp::transform_reduce(a.begin(), a.end(), b.begin(), 0.0),
+            20000.0);
+  ASSERT_EQ(stdcpp::transform_reduce(par, a.begin(), a.end(), b.begin(), 0.0),
+            20000.0);
+
+  std::vector<std::string> words{"a", "bb", "ccc"};
+  auto length = [](const std::string& s) { return s.size(); };
+  ASSERT_EQ(stdcpp::ranges::transform_reduce(par, words, std::size_t{0},
+                                             std::plus<>(), length),
+            6u);
+}
+
+TEST(stdcpp_numeric, inclusive_scan) {
+  std::vector<int> v(10000);
+  std::iota(v.begin(), v.end(), 0);
+  std::vector<int> expected(v.size());
+  std::partial_sum(v.begin(), v.end(), expected.begin());
+
+  std::vector<int> out(v.size());
+  ASSERT_EQ(stdcpp::inclusive_scan(v.begin(), v.end(), out.begin()),
+            out.end());
+  ASSERT_EQ(out, expected);
+
+  stdcpp::thread_pool pool(4);
+  auto par = stdcpp::execution::par.on(pool).with_grain(100);
+  std::vector<int> parallel(v.size());
+  ASSERT_EQ(stdcpp::ranges::inclusive_scan(par, v, parallel.begin()),
+            parallel.end());
+  ASSERT_EQ(parallel, expected);
+
+  std::vector<long> offset(v.size());
+  stdcpp::inclusive_scan(par, v.begin(), v.end(), offset.begin(),
+                         std::plus<>(), 7L);
+  ASSERT_EQ(offset.front(), 7);
+  ASSERT_EQ(offset.back(), expected.back() + 7);
+
+  std::vector<int> none;
+  ASSERT_EQ(stdcpp::inclusive_scan(par, none.begin(), none.end(), out.begin()),
+            out.begin());
+}
+
+TEST(stdcpp_numeric, ranges_reduce_and_dot) {
+  std::vector<int> v(1000);
+  std::iota(v.begin(), v.end(), 1);
+  ASSERT_EQ(stdcpp::ranges::reduce(v), 500500);
+  ASSERT_EQ(stdcpp::ranges::reduce(v, 10), 500510);
+  ASSERT_EQ(stdcpp::ranges::reduce(v, 0LL), 500500LL);
+  ASSERT_EQ(stdcpp::ranges::dot(v, v), 333833500);
+
+  // Integer sums wrap as they would one element at a time.
+  std::vector<std::uint8_t> bytes(1000, 3);
+  ASSERT_EQ(stdcpp::ranges::reduce(bytes), static_cast<std::uint8_t>(3000));
+  ASSERT_EQ(stdcpp::ranges::dot(bytes, bytes),
+            static_cast<std::uint8_t>(9000));
+
+  // Floating point is summed in order unless reordering is asked for.
+  std::vector<float> f(1000, 0.1f);
+  float sum = 0;
+  for (float x : f) {
+    sum += x;
+  }
+  ASSERT_EQ(stdcpp::ranges::reduce(f), sum);
+  ASSERT_NEAR(stdcpp::ranges::reduce(stdcpp::execution::unseq, f), 100.0f,
+              0.01f);
+  ASSERT_NEAR(stdcpp::ranges::dot(stdcpp::execution::unseq, f, f), 10.0f,
+              0.01f);
+
+  stdcpp::thread_pool pool(4);
+  auto par_unseq = stdcpp::execution::par_unseq.on(pool).with_grain(100);
+  std::vector<double> d(100000, 0.5);
+  ASSERT_EQ(stdcpp::ranges::reduce(par_unseq, d), 50000.0);
+  ASSERT_EQ(stdcpp::ranges::dot(par_unseq, d, d, 1.0), 25001.0);
+
+  std::list<int> l{1, 2, 3};
+  ASSERT_EQ(stdcpp::ranges::reduce(l), 6);
+  ASSERT_EQ(stdcpp::ranges::dot(l, v), 14);
+}
@@ -0,0 +1,214 @@
+#include <gtest/gtest.h>
+#include <queue.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace {
+struct counted {
+  static int live;
+  int value = 0;
+  counted() { ++live; }
+  explicit counted(int v) : value(v) { ++live; }
+  counted(counted&& other) noexcept : value(other.value) { ++live; }
+  counted& operator=(counted&& other) noexcept {
+    value = other.value;
+    return *this;
+  }
+  ~counted() { --live; }
+};
+int counted::live = 0;
+
+template <class Queue>
+void fifo_order() {
+  Queue q(5);
+  ASSERT_EQ(q.capacity(), 8u);
+  ASSERT_TRUE(q.empty());
+  for (int i = 0; i < 8; ++i) {
+    ASSERT_TRUE(q.try_push(i));
+  }
+  ASSERT_FALSE(q.try_push(8));
+  ASSERT_EQ(q.size_approx(), 8u);
+  int value = -1;
+  for (int i = 0; i < 8; ++i) {
+    ASSERT_TRUE(q.try_pop(value));
+    ASSERT_EQ(value, i);
+  }
+  ASSERT_FALSE(q.try_pop(value));
+}
+
+template <class Queue>
+void batches() {
+  Queue q(16);
+  std::vector<int> in(20);
+  for (int i = 0; i < 20; ++i) {
+    in[i] = i;
+  }
+  ASSERT_EQ(q.try_push_n(in.begin(), in.size()), 16u);
+  ASSERT_EQ(q.try_push_n(in.begin(), 1), 0u);
+  std::vector<int> out;
+  ASSERT_EQ(q.try_pop_n(std::back_inserter(out), 10), 10u);
+  ASSERT_EQ(q.try_push_n(in.begin() + 16, 4), 4u);
+  ASSERT_EQ(q.try_pop_n(std::back_inserter(out), 100), 10u);
+  ASSERT_EQ(out, in);
+}
+
+template <class Queue>
+void push_item(Queue& q, std::uint64_t item, std::false_type) {
+  while (!q.try_push(item)) {
+    std::this_thread::yield();
+  }
+}
+
+template <class Queue>
+void push_item(Queue& q, std::uint64_t item, std::true_type) {
+  q.push(item);
+}
+
+template <class Queue>
+bool pop_item(Queue& q, std::uint64_t& item, std::false_type) {
+  return q.try_pop(item);
+}
+
+template <class Queue>
+bool pop_item(Queue& q, std::uint64_t& item, std::true_type) {
+  q.pop(item);
+  return true;
+}
+
+// Each producer pushes an increasing sequence tagged with its id; consumers
+// check per-producer order and the total.
+template <class Queue, bool Blocking>
+void stress(int producers, int consumers) {
+  using blocking = std::integral_constant<bool, Blocking>;
+  constexpr std::uint64_t kPerProducer = 20000;
+  Queue q(64);
+  std::atomic<std::uint64_t> sum{0};
+  std::atomic<std::uint64_t> popped{0};
+  const std::uint64_t total = kPerProducer * producers;
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producers; ++p) {
+    threads.emplace_back([&, p] {
+      for (std::uint64_t i = 0; i < kPerProducer; ++i) {
+        const std::uint64_t item = (std::uint64_t(p) << 32) | i;
+        push_item(q, item, blocking{});
+      }
+    });
+  }
+  for (int c = 0; c < consumers; ++c) {
+    threads.emplace_back([&] {
+      std::vector<std::uint64_t> last(producers, 0);
+      std::uint64_t item;
+      while (popped.load() < total) {
+        // Blocking consumers reserve an item first so none waits forever.
+        if (Blocking && popped.fetch_add(1) >= total) {
+          break;
+        }
+        if (!pop_item(q, item, blocking{})) {
+          std::this_thread::yield();
+          continue;
+        }
+        if (!Blocking) {
+          popped.fetch_add(1);
+        }
+        const auto producer = item >> 32;
+        const auto seq = item & 0xffffffffu;
+        ASSERT_TRUE(seq + 1 > last[producer]);
+        last[producer] = seq + 1;
+        sum.fetch_add(seq);
+      }
+    });
+  }
+  for (auto& th : threads) {
+    th.join();
+  }
+  ASSERT_EQ(sum.load(),
+            producers * (kPerProducer * (kPerProducer - 1) / 2));
+}
+}  // namespace
+
+TEST(stdcpp_queue, spsc_fifo_order) { fifo_order<stdcpp::spsc_queue<int>>(); }
+
+TEST(stdcpp_queue, mpmc_fifo_order) { fifo_order<stdcpp::mpmc_queue<int>>(); }
+
+TEST(stdcpp_queue, spsc_batches) { batches<stdcpp::spsc_queue<int>>(); }
+
+TEST(stdcpp_queue, mpmc_batches) { batches<stdcpp::mpmc_queue<int>>(); }
+
+TEST(stdcpp_queue, destroys_remaining_items) {
+  {
+    stdcpp::spsc_queue<counted> spsc(4);
+    stdcpp::mpmc_queue<counted> mpmc(4);
+    spsc.try_emplace(1);
+    spsc.try_emplace(2);
+    mpmc.try_emplace(3);
+    counted out;
+    ASSERT_TRUE(spsc.try_pop(out));
+    ASSERT_EQ(out.value, 1);
+    ASSERT_EQ(counted::live, 3);
+  }
+  ASSERT_EQ(counted::live, 0);
+}
+
+TEST(stdcpp_queue, non_trivial_elements) {
+  stdcpp::mpmc_queue<std::string> q(2);
+  ASSERT_TRUE(q.try_push(std::string(100, 'x')));
+  const std::string copy(50, 'y');
+  ASSERT_TRUE(q.try_push(copy));
+  std::string out;
+  ASSERT_TRUE(q.try_pop(out));
+  ASSERT_EQ(out.size(), 100u);
+  ASSERT_TRUE(q.try_pop(out));
+  ASSERT_EQ(out, copy);
+}
+
+TEST(stdcpp_queue, spsc_stress) {
+  stress<stdcpp::spsc_queue<std::uint64_t>, false>(1, 1);
+}
+
+TEST(stdcpp_queue, spsc_blocking_stress) {
+  stress<stdcpp::spsc_queue<std::uint64_t, true>, true>(1, 1);
+}
+
+TEST(stdcpp_queue, mpmc_stress) {
+  stress<stdcpp::mpmc_queue<std::uint64_t>, false>(4, 4);
+}
+
+TEST(stdcpp_queue, mpmc_blocking_stress) {
+  stress<stdcpp::mpmc_queue<std::uint64_t, true>, true>(3, 3);
+}
+
+TEST(stdcpp_queue, mpmc_blocking_wakes_a_waiter_per_item) {
+  stdcpp::mpmc_queue<int, true> q(16);
+  for (bool batch : {true, false}) {
+    std::atomic<int> sum{0};
+    std::vector<std::thread> consumers;
+    for (int c = 0; c < 4; ++c) {
+      consumers.emplace_back([&] {
+        int item;
+        q.pop(item);
+        sum.fetch_add(item);
+      });
+    }
+    // Let the consumers go to sleep on the empty queue.
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    const int items[4] = {1, 2, 3, 4};
+    if (batch) {
+      ASSERT_EQ(q.try_push_n(items, 4), 4u);
+    } else {
+      for (int item : items) {
+        q.push(item);
+      }
+    }
+    for (auto& th : consumers) {
+      th.join();
+    }
+    ASSERT_EQ(sum.load(), 10);
+  }
+}
@@ -1,8 +1,14 @@
 #include <gtest/gtest.h>
 #include <ranges.hpp>
 
+#include <algorithm>
 #include <array>
+#include <forward_list>
 #include <list>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -310,4 +316,570 @@ TEST(stdcpp_ranges, range_common_reference_t) {
       stdcpp::is_same_v<
           stdcpp::ranges::range_common_reference_t<std::array<char, 5>>, char&>,
       "Common reference type should be char& for std::array<char, 5>");
-}
\ No newline at end of file
+}
+TEST(stdcpp_ranges, views_all) {
+  std::vector<int> v{1, 2, 3};
+  auto ref = stdcpp::views::all(v);
+  static_assert(stdcpp::is_same_v<decltype(ref),
+                                  stdcpp::ranges::ref_view<std::vector<int>>>,
+                "lvalues are referenced");
+  ASSERT_EQ(ref.size(), 3u);
+  ASSERT_EQ(ref.data(), v.data());
+  ASSERT_EQ(ref.front(), 1);
+  ASSERT_EQ(ref.back(), 3);
+  ASSERT_EQ(ref[1], 2);
+
+  auto owned = std::vector<int>{4, 5} | stdcpp::views::all;
+  static_assert(
+      stdcpp::is_same_v<decltype(owned),
+                        stdcpp::ranges::owning_view<std::vector<int>>>,
+      "rvalues are moved into the view");
+  ASSERT_EQ(owned.size(), 2u);
+  ASSERT_EQ(*owned.begin(), 4);
+
+  // Views are returned as they are.
+  static_assert(
+      stdcpp::is_same_v<decltype(stdcpp::views::all(ref)), decltype(ref)>,
+      "views are copied");
+}
+
+TEST(stdcpp_ranges, views_filter) {
+  std::vector<int> v{1, 2, 3, 4, 5, 6};
+  int calls = 0;
+  auto even = stdcpp::views::filter(v, [&calls](int x) {
+    ++calls;
+    return x % 2 == 0;
+  });
+  ASSERT_EQ(calls, 0);
+  std::vector<int> out(even.begin(), even.end());
+  ASSERT_EQ(out, (std::vector<int>{2, 4, 6}));
+  ASSERT_EQ(even.front(), 2);
+
+  // Bidirectional, like the base's iterators allow.
+  auto it = even.end();
+  ASSERT_EQ(*--it, 6);
+  ASSERT_EQ(*--it, 4);
+  static_assert(
+      stdcpp::is_same_v<
+          std::iterator_traits<decltype(it)>::iterator_category,
+          std::bidirectional_iterator_tag>,
+      "filter caps the category at bidirectional");
+
+  // Elements are references into the base.
+  for (int& x : v | stdcpp::views::filter([](int x) { return x > 4; })) {
+    x = 0;
+  }
+  ASSERT_EQ(v, (std::vector<int>{1, 2, 3, 4, 0, 0}));
+
+  auto none = v | stdcpp::views::filter([](int x) { return x > 100; });
+  ASSERT_TRUE(none.empty());
+  ASSERT_FALSE(none);
+}
+
+TEST(stdcpp_ranges, views_transform) {
+  const std::vector<int> v{1, 2, 3};
+  auto squares = v | stdcpp::views::transform([](int x) { return x * x; });
+  std::vector<int> out(squares.begin(), squares.end());
+  ASSERT_EQ(out, (std::vector<int>{1, 4, 9}));
+  ASSERT_EQ(squares.size(), 3u);
+  ASSERT_EQ(squares[2], 9);
+  ASSERT_EQ(squares.end() - squares.begin(), 3);
+  ASSERT_EQ(squares.back(), 9);
+
+  // Lvalue results keep the base's category, prvalues are input only.
+  std::vector<std::pair<int, char>> pairs{{1, 'a'}, {2, 'b'}};
+  auto firsts = pairs | stdcpp::views::transform(
+                            [](std::pair<int, char>& p) -> int& {
+                              return p.first;
+                            });
+  static_assert(
+      stdcpp::is_same_v<
+          std::iterator_traits<decltype(firsts.begin())>::iterator_category,
+          std::random_access_iterator_tag>,
+      "lvalue results keep random access");
+  static_assert(
+      stdcpp::is_same_v<
+          std::iterator_traits<decltype(squares.begin())>::iterator_category,
+          std::input_iterator_tag>,
+      "prvalue results are input iterators");
+  static_assert(
+      std::is_base_of<std::random_access_iterator_tag,
+                      decltype(squares.begin())::iterator_concept>::value,
+      "but remain random access");
+  static_assert(
+      stdcpp::is_same_v<stdcpp::ranges::range_reference_t<decltype(firsts)>,
+                        int&>,
+      "reference is the function's result");
+  static_assert(
+      stdcpp::is_same_v<stdcpp::ranges::range_value_t<decltype(squares)>, int>,
+      "value_type is the decayed result");
+  firsts[1] = 7;
+  ASSERT_EQ(pairs[1].first, 7);
+
+  // Usable through a const view.
+  const auto& const_squares = squares;
+  ASSERT_EQ(*const_squares.begin(), 1);
+}
+
+TEST(stdcpp_ranges, views_pipe_composition) {
+  std::vector<int> v{1, 2, 3, 4, 5, 6, 7};
+  auto odd = [](int x) { return x % 2 != 0; };
+  auto square = [](int x) { return x * x; };
+
+  auto pipeline = stdcpp::views::filter(odd) | stdcpp::views::transform(square);
+  auto view = v | pipeline;
+  std::vector<int> out;
+  for (int x : view) {
+    out.push_back(x);
+  }
+  ASSERT_EQ(out, (std::vector<int>{1, 9, 25, 49}));
+
+  auto direct = stdcpp::views::transform(stdcpp::views::filter(v, odd), square);
+  ASSERT_TRUE(std::equal(direct.begin(), direct.end(), out.begin()));
+
+  // The pipeline holds the lambdas by value; no type erasure.
+  static_assert(sizeof(view) <= 64,
+                "views hold their functions inline");
+
+  // Views are copyable and assignable, even over lambdas.
+  auto copy = view;
+  copy = view;
+  ASSERT_TRUE(std::equal(copy.begin(), copy.end(), out.begin()));
+}
+
+TEST(stdcpp_ranges, views_iota) {
+  auto r = stdcpp::views::iota(2, 6);
+  std::vector<int> out(r.begin(), r.end());
+  ASSERT_EQ(out, (std::vector<int>{2, 3, 4, 5}));
+  ASSERT_EQ(r.size(), 4u);
+  ASSERT_EQ(r[3], 5);
+  ASSERT_EQ(r.end() - r.begin(), 4);
+
+  std::vector<int> v{7, 8, 9};
+  std::size_t sum = 0;
+  for (auto i : stdcpp::views::iota(0, v.size())) {
+    static_assert(stdcpp::is_same_v<decltype(i), std::size_t>,
+                  "mixed integers meet in their common type");
+    sum += i;
+  }
+  ASSERT_EQ(sum, 3u);
+
+  // Unbounded, then cut to size: random access and sized again.
+  auto first = stdcpp::views::iota(10) | stdcpp::views::take(3);
+  ASSERT_EQ(first.size(), 3u);
+  ASSERT_EQ(first[2], 12);
+  static_assert(
+      stdcpp::is_same_v<decltype(first.begin()), decltype(first.end())>,
+      "take of an unbounded iota is common");
+}
+
+TEST(stdcpp_ranges, views_take) {
+  std::vector<int> v{1, 2, 3, 4, 5};
+  auto t = v | stdcpp::views::take(3);
+  static_assert(
+      stdcpp::is_same_v<decltype(t.begin()), std::vector<int>::iterator>,
+      "random-access ranges keep their iterators");
+  ASSERT_EQ(stdcpp::ranges::size(t), 3u);
+  ASSERT_EQ(stdcpp::ranges::data(t), v.data());
+  ASSERT_EQ(std::vector<int>(t.begin(), t.end()),
+            (std::vector<int>{1, 2, 3}));
+  ASSERT_EQ((v | stdcpp::views::take(10)).size(), 5u);
+
+  std::list<int> l{1, 2, 3, 4, 5};
+  auto lt = l | stdcpp::views::take(2);
+  ASSERT_EQ(lt.size(), 2u);
+  ASSERT_EQ(std::vector<int>(lt.begin(), lt.end()), (std::vector<int>{1, 2}));
+  auto all = l | stdcpp::views::take(9);
+  ASSERT_EQ(std::vector<int>(all.begin(), all.end()),
+            (std::vector<int>{1, 2, 3, 4, 5}));
+
+  // Composes with the lazy views.
+  auto odd = stdcpp::views::iota(0) |
+             stdcpp::views::filter([](int x) { return x % 2 != 0; }) |
+             stdcpp::views::take(3);
+  ASSERT_EQ(std::vector<int>(odd.begin(), odd.end()),
+            (std::vector<int>{1, 3, 5}));
+}
+
+TEST(stdcpp_ranges, views_drop) {
+  std::vector<int> v{1, 2, 3, 4, 5};
+  auto d = v | stdcpp::views::drop(2);
+  // O(1): begin() is computed, not walked, and data() follows it.
+  ASSERT_EQ(d.begin(), v.begin() + 2);
+  ASSERT_EQ(stdcpp::ranges::size(d), 3u);
+  ASSERT_EQ(stdcpp::ranges::data(d), v.data() + 2);
+  ASSERT_EQ(d[0], 3);
+  ASSERT_TRUE((v | stdcpp::views::drop(9)).empty());
+  ASSERT_EQ((v | stdcpp::views::drop(9)).size(), 0u);
+
+  const std::list<int> l{1, 2, 3};
+  auto ld = l | stdcpp::views::drop(1);
+  ASSERT_EQ(ld.size(), 2u);
+  ASSERT_EQ(std::vector<int>(ld.begin(), ld.end()), (std::vector<int>{2, 3}));
+
+  auto window = v | stdcpp::views::drop(1) | stdcpp::views::take(3);
+  ASSERT_EQ(stdcpp::ranges::data(window), v.data() + 1);
+  ASSERT_EQ(window.size(), 3u);
+}
+
+TEST(stdcpp_ranges, views_take_while_and_drop_while) {
+  std::vector<int> v{1, 2, 3, 10, 4, 5};
+  auto small = [](int x) { return x < 5; };
+
+  auto head = v | stdcpp::views::take_while(small);
+  ASSERT_EQ(std::vector<int>(head.begin(), head.end()),
+            (std::vector<int>{1, 2, 3}));
+
+  auto tail = v | stdcpp::views::drop_while(small);
+  ASSERT_EQ(std::vector<int>(tail.begin(), tail.end()),
+            (std::vector<int>{10, 4, 5}));
+  ASSERT_EQ(tail.size(), 3u);
+  ASSERT_EQ(stdcpp::ranges::data(tail), v.data() + 3);
+
+  auto squares = stdcpp::views::iota(1) |
+                 stdcpp::views::transform([](int x) { return x * x; }) |
+                 stdcpp::views::take_while([](int x) { return x < 30; });
+  ASSERT_EQ(std::vector<int>(squares.begin(), squares.end()),
+            (std::vector<int>{1, 4, 9, 16, 25}));
+
+  ASSERT_TRUE((v | stdcpp::views::take_while([](int) { return false; }))
+                  .empty());
+  ASSERT_TRUE((v | stdcpp::views::drop_while([](int) { return true; }))
+                  .empty());
+}
+
+TEST(stdcpp_ranges, views_counted) {
+  int a[] = {1, 2, 3, 4};
+  auto c = stdcpp::views::counted(a + 1, 2);
+  ASSERT_EQ(c.size(), 2u);
+  ASSERT_EQ(stdcpp::ranges::data(c), a + 1);
+  ASSERT_EQ(c[1], 3);
+
+  std::list<int> l{5, 6, 7};
+  auto lc = stdcpp::views::counted(l.begin(), 2);
+  ASSERT_EQ(lc.size(), 2u);
+  ASSERT_EQ(std::vector<int>(lc.begin(), lc.end()), (std::vector<int>{5, 6}));
+}
+
+TEST(stdcpp_ranges, views_zip) {
+  std::vector<int> keys{3, 1, 2, 5};
+  std::vector<std::string> names{"c", "a", "b"};
+  auto z = stdcpp::views::zip(keys, names);
+  ASSERT_EQ(z.size(), 3u);
+  ASSERT_EQ(z.end() - z.begin(), 3);
+  ASSERT_EQ(std::get<0>(z[2]), 2);
+  ASSERT_EQ(std::get<1>(z.back()), "b");
+  static_assert(
+      std::is_same<decltype(*z.begin()),
+                   stdcpp::ranges::common_tuple<int&, std::string&>>::value,
+      "zip yields tuples of references");
+
+  // Sorting the zip sorts both columns by key.
+  std::sort(z.begin(), z.end(), [](const auto& a, const auto& b) {
+    return std::get<0>(a) < std::get<0>(b);
+  });
+  ASSERT_EQ(keys, (std::vector<int>{1, 2, 3, 5}));
+  ASSERT_EQ(names, (std::vector<std::string>{"a", "b", "c"}));
+
+  std::get<1>(*z.begin()) = "x";
+  ASSERT_EQ(names[0], "x");
+
+  // Lists end at the first of their ends; iota never does.
+  std::list<int> l{10, 20};
+  std::vector<int> seen;
+  for (auto t : stdcpp::views::zip(l, keys)) {
+    seen.push_back(std::get<0>(t) + std::get<1>(t));
+  }
+  ASSERT_EQ(seen, (std::vector<int>{11, 22}));
+  auto counted = stdcpp::views::zip(l, stdcpp::views::iota(1));
+  seen.clear();
+  for (auto it = counted.begin(); it != counted.end(); ++it) {
+    seen.push_back(std::get<0>(*it) * std::get<1>(*it));
+  }
+  ASSERT_EQ(seen, (std::vector<int>{10, 40}));
+  ASSERT_EQ(stdcpp::views::zip(stdcpp::views::iota(0), keys).size(), 4u);
+
+  auto unbounded = stdcpp::views::zip(stdcpp::views::iota(0),
+                                      stdcpp::views::iota(10)) |
+                   stdcpp::views::take(2);
+  ASSERT_EQ(std::get<1>(unbounded[1]), 11);
+}
+
+TEST(stdcpp_ranges, views_zip_iter_move_and_iter_swap) {
+  std::vector<std::string> a{"a", "b"};
+  std::vector<int> b{1, 2};
+  auto z = stdcpp::views::zip(a, b);
+  using rvalue = stdcpp::ranges::range_rvalue_reference_t<decltype(z)>;
+  static_assert(
+      std::is_same<rvalue,
+                   stdcpp::ranges::common_tuple<std::string&&, int&&>>::value,
+      "iter_move moves the elements");
+  static_assert(
+      std::is_same<
+          stdcpp::ranges::range_common_reference_t<decltype(z)>,
+          stdcpp::ranges::common_tuple<std::string&, int&>>::value,
+      "the reference and value types have a common reference");
+
+  std::tuple<std::string, int> moved = stdcpp::ranges::iter_move(z.begin());
+  ASSERT_EQ(std::get<0>(moved), "a");
+  ASSERT_TRUE(a[0].empty());
+
+  stdcpp::ranges::iter_swap(z.begin(), z.begin() + 1);
+  ASSERT_EQ(a, (std::vector<std::string>{"b", ""}));
+  ASSERT_EQ(b, (std::vector<int>{2, 1}));
+
+  int x = 1;
+  int y = 2;
+  stdcpp::ranges::iter_swap(&x, &y);
+  ASSERT_EQ(x, 2);
+  ASSERT_EQ(y, 1);
+}
+
+TEST(stdcpp_ranges, views_zip_transform) {
+  std::vector<int> a{1, 2, 3};
+  std::array<int, 4> b{10, 20, 30, 40};
+  auto sums = stdcpp::views::zip_transform(std::plus<int>(), a, b);
+  ASSERT_EQ(sums.size(), 3u);
+  ASSERT_EQ(std::vector<int>(sums.begin(), sums.end()),
+            (std::vector<int>{11, 22, 33}));
+  ASSERT_EQ(sums[1], 22);
+}
+
+TEST(stdcpp_ranges, views_enumerate) {
+  std::vector<char> v{'a', 'b', 'c'};
+  auto e = v | stdcpp::views::enumerate;
+  ASSERT_EQ(e.size(), 3u);
+  ASSERT_EQ(std::get<0>(e[2]), 2);
+  ASSERT_EQ(std::get<1>(e.back()), 'c');
+  for (auto t : e) {
+    std::get<1>(t) = static_cast<char>(std::get<1>(t) + std::get<0>(t));
+  }
+  ASSERT_EQ(v, (std::vector<char>{'a', 'c', 'e'}));
+
+  std::list<int> l{4, 5};
+  auto le = stdcpp::views::enumerate(l);
+  auto last = le.end();
+  --last;
+  ASSERT_EQ(std::get<0>(*last), 1);
+  ASSERT_EQ(std::get<1>(*last), 5);
+
+  std::forward_list<int> fl{7, 8, 9};
+  std::vector<long> indices;
+  for (auto t : stdcpp::views::enumerate(fl)) {
+    indices.push_back(static_cast<long>(std::get<0>(t)));
+  }
+  ASSERT_EQ(indices, (std::vector<long>{0, 1, 2}));
+
+  auto from_iota = stdcpp::views::iota(5) | stdcpp::views::enumerate |
+                   stdcpp::views::take(2);
+  ASSERT_EQ(std::get<1>(from_iota[1]), 6);
+}
+
+TEST(stdcpp_ranges, views_chunk) {
+  std::vector<int> v{1, 2, 3, 4, 5, 6, 7};
+  auto c = v | stdcpp::views::chunk(3);
+  ASSERT_EQ(c.size(), 3u);
+  ASSERT_EQ(c.end() - c.begin(), 3);
+  // Chunks of a vector are contiguous, ready for code taking a pointer.
+  ASSERT_EQ(stdcpp::ranges::data(c[1]), v.data() + 3);
+  ASSERT_EQ(c[1].size(), 3u);
+  ASSERT_EQ(c.back().data(), v.data() + 6);
+  ASSERT_EQ(c.back().size(), 1u);
+  std::vector<int> sums;
+  for (auto chunk : c) {
+    sums.push_back(std::accumulate(chunk.begin(), chunk.end(), 0));
+  }
+  ASSERT_EQ(sums, (std::vector<int>{6, 15, 7}));
+
+  std::list<int> l{1, 2, 3, 4, 5};
+  auto lc = stdcpp::views::chunk(l, 2);
+  auto last = lc.end();
+  --last;
+  ASSERT_EQ((*last).front(), 5);
+  --last;
+  ASSERT_EQ((*last).front(), 3);
+
+  std::forward_list<int> fl{1, 2, 3, 4, 5};
+  std::vector<long> sizes;
+  for (auto chunk : stdcpp::views::chunk(fl, 4)) {
+    sizes.push_back(std::distance(chunk.begin(), chunk.end()));
+  }
+  ASSERT_EQ(sizes, (std::vector<long>{4, 1}));
+}
+
+TEST(stdcpp_ranges, views_stride) {
+  std::vector<int> v{1, 2, 3, 4, 5, 6, 7};
+  auto s = v | stdcpp::views::stride(3);
+  ASSERT_EQ(s.size(), 3u);
+  ASSERT_EQ(std::vector<int>(s.begin(), s.end()), (std::vector<int>{1, 4, 7}));
+  auto last = s.end();
+  --last;
+  ASSERT_EQ(*last, 7);
+  ASSERT_EQ(s.end() - s.begin(), 3);
+  s[1] = 40;
+  ASSERT_EQ(v[3], 40);
+
+  std::list<int> l{1, 2, 3, 4, 5, 6};
+  auto ls = stdcpp::views::stride(l, 4);
+  auto lend = ls.end();
+  --lend;
+  ASSERT_EQ(*lend, 5);
+
+  auto every_fifth = stdcpp::views::iota(0) | stdcpp::views::stride(5) |
+                     stdcpp::views::take(3);
+  ASSERT_EQ(std::vector<int>(every_fifth.begin(), every_fifth.end()),
+            (std::vector<int>{0, 5, 10}));
+}
+
+TEST(stdcpp_ranges, views_slide) {
+  std::vector<int> v{1, 2, 3, 4, 5};
+  auto s = v | stdcpp::views::slide(3);
+  ASSERT_EQ(s.size(), 3u);
+  ASSERT_EQ(s.end() - s.begin(), 3);
+  ASSERT_EQ(s[1].data(), v.data() + 1);
+  ASSERT_EQ(s[1].size(), 3u);
+  ASSERT_EQ(s.back().front(), 3);
+  std::vector<int> sums;
+  for (auto window : s) {
+    sums.push_back(std::accumulate(window.begin(), window.end(), 0));
+  }
+  ASSERT_EQ(sums, (std::vector<int>{6, 9, 12}));
+
+  std::vector<int> shorter{1, 2};
+  ASSERT_TRUE((shorter | stdcpp::views::slide(3)).empty());
+  ASSERT_EQ((shorter | stdcpp::views::slide(3)).size(), 0u);
+
+  std::list<int> l{1, 2, 3, 4};
+  auto ls = stdcpp::views::slide(l, 2);
+  auto last = ls.end();
+  --last;
+  ASSERT_EQ((*last).front(), 3);
+
+  std::forward_list<int> fl{1, 2, 3};
+  long windows = 0;
+  for (auto window : stdcpp::views::slide(fl, 2)) {
+    ASSERT_EQ(std::distance(window.begin(), window.end()), 2);
+    ++windows;
+  }
+  ASSERT_EQ(windows, 2);
+}
+
+TEST(stdcpp_ranges, views_adjacent) {
+  std::vector<int> v{1, 2, 3, 4};
+  auto pairs = v | stdcpp::views::adjacent<2>;
+  ASSERT_EQ(pairs.size(), 3u);
+  int sum_of_products = 0;
+  for (auto p : pairs) {
+    sum_of_products += std::get<0>(p) * std::get<1>(p);
+  }
+  ASSERT_EQ(sum_of_products, 2 + 6 + 12);
+  std::get<1>(pairs[0]) = 20;
+  ASSERT_EQ(v[1], 20);
+  ASSERT_EQ(std::get<0>(pairs.back()), 3);
+
+  std::list<int> l{1, 2, 3, 4};
+  auto triples = l | stdcpp::views::adjacent<3>;
+  auto last = triples.end();
+  --last;
+  ASSERT_EQ(std::get<0>(*last), 2);
+  ASSERT_EQ(std::get<2>(*last), 4);
+  ASSERT_EQ(std::distance(triples.begin(), triples.end()), 2);
+
+  std::forward_list<int> fl{5};
+  ASSERT_TRUE((fl | stdcpp::views::pairwise).empty());
+}
+
+TEST(stdcpp_ranges, views_join) {
+  std::vector<std::vector<int>> vv{{1, 2}, {}, {3}, {}, {4, 5}};
+  auto j = vv | stdcpp::views::join;
+  ASSERT_EQ(std::vector<int>(j.begin(), j.end()),
+            (std::vector<int>{1, 2, 3, 4, 5}));
+  auto last = j.end();
+  --last;
+  ASSERT_EQ(*last, 5);
+  --last;
+  --last;
+  ASSERT_EQ(*last, 3);
+  *last = 30;
+  ASSERT_EQ(vv[2][0], 30);
+
+  const std::vector<std::string> words{"ab", "", "c"};
+  std::string joined;
+  for (char c : stdcpp::views::join(words)) {
+    joined += c;
+  }
+  ASSERT_EQ(joined, "abc");
+
+  std::vector<std::vector<std::vector<int>>> nested{{{1}, {2}}, {}, {{3}}};
+  auto flat = nested | stdcpp::views::join | stdcpp::views::join;
+  ASSERT_EQ(std::vector<int>(flat.begin(), flat.end()),
+            (std::vector<int>{1, 2, 3}));
+
+  std::vector<std::vector<int>> empties{{}, {}};
+  ASSERT_TRUE((empties | stdcpp::views::join).empty());
+}
+
+TEST(stdcpp_ranges, views_join_with) {
+  std::vector<std::string> words{"ab", "", "cd"};
+  auto commas = words | stdcpp::views::join_with(',');
+  ASSERT_EQ(std::string(commas.begin(), commas.end()), "ab,,cd");
+
+  // A temporary pattern is kept by value, an lvalue one by reference.
+  auto spaced = stdcpp::views::join_with(words, std::string(", "));
+  ASSERT_EQ(std::string(spaced.begin(), spaced.end()), "ab, , cd");
+  std::string dash = "-";
+  auto dashed = words | stdcpp::views::join_with(dash);
+  dash = "+";
+  ASSERT_EQ(std::string(dashed.begin(), dashed.end()), "ab++cd");
+
+  std::list<std::vector<int>> rows{{1, 2}, {3}};
+  std::vector<int> separator{0, 0};
+  auto j = stdcpp::views::join_with(rows, separator);
+  ASSERT_EQ(std::vector<int>(j.begin(), j.end()),
+            (std::vector<int>{1, 2, 0, 0, 3}));
+
+  std::vector<std::string> one{"x"};
+  auto single = one | stdcpp::views::join_with('/');
+  ASSERT_EQ(std::string(single.begin(), single.end()), "x");
+  std::vector<std::string> none;
+  ASSERT_TRUE((none | stdcpp::views::join_with('/')).empty());
+}
+
+TEST(stdcpp_ranges, to) {
+  // Sized views reserve once, even when they are not random access.
+  auto squares = stdcpp::views::iota(0, 5) |
+                 stdcpp::views::transform([](int x) { return x * x; }) |
+                 stdcpp::ranges::to<std::vector>();
+  ASSERT_EQ(squares, (std::vector<int>{0, 1, 4, 9, 16}));
+  ASSERT_EQ(squares.capacity(), 5u);
+
+  auto odd = stdcpp::views::iota(0, 10) |
+             stdcpp::views::filter([](int x) { return x % 2 != 0; }) |
+             stdcpp::ranges::to<std::vector<long>>();
+  ASSERT_EQ(odd, (std::vector<long>{1, 3, 5, 7, 9}));
+
+  std::vector<char> chars{'a', 'b', 'c'};
+  ASSERT_EQ(stdcpp::ranges::to<std::string>(chars), "abc");
+  ASSERT_EQ(chars | stdcpp::views::take(2) | stdcpp::ranges::to<std::string>(),
+            "ab");
+
+  std::vector<std::pair<int, std::string>> pairs{{2, "b"}, {1, "a"}};
+  auto map = pairs | stdcpp::ranges::to<std::map>();
+  ASSERT_EQ(map.begin()->second, "a");
+  ASSERT_EQ((std::vector<int>{3, 1, 3} | stdcpp::ranges::to<std::set>()).size(),
+            2u);
+
+  std::allocator<int> alloc;
+  auto with_alloc = squares | stdcpp::ranges::to<std::vector<int>>(alloc);
+  ASSERT_EQ(with_alloc, squares);
+}
+
+TEST(stdcpp_ranges, to_nested) {
+  std::vector<std::list<int>> lists{{1, 2}, {3}};
+  auto vectors = stdcpp::ranges::to<std::vector<std::vector<int>>>(lists);
+  ASSERT_EQ(vectors, (std::vector<std::vector<int>>{{1, 2}, {3}}));
+
+  auto batches = std::vector<int>{1, 2, 3, 4, 5} | stdcpp::views::chunk(2) |
+                 stdcpp::ranges::to<std::vector<std::vector<int>>>();
+  ASSERT_EQ(batches, (std::vector<std::vector<int>>{{1, 2}, {3, 4}, {5}}));
+}
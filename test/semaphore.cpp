@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include <semaphore.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+TEST(stdcpp_semaphore, max) {
+  static_assert(stdcpp::binary_semaphore::max() == 1, "binary max is 1");
+  static_assert(stdcpp::counting_semaphore<8>::max() == 8, "max is preserved");
+  ASSERT_GE(stdcpp::counting_semaphore<>::max(), 1 << 30);
+}
+
+TEST(stdcpp_semaphore, try_acquire_consumes_count) {
+  stdcpp::counting_semaphore<4> sem(2);
+  ASSERT_TRUE(sem.try_acquire());
+  ASSERT_TRUE(sem.try_acquire());
+  ASSERT_FALSE(sem.try_acquire());
+  sem.release(2);
+  ASSERT_TRUE(sem.try_acquire());
+  ASSERT_TRUE(sem.try_acquire());
+  ASSERT_FALSE(sem.try_acquire());
+}
+
+TEST(stdcpp_semaphore, try_acquire_for_times_out) {
+  stdcpp::binary_semaphore sem(0);
+  const auto start = std::chrono::steady_clock::now();
+  ASSERT_FALSE(sem.try_acquire_for(std::chrono::milliseconds(20)));
+  ASSERT_GE(std::chrono::steady_clock::now() - start,
+            std::chrono::milliseconds(20));
+}
+
+TEST(stdcpp_semaphore, try_acquire_until_succeeds_after_release) {
+  stdcpp::binary_semaphore sem(0);
+  std::thread releaser([&] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    sem.release();
+  });
+  ASSERT_TRUE(sem.try_acquire_until(std::chrono::system_clock::now() +
+                                    std::chrono::seconds(10)));
+  releaser.join();
+  ASSERT_FALSE(sem.try_acquire());
+}
+
+TEST(stdcpp_semaphore, binary_ping_pong) {
+  stdcpp::binary_semaphore ping(0);
+  stdcpp::binary_semaphore pong(0);
+  constexpr int kRounds = 2000;
+  int shared = 0;
+  std::thread other([&] {
+    for (int i = 0; i < kRounds; ++i) {
+      ping.acquire();
+      ++shared;
+      pong.release();
+    }
+  });
+  for (int i = 0; i < kRounds; ++i) {
+    ping.release();
+    pong.acquire();
+    ASSERT_EQ(shared, i + 1);
+  }
+  other.join();
+}
+
+TEST(stdcpp_semaphore, bounds_in_flight_requests) {
+  constexpr int kLimit = 3;
+  stdcpp::counting_semaphore<kLimit> sem(kLimit);
+  std::atomic<int> in_flight{0};
+  std::atomic<int> peak{0};
+  std::atomic<int> completed{0};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 8; ++t) {
+    threads.emplace_back([&] {
+      for (int i = 0; i < 200; ++i) {
+        sem.acquire();
+        const int now = in_flight.fetch_add(1) + 1;
+        int seen = peak.load();
+        while (now > seen && !peak.compare_exchange_weak(seen, now)) {
+        }
+        std::this_thread::yield();
+        in_flight.fetch_sub(1);
+        completed.fetch_add(1);
+        sem.release();
+      }
+    });
+  }
+  for (auto& th : threads) {
+    th.join();
+  }
+  ASSERT_EQ(completed.load(), 8 * 200);
+  ASSERT_LE(peak.load(), kLimit);
+  ASSERT_EQ(in_flight.load(), 0);
+  for (int i = 0; i < kLimit; ++i) {
+    ASSERT_TRUE(sem.try_acquire());
+  }
+  ASSERT_FALSE(sem.try_acquire());
+}
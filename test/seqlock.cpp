@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include <seqlock.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace {
+struct triple {
+  std::uint64_t a;
+  std::uint64_t b;
+  std::uint64_t c;
+};
+
+struct odd_sized {
+  char bytes[13];
+};
+}  // namespace
+
+TEST(stdcpp_seqlock, default_constructed_value) {
+  stdcpp::seqlock<int> lock;
+  ASSERT_EQ(lock.load(), 0);
+  ASSERT_EQ(lock.version(), 0u);
+}
+
+TEST(stdcpp_seqlock, store_then_load) {
+  stdcpp::seqlock<triple> lock(triple{1, 2, 3});
+  auto v = lock.load();
+  ASSERT_EQ(v.a, 1u);
+  ASSERT_EQ(v.c, 3u);
+
+  lock.store(triple{4, 5, 6});
+  v = lock.load();
+  ASSERT_EQ(v.a, 4u);
+  ASSERT_EQ(v.b, 5u);
+  ASSERT_EQ(v.c, 6u);
+  ASSERT_EQ(lock.version(), 1u);
+}
+
+TEST(stdcpp_seqlock, payload_not_multiple_of_word) {
+  odd_sized in{};
+  for (int i = 0; i < 13; ++i) {
+    in.bytes[i] = static_cast<char>('a' + i);
+  }
+  stdcpp::seqlock<odd_sized> lock(in);
+  auto out = lock.load();
+  for (int i = 0; i < 13; ++i) {
+    ASSERT_EQ(out.bytes[i], in.bytes[i]);
+  }
+}
+
+TEST(stdcpp_seqlock, try_load_succeeds_without_writer) {
+  stdcpp::seqlock<int> lock(42);
+  int out = 0;
+  ASSERT_TRUE(lock.try_load(out));
+  ASSERT_EQ(out, 42);
+}
+
+TEST(stdcpp_seqlock, update_is_serialized) {
+  stdcpp::seqlock<std::uint64_t> lock;
+  constexpr int kThreads = 4;
+  constexpr int kIncrements = 2000;
+  std::vector<std::thread> writers;
+  for (int t = 0; t < kThreads; ++t) {
+    writers.emplace_back([&] {
+      for (int i = 0; i < kIncrements; ++i) {
+        lock.update([](std::uint64_t& v) { ++v; });
+      }
+    });
+  }
+  for (auto& w : writers) {
+    w.join();
+  }
+  ASSERT_EQ(lock.load(), static_cast<std::uint64_t>(kThreads * kIncrements));
+}
+
+TEST(stdcpp_seqlock, stress_readers_never_observe_torn_values) {
+  stdcpp::seqlock<triple> lock(triple{0, 0, ~0ull});
+  std::atomic<bool> done{false};
+  std::atomic<int> torn{0};
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 3; ++t) {
+    threads.emplace_back([&] {
+      while (!done.load(std::memory_order_relaxed)) {
+        const auto v = lock.load();
+        if (v.b != v.a * 2 || v.c != ~v.a) {
+          torn.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+    });
+  }
+  for (int t = 0; t < 2; ++t) {
+    threads.emplace_back([&, t] {
+      for (std::uint64_t i = 0; i < 20000; ++i) {
+        const std::uint64_t a = i * 2 + t;
+        lock.store(triple{a, a * 2, ~a});
+      }
+    });
+  }
+  threads[3].join();
+  threads[4].join();
+  done = true;
+  for (int t = 0; t < 3; ++t) {
+    threads[t].join();
+  }
+  ASSERT_EQ(torn.load(), 0);
+  ASSERT_EQ(lock.version(), 40000u);
+}
@@ -1,7 +1,13 @@
 #include <gtest/gtest.h>
+#include <lock_stats.hpp>
 #include <shared_mutex.hpp>
 
+#include <atomic>
+#include <chrono>
+#include <mutex>
 #include <shared_mutex>
+#include <thread>
+#include <vector>
 
 TEST(stdcpp_shared_mutex, lockShard_duplicate_lock) {
   stdcpp::shared_mutex mtx;
@@ -46,3 +52,134 @@ TEST(stdcpp_shared_mutex, shared_lock) {
   ASSERT_TRUE(mtx.try_lock_shared());
   mtx.unlock_shared();
 }
+
+TEST(stdcpp_shared_mutex, no_spin_policy) {
+  stdcpp::basic_shared_mutex<stdcpp::no_spin> mtx;
+  mtx.lock();
+  ASSERT_FALSE(mtx.try_lock_shared());
+  mtx.unlock();
+  ASSERT_TRUE(mtx.try_lock_shared());
+  mtx.unlock_shared();
+}
+
+TEST(stdcpp_shared_mutex, adaptive_spin_budget_follows_wait_times) {
+  stdcpp::adaptive_spin policy(1024);
+  for (int i = 0; i < 64; ++i) {
+    policy.on_acquire(40, false);
+  }
+  ASSERT_NEAR(policy.estimate(), 40u, 8u);
+  ASSERT_NEAR(policy.spin_limit(), 80u, 16u);
+
+  // Acquisitions that end up parking shrink the budget to the floor.
+  for (int i = 0; i < 256; ++i) {
+    policy.on_acquire(policy.spin_limit(), true);
+  }
+  ASSERT_EQ(policy.spin_limit(),
+            static_cast<unsigned>(stdcpp::adaptive_spin::min_spins));
+
+  stdcpp::adaptive_spin disabled(0);
+  ASSERT_EQ(disabled.spin_limit(), 0u);
+}
+
+TEST(stdcpp_shared_mutex, per_instance_policy) {
+  stdcpp::shared_mutex mtx{stdcpp::adaptive_spin(128)};
+  ASSERT_EQ(mtx.policy().max_spins(), 128u);
+  ASSERT_LE(mtx.policy().spin_limit(), 128u);
+}
+
+TEST(stdcpp_shared_mutex, writer_waiting_on_writer_is_woken) {
+  stdcpp::basic_shared_mutex<stdcpp::no_spin> mtx;
+  mtx.lock();
+  std::atomic<bool> acquired{false};
+  std::thread writer([&] {
+    mtx.lock();
+    acquired = true;
+    mtx.unlock();
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  ASSERT_FALSE(acquired.load());
+  mtx.unlock();
+  writer.join();
+  ASSERT_TRUE(acquired.load());
+}
+
+TEST(stdcpp_shared_mutex, single_word_without_spin_policy_state) {
+  static_assert(sizeof(stdcpp::basic_shared_mutex<stdcpp::no_spin>) ==
+                    sizeof(unsigned),
+                "waiters park on the state word itself");
+}
+
+TEST(stdcpp_shared_mutex, writer_waiting_on_readers_is_woken) {
+  stdcpp::basic_shared_mutex<stdcpp::no_spin> mtx;
+  mtx.lock_shared();
+  mtx.lock_shared();
+  std::atomic<bool> acquired{false};
+  std::thread writer([&] {
+    mtx.lock();
+    acquired = true;
+    mtx.unlock();
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  mtx.unlock_shared();
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  ASSERT_FALSE(acquired.load());
+  mtx.unlock_shared();
+  writer.join();
+  ASSERT_TRUE(acquired.load());
+}
+
+template <class Mutex>
+void exclusive_counter_stress() {
+  Mutex mtx;
+  // Writers bump both, one after the other, so a reader that ever sees
+  // them differ got in during a write.
+  long counter = 0;
+  long mirror = 0;
+  std::atomic<int> violations{0};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&, t] {
+      long last_seen = 0;
+      for (int i = 0; i < 2000; ++i) {
+        if ((i + t) % 4 == 0) {
+          std::lock_guard<Mutex> lk(mtx);
+          ++counter;
+          ++mirror;
+        } else {
+          std::shared_lock<Mutex> lk(mtx);
+          const long seen = counter;
+          if (seen != mirror || seen < last_seen || seen > 2000) {
+            violations.fetch_add(1, std::memory_order_relaxed);
+          }
+          last_seen = seen;
+        }
+      }
+    });
+  }
+  for (auto& th : threads) {
+    th.join();
+  }
+  ASSERT_EQ(counter, 2000);
+  ASSERT_EQ(mirror, 2000);
+  ASSERT_EQ(violations.load(), 0);
+}
+
+TEST(stdcpp_shared_mutex, mixed_readers_writers_adaptive) {
+  exclusive_counter_stress<stdcpp::shared_mutex>();
+}
+
+TEST(stdcpp_shared_mutex, mixed_readers_writers_no_spin) {
+  exclusive_counter_stress<stdcpp::basic_shared_mutex<stdcpp::no_spin>>();
+}
+
+TEST(stdcpp_shared_mutex, instrumented_compiles_out_without_lock_stats) {
+  // STDCPP_ENABLE_LOCK_STATS is not defined here.
+  static_assert(sizeof(stdcpp::instrumented_shared_mutex) ==
+                    sizeof(stdcpp::shared_mutex),
+                "instrumentation must add no state when disabled");
+  stdcpp::instrumented_shared_mutex mtx("unused");
+  mtx.lock();
+  mtx.unlock();
+  ASSERT_EQ(mtx.snapshot().exclusive_acquisitions, 0u);
+  ASSERT_TRUE(stdcpp::lock_stats_registry::instance().snapshot().empty());
+}
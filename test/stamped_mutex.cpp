@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+#include <stamped_mutex.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+TEST(stdcpp_stamped_mutex, optimistic_read_validates_without_writer) {
+  stdcpp::stamped_mutex mtx;
+  const auto stamp = mtx.try_optimistic_read();
+  ASSERT_NE(stamp, 0u);
+  ASSERT_TRUE(mtx.validate(stamp));
+  ASSERT_FALSE(mtx.validate(0));
+}
+
+TEST(stdcpp_stamped_mutex, writers_invalidate_stamps_and_readers_do_not) {
+  stdcpp::stamped_mutex mtx;
+  auto stamp = mtx.try_optimistic_read();
+  mtx.lock_shared();
+  ASSERT_TRUE(mtx.try_lock_shared());
+  ASSERT_FALSE(mtx.try_lock());
+  mtx.unlock_shared();
+  mtx.unlock_shared();
+  ASSERT_TRUE(mtx.validate(stamp));
+
+  mtx.lock();
+  ASSERT_EQ(mtx.try_optimistic_read(), 0u);
+  ASSERT_FALSE(mtx.validate(stamp));
+  ASSERT_FALSE(mtx.try_lock_shared());
+  mtx.unlock();
+  ASSERT_FALSE(mtx.validate(stamp));
+
+  stamp = mtx.try_optimistic_read();
+  ASSERT_TRUE(mtx.validate(stamp));
+}
+
+TEST(stdcpp_stamped_mutex, conversions) {
+  stdcpp::stamped_mutex mtx;
+  auto stamp = mtx.try_optimistic_read();
+  ASSERT_TRUE(mtx.try_convert_to_shared(stamp));
+  ASSERT_TRUE(mtx.validate(stamp));
+  stamp = mtx.unlock_shared_to_optimistic();
+  ASSERT_TRUE(mtx.validate(stamp));
+
+  ASSERT_TRUE(mtx.try_convert_to_exclusive(stamp));
+  ASSERT_FALSE(mtx.validate(stamp));
+  ASSERT_FALSE(mtx.try_convert_to_shared(stamp));
+  stamp = mtx.unlock_to_optimistic();
+  ASSERT_TRUE(mtx.validate(stamp));
+
+  // A stale stamp converts to nothing.
+  mtx.lock();
+  mtx.unlock();
+  ASSERT_FALSE(mtx.try_convert_to_exclusive(stamp));
+  ASSERT_FALSE(mtx.try_convert_to_shared(stamp));
+  ASSERT_TRUE(mtx.try_lock());
+  mtx.unlock();
+}
+
+TEST(stdcpp_stamped_mutex, upgrade_and_downgrade) {
+  stdcpp::stamped_mutex mtx;
+  mtx.lock_shared();
+  mtx.lock_shared();
+  ASSERT_FALSE(mtx.try_upgrade());
+  mtx.unlock_shared();
+  ASSERT_TRUE(mtx.try_upgrade());
+  ASSERT_EQ(mtx.try_optimistic_read(), 0u);
+  ASSERT_FALSE(mtx.try_lock_shared());
+
+  mtx.downgrade();
+  const auto stamp = mtx.try_optimistic_read();
+  ASSERT_TRUE(mtx.validate(stamp));
+  ASSERT_TRUE(mtx.try_lock_shared());
+  ASSERT_FALSE(mtx.try_lock());
+  mtx.unlock_shared();
+  mtx.unlock_shared();
+  ASSERT_TRUE(mtx.validate(stamp));
+  ASSERT_TRUE(mtx.try_lock());
+  mtx.unlock();
+}
+
+TEST(stdcpp_stamped_mutex, works_with_standard_lock_guards) {
+  stdcpp::basic_stamped_mutex<stdcpp::no_spin> mtx;
+  int value = 0;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&] {
+      for (int i = 0; i < 1000; ++i) {
+        if (i % 4 == 0) {
+          std::unique_lock<decltype(mtx)> lock(mtx);
+          ++value;
+        } else {
+          std::shared_lock<decltype(mtx)> lock(mtx);
+          (void)value;
+        }
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  ASSERT_EQ(value, 4 * 250);
+}
+
+TEST(stdcpp_stamped_mutex, validated_optimistic_reads_are_consistent) {
+  stdcpp::stamped_mutex mtx;
+  std::atomic<std::uint64_t> a{0};
+  std::atomic<std::uint64_t> b{0};
+  std::atomic<bool> done{false};
+  std::atomic<int> validated{0};
+
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 3; ++t) {
+    readers.emplace_back([&] {
+      while (!done.load(std::memory_order_relaxed)) {
+        const auto stamp = mtx.try_optimistic_read();
+        const auto x = a.load(std::memory_order_relaxed);
+        const auto y = b.load(std::memory_order_relaxed);
+        if (mtx.validate(stamp)) {
+          ASSERT_EQ(x, y);
+          validated.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+    });
+  }
+  for (std::uint64_t i = 1; i <= 5000; ++i) {
+    mtx.lock();
+    a.store(i, std::memory_order_relaxed);
+    b.store(i, std::memory_order_relaxed);
+    mtx.unlock();
+  }
+  // Writers are done, so every reader eventually validates.
+  while (validated.load(std::memory_order_relaxed) < 3) {
+    std::this_thread::yield();
+  }
+  done.store(true);
+  for (auto& t : readers) {
+    t.join();
+  }
+  ASSERT_EQ(a.load(), 5000u);
+}
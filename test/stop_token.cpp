@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+#include <stop_token.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+TEST(stdcpp_stop_token, default_token_cannot_stop) {
+  stdcpp::stop_token token;
+  ASSERT_FALSE(token.stop_possible());
+  ASSERT_FALSE(token.stop_requested());
+  stdcpp::stop_source empty(stdcpp::nostopstate);
+  ASSERT_FALSE(empty.stop_possible());
+  ASSERT_FALSE(empty.request_stop());
+}
+
+TEST(stdcpp_stop_token, request_stop_is_seen_by_tokens) {
+  stdcpp::stop_source source;
+  auto token = source.get_token();
+  auto copy = token;
+  ASSERT_TRUE(token.stop_possible());
+  ASSERT_FALSE(token.stop_requested());
+  ASSERT_TRUE(token == copy);
+  ASSERT_TRUE(source.request_stop());
+  ASSERT_FALSE(source.request_stop());
+  ASSERT_TRUE(copy.stop_requested());
+  ASSERT_TRUE(source.stop_requested());
+}
+
+TEST(stdcpp_stop_token, token_outlives_sources) {
+  stdcpp::stop_token token;
+  {
+    stdcpp::stop_source source;
+    token = source.get_token();
+    ASSERT_TRUE(token.stop_possible());
+  }
+  ASSERT_FALSE(token.stop_possible());
+  ASSERT_FALSE(token.stop_requested());
+}
+
+TEST(stdcpp_stop_token, callbacks_run_on_request) {
+  stdcpp::stop_source source;
+  int calls = 0;
+  auto count = [&] { ++calls; };
+  stdcpp::stop_callback<decltype(count)> first(source.get_token(), count);
+  {
+    stdcpp::stop_callback<decltype(count)> removed(source.get_token(), count);
+  }
+  stdcpp::stop_callback<decltype(count)> second(source.get_token(), count);
+  ASSERT_EQ(calls, 0);
+  source.request_stop();
+  ASSERT_EQ(calls, 2);
+  source.request_stop();
+  ASSERT_EQ(calls, 2);
+}
+
+TEST(stdcpp_stop_token, callback_after_stop_runs_immediately) {
+  stdcpp::stop_source source;
+  source.request_stop();
+  bool called = false;
+  auto set = [&] { called = true; };
+  stdcpp::stop_callback<decltype(set)> cb(source.get_token(), set);
+  ASSERT_TRUE(called);
+}
+
+TEST(stdcpp_stop_token, callback_may_destroy_itself) {
+  stdcpp::stop_source source;
+  struct holder {
+    std::unique_ptr<stdcpp::stop_callback<std::function<void()>>> cb;
+  } h;
+  bool called = false;
+  h.cb.reset(new stdcpp::stop_callback<std::function<void()>>(
+      source.get_token(), [&] {
+        called = true;
+        h.cb.reset();
+      }));
+  source.request_stop();
+  ASSERT_TRUE(called);
+  ASSERT_EQ(h.cb, nullptr);
+}
+
+TEST(stdcpp_stop_token, destructor_waits_for_running_callback) {
+  stdcpp::stop_source source;
+  std::atomic<bool> entered{false};
+  std::atomic<bool> finished{false};
+  auto slow = [&] {
+    entered = true;
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    finished = true;
+  };
+  std::unique_ptr<stdcpp::stop_callback<decltype(slow)>> cb(
+      new stdcpp::stop_callback<decltype(slow)>(source.get_token(), slow));
+  std::thread requester([&] { source.request_stop(); });
+  while (!entered) {
+    std::this_thread::yield();
+  }
+  cb.reset();
+  ASSERT_TRUE(finished.load());
+  requester.join();
+}
+
+TEST(stdcpp_stop_token, concurrent_registration_and_stop) {
+  for (int round = 0; round < 50; ++round) {
+    stdcpp::stop_source source;
+    std::atomic<int> calls{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+      threads.emplace_back([&] {
+        auto count = [&] { calls.fetch_add(1); };
+        for (int i = 0; i < 20; ++i) {
+          stdcpp::stop_callback<decltype(count)> cb(source.get_token(), count);
+        }
+        stdcpp::stop_callback<decltype(count)> kept(source.get_token(), count);
+        while (!source.stop_requested()) {
+          std::this_thread::yield();
+        }
+      });
+    }
+    source.request_stop();
+    for (auto& th : threads) {
+      th.join();
+    }
+    // Every thread's last callback ran exactly once, either on the
+    // requesting thread or in its own constructor.
+    ASSERT_GE(calls.load(), 4);
+    ASSERT_LE(calls.load(), 4 * 21);
+  }
+}
+
+TEST(stdcpp_stop_token, reused_slots_run_each_kept_callback_once) {
+  for (int round = 0; round < 50; ++round) {
+    stdcpp::stop_source source;
+    std::atomic<int> kept_calls[4] = {};
+    std::atomic<int> ready{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+      threads.emplace_back([&, t] {
+        auto ignore = [] {};
+        auto count = [&, t] { kept_calls[t].fetch_add(1); };
+        // Empties and refills the same few slots while stop is requested.
+        for (int i = 0; i < 50; ++i) {
+          stdcpp::stop_callback<decltype(ignore)> cb(source.get_token(),
+                                                     ignore);
+          if (i == 25) {
+            ready.fetch_add(1);
+          }
+        }
+        stdcpp::stop_callback<decltype(count)> kept(source.get_token(), count);
+        while (!source.stop_requested()) {
+          std::this_thread::yield();
+        }
+      });
+    }
+    while (ready.load() < 4) {
+      std::this_thread::yield();
+    }
+    source.request_stop();
+    for (auto& th : threads) {
+      th.join();
+    }
+    for (auto& calls : kept_calls) {
+      ASSERT_EQ(calls.load(), 1);
+    }
+  }
+}
+
+TEST(stdcpp_stop_token, registration_does_not_wait_for_running_callbacks) {
+  stdcpp::stop_source source;
+  std::atomic<bool> entered{false};
+  std::atomic<bool> release{false};
+  auto slow = [&] {
+    entered = true;
+    while (!release) {
+      std::this_thread::yield();
+    }
+  };
+  stdcpp::stop_callback<decltype(slow)> cb(source.get_token(), slow);
+  std::thread requester([&] { source.request_stop(); });
+  while (!entered) {
+    std::this_thread::yield();
+  }
+  // Runs inline, since stop was requested, while the requester is busy.
+  bool called = false;
+  auto set = [&] { called = true; };
+  {
+    stdcpp::stop_callback<decltype(set)> late(source.get_token(), set);
+  }
+  ASSERT_TRUE(called);
+  release = true;
+  requester.join();
+}
@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+#include <thread.hpp>
+
+#include <atomic>
+#include <chrono>
+
+TEST(stdcpp_jthread, default_constructed) {
+  stdcpp::jthread t;
+  ASSERT_FALSE(t.joinable());
+  ASSERT_FALSE(t.get_stop_source().stop_possible());
+}
+
+TEST(stdcpp_jthread, passes_arguments) {
+  int result = 0;
+  {
+    stdcpp::jthread t([&result](int a, int b) { result = a + b; }, 2, 3);
+  }
+  ASSERT_EQ(result, 5);
+}
+
+TEST(stdcpp_jthread, destructor_requests_stop_and_joins) {
+  std::atomic<bool> stopped{false};
+  {
+    stdcpp::jthread t([&](stdcpp::stop_token token) {
+      while (!token.stop_requested()) {
+        std::this_thread::yield();
+      }
+      stopped = true;
+    });
+    ASSERT_TRUE(t.get_stop_token().stop_possible());
+  }
+  ASSERT_TRUE(stopped.load());
+}
+
+TEST(stdcpp_jthread, move_assignment_stops_previous_thread) {
+  std::atomic<int> stopped{0};
+  auto worker = [&](stdcpp::stop_token token) {
+    while (!token.stop_requested()) {
+      std::this_thread::yield();
+    }
+    stopped.fetch_add(1);
+  };
+  stdcpp::jthread t(worker);
+  t = stdcpp::jthread(worker);
+  ASSERT_EQ(stopped.load(), 1);
+  ASSERT_TRUE(t.request_stop());
+  t.join();
+  ASSERT_EQ(stopped.load(), 2);
+}
@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include <thread_pool.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+int fib(stdcpp::thread_pool& pool, int n) {
+  if (n < 2) {
+    return n;
+  }
+  auto left = pool.submit([&pool, n] { return fib(pool, n - 1); });
+  const int right = fib(pool, n - 2);
+  return left.get() + right;
+}
+}  // namespace
+
+TEST(stdcpp_thread_pool, submit_returns_results) {
+  stdcpp::thread_pool pool(4);
+  ASSERT_EQ(pool.size(), 4u);
+  auto answer = pool.submit([] { return 42; });
+  auto text = pool.submit([] { return std::string("pool"); });
+  auto moved = pool.submit([] { return std::make_unique<int>(7); });
+  int target = 0;
+  auto ref = pool.submit([&target]() -> int& { return target; });
+  auto nothing = pool.submit([] {});
+  ASSERT_TRUE(answer.valid());
+  ASSERT_EQ(answer.get(), 42);
+  ASSERT_FALSE(answer.valid());
+  ASSERT_EQ(text.get(), "pool");
+  ASSERT_EQ(*moved.get(), 7);
+  ASSERT_EQ(&ref.get(), &target);
+  nothing.get();
+}
+
+TEST(stdcpp_thread_pool, submit_propagates_exceptions) {
+  stdcpp::thread_pool pool(2);
+  auto failing = pool.submit([]() -> int { throw std::runtime_error("no"); });
+  failing.wait();
+  ASSERT_TRUE(failing.is_ready());
+  ASSERT_THROW(failing.get(), std::runtime_error);
+}
+
+TEST(stdcpp_thread_pool, execute_from_many_threads) {
+  std::atomic<int> ran{0};
+  {
+    stdcpp::thread_pool pool(3);
+    std::vector<std::thread> submitters;
+    for (int t = 0; t < 4; ++t) {
+      submitters.emplace_back([&] {
+        for (int i = 0; i < 1000; ++i) {
+          pool.execute([&ran] { ran.fetch_add(1); });
+        }
+      });
+    }
+    for (auto& t : submitters) {
+      t.join();
+    }
+    // The destructor runs whatever is still queued.
+  }
+  ASSERT_EQ(ran.load(), 4000);
+}
+
+TEST(stdcpp_thread_pool, nested_waits_run_other_tasks) {
+  // Every task waits on a subtask; with two workers this only finishes if
+  // waiting workers keep running tasks.
+  stdcpp::thread_pool pool(2);
+  auto result = pool.submit([&pool] { return fib(pool, 18); });
+  ASSERT_EQ(result.get(), 2584);
+}
+
+TEST(stdcpp_thread_pool, bulk_visits_each_index_once) {
+  stdcpp::thread_pool pool(4);
+  for (std::size_t n : {0u, 1u, 7u, 1000u, 100000u}) {
+    std::vector<std::atomic<int>> hits(n);
+    pool.bulk(n, [&hits](std::size_t i) { hits[i].fetch_add(1); });
+    for (std::size_t i = 0; i < n; ++i) {
+      ASSERT_EQ(hits[i].load(), 1) << "n=" << n << " i=" << i;
+    }
+  }
+  // Nested inside a task, too.
+  std::atomic<long> sum{0};
+  pool.submit([&] {
+        pool.bulk(1000, [&sum](std::size_t i) {
+          sum.fetch_add(static_cast<long>(i));
+        });
+      })
+      .get();
+  ASSERT_EQ(sum.load(), 999 * 1000 / 2);
+}
+
+TEST(stdcpp_thread_pool, bulk_propagates_exceptions) {
+  stdcpp::thread_pool pool(4);
+  ASSERT_THROW(pool.bulk(10000,
+                         [](std::size_t i) {
+                           if (i == 5000) {
+                             throw std::out_of_range("5000");
+                           }
+                         }),
+               std::out_of_range);
+}
+
+TEST(stdcpp_thread_pool, worker_index_and_hints) {
+  stdcpp::thread_pool pool(3);
+  ASSERT_EQ(pool.worker_index(), stdcpp::thread_pool::npos);
+  for (std::size_t w = 0; w < 6; ++w) {
+    const std::size_t index =
+        pool.submit_on(w, [&pool] { return pool.worker_index(); }).get();
+    ASSERT_LT(index, pool.size());
+  }
+  stdcpp::thread_pool other(1);
+  ASSERT_EQ(other.submit([&pool] { return pool.worker_index(); }).get(),
+            stdcpp::thread_pool::npos);
+}
+
+TEST(stdcpp_thread_pool, parked_workers_wake_up) {
+  stdcpp::thread_pool pool(4);
+  for (int round = 0; round < 20; ++round) {
+    // Give the workers time to park between rounds.
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    std::atomic<int> ran{0};
+    std::vector<stdcpp::task_future<void>> done;
+    for (int i = 0; i < 8; ++i) {
+      done.push_back(pool.submit([&ran] { ran.fetch_add(1); }));
+    }
+    for (auto& f : done) {
+      f.get();
+    }
+    ASSERT_EQ(ran.load(), 8);
+  }
+}